@@ -0,0 +1,42 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtTest/QTest>
+
+namespace benchmarks {
+
+/// Runs all benchmarks in a given object. If no output file is specified in command line, results are written in
+/// QTest XML format to <name>.xml in current directory, where name is a name of benchmark executable without
+/// suffixes, so results of different runs can be collected and compared.
+/// @param benchmark - object whose private slots are benchmarks.
+/// @param name - name of a benchmark suite.
+/// @param arguments - command line arguments, in the same format as for QTest.
+inline int runBenchmark(QObject &benchmark, QString const &name, QStringList arguments)
+{
+	if (!arguments.contains("-o") && !arguments.contains("-xml")) {
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+		arguments << "-xml" << "-o" << name + ".xml";
+#else
+		arguments << "-o" << name + ".xml,xml" << "-o" << "-,txt";
+#endif
+	}
+
+	return QTest::qExec(&benchmark, arguments);
+}
+
+}
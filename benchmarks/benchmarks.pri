@@ -0,0 +1,42 @@
+# Copyright 2014 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Settings common to all benchmark projects.
+
+include(../global.pri)
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+QT += testlib
+
+# Benchmarks use internal classes of libraries, so include paths to their sources are added too.
+INCLUDEPATH += \
+	$$PWD \
+	$$PWD/../trikKernel/include/ \
+	$$PWD/../trikCommunicator/include/ \
+	$$PWD/../trikControl/ \
+	$$PWD/../trikControl/include/ \
+	$$PWD/../trikScriptRunner/ \
+	$$PWD/../trikScriptRunner/include/ \
+	$$PWD/../trikWiFi/ \
+	$$PWD/../trikWiFi/include/ \
+
+HEADERS += \
+	$$PWD/benchmarkRunner.h \
+	$$PWD/simulatorConfig.h \
+
+SOURCES += \
+	$$PWD/simulatorConfig.cpp \
@@ -0,0 +1,24 @@
+# Copyright 2014 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Performance benchmarks. Each subproject is a QTest-based executable that writes its results to
+# <project name>.xml in current directory, so they can be collected and compared across commits.
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+	trikCommunicatorBenchmarks \
+	trikControlBenchmarks \
+	trikScriptRunnerBenchmarks \
+	trikWiFiBenchmarks \
@@ -0,0 +1,35 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "simulatorConfig.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QRegExp>
+
+#include <trikKernel/fileUtils.h>
+
+using namespace benchmarks;
+
+QString SimulatorConfig::create()
+{
+	QString config = trikKernel::FileUtils::readFromFile(QCoreApplication::applicationDirPath() + "/config.xml");
+	config.replace(QRegExp("<deviceBackend [^>]*>")
+			, "<deviceBackend type=\"simulator\" i2cLatency=\"0\" deviceFileLatency=\"0\" />");
+
+	QString const configDir = QDir::temp().filePath("trikBenchmarks");
+	QDir().mkpath(configDir);
+	trikKernel::FileUtils::writeToFile(configDir + "/config.xml", config);
+	return configDir + "/";
+}
@@ -0,0 +1,32 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QString>
+
+namespace benchmarks {
+
+/// Prepares configuration for a Brick running on simulated devices, so benchmarks can create the whole Brick on a
+/// desktop.
+class SimulatorConfig
+{
+public:
+	/// Takes config.xml from application directory, switches it to simulated devices without latencies, writes
+	/// result to temporary directory and returns path to it (with trailing slash), suitable for Brick constructor.
+	/// Throws an exception if config can not be read or written.
+	static QString create();
+};
+
+}
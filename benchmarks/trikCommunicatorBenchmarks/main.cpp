@@ -0,0 +1,39 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/qglobal.h>
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+	#include <QtGui/QApplication>
+#else
+	#include <QtWidgets/QApplication>
+#endif
+
+#include "benchmarkRunner.h"
+#include "trikCommunicatorBenchmark.h"
+
+int main(int argc, char *argv[])
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+	// Benchmarks shall run on a build server without display.
+	if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+#endif
+
+	QApplication app(argc, argv);
+
+	benchmarks::TrikCommunicatorBenchmark benchmark;
+	return benchmarks::runBenchmark(benchmark, "trikCommunicatorBenchmarks", app.arguments());
+}
@@ -0,0 +1,190 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "trikCommunicatorBenchmark.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QTcpSocket>
+#include <QtTest/QTest>
+
+#include <trikKernel/metricsRegistry.h>
+#include <trikControl/brick.h>
+#include <trikCommunicator/trikCommunicator.h>
+
+#include "simulatorConfig.h"
+
+using namespace benchmarks;
+
+/// Maximal time to wait for clients to connect or disconnect in milliseconds.
+static int const connectionTimeout = 10000;
+
+/// Returns value of a given field of /proc/self/status in kilobytes, or -1 if it is not available.
+static qint64 processStatusField(QByteArray const &field)
+{
+	QFile status("/proc/self/status");
+	if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		return -1;
+	}
+
+	for (QByteArray const &line : status.readAll().split('\n')) {
+		if (line.startsWith(field + ':')) {
+			return line.mid(field.size() + 1).trimmed().split(' ').first().toLongLong();
+		}
+	}
+
+	return -1;
+}
+
+TrikCommunicatorBenchmark::TrikCommunicatorBenchmark()
+{
+}
+
+TrikCommunicatorBenchmark::~TrikCommunicatorBenchmark()
+{
+}
+
+void TrikCommunicatorBenchmark::initTestCase()
+{
+	mStartDirPath = QCoreApplication::applicationDirPath() + "/";
+	mBrick.reset(new trikControl::Brick(*QThread::currentThread(), SimulatorConfig::create(), mStartDirPath));
+	trikKernel::MetricsRegistry::reset();
+}
+
+void TrikCommunicatorBenchmark::cleanupTestCase()
+{
+	qDebug("%s", qPrintable(trikKernel::MetricsRegistry::toText()));
+
+	mBrick.reset();
+}
+
+void TrikCommunicatorBenchmark::connectionSetup_data()
+{
+	QTest::addColumn<bool>("singleThreaded");
+
+	QTest::newRow("threadPerConnection") << false;
+	QTest::newRow("singleThread") << true;
+}
+
+void TrikCommunicatorBenchmark::connectionSetup()
+{
+	QFETCH(bool, singleThreaded);
+
+	trikCommunicator::TrikCommunicator communicator(*mBrick, mStartDirPath);
+	communicator.setSingleThreaded(singleThreaded);
+	communicator.startServer(0);
+	QVERIFY(communicator.isListening());
+
+	QList<QTcpSocket *> clients;
+	QBENCHMARK {
+		bool const connected = connectClients(communicator.serverPort(), 20, clients);
+		disconnectClients(clients);
+		QVERIFY(connected);
+	}
+}
+
+void TrikCommunicatorBenchmark::memoryFootprint_data()
+{
+	connectionSetup_data();
+}
+
+void TrikCommunicatorBenchmark::memoryFootprint()
+{
+	QFETCH(bool, singleThreaded);
+
+	int const connections = 50;
+
+	trikCommunicator::TrikCommunicator communicator(*mBrick, mStartDirPath);
+	communicator.setSingleThreaded(singleThreaded);
+	communicator.startServer(0);
+	QVERIFY(communicator.isListening());
+
+	// Connect and disconnect once, so one-time allocations like shared thread are not counted.
+	QList<QTcpSocket *> clients;
+	QVERIFY(connectClients(communicator.serverPort(), 1, clients));
+	disconnectClients(clients);
+
+	qint64 const residentBefore = processStatusField("VmRSS");
+	qint64 const virtualBefore = processStatusField("VmSize");
+	if (residentBefore < 0 || virtualBefore < 0) {
+		qDebug("Memory usage of a process is available only on Linux");
+		return;
+	}
+
+	bool const connected = connectClients(communicator.serverPort(), connections, clients);
+	qint64 const residentAfter = processStatusField("VmRSS");
+	qint64 const virtualAfter = processStatusField("VmSize");
+	disconnectClients(clients);
+	QVERIFY(connected);
+
+	qDebug("Per connection: resident %.1f KB, virtual %.1f KB"
+			, static_cast<double>(residentAfter - residentBefore) / connections
+			, static_cast<double>(virtualAfter - virtualBefore) / connections);
+}
+
+bool TrikCommunicatorBenchmark::connectClients(quint16 port, int count, QList<QTcpSocket *> &clients)
+{
+	for (int i = 0; i < count; ++i) {
+		QTcpSocket * const client = new QTcpSocket();
+		client->connectToHost(QHostAddress::LocalHost, port);
+		clients << client;
+	}
+
+	QList<QTcpSocket *> waitingForConnection = clients;
+	QList<QTcpSocket *> waitingForReply;
+	QElapsedTimer timer;
+	timer.start();
+
+	// Server runs in this thread too, so events are processed instead of blocking on client sockets.
+	while ((!waitingForConnection.isEmpty() || !waitingForReply.isEmpty()) && timer.elapsed() < connectionTimeout) {
+		QCoreApplication::processEvents();
+
+		for (auto client = waitingForConnection.begin(); client != waitingForConnection.end();) {
+			if ((*client)->state() == QAbstractSocket::ConnectedState) {
+				(*client)->write("5:stats");
+				waitingForReply << *client;
+				client = waitingForConnection.erase(client);
+			} else {
+				++client;
+			}
+		}
+
+		for (auto client = waitingForReply.begin(); client != waitingForReply.end();) {
+			if ((*client)->bytesAvailable() > 0) {
+				(*client)->readAll();
+				client = waitingForReply.erase(client);
+			} else {
+				++client;
+			}
+		}
+	}
+
+	return waitingForConnection.isEmpty() && waitingForReply.isEmpty();
+}
+
+void TrikCommunicatorBenchmark::disconnectClients(QList<QTcpSocket *> &clients)
+{
+	qDeleteAll(clients);
+	clients.clear();
+
+	trikKernel::Gauge const &connections = trikKernel::MetricsRegistry::gauge("communicator.connections");
+	QElapsedTimer timer;
+	timer.start();
+	while (connections.value() > 0 && timer.elapsed() < connectionTimeout) {
+		QCoreApplication::processEvents();
+	}
+}
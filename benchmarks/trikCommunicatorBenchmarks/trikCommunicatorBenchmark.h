@@ -0,0 +1,67 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QString>
+
+class QTcpSocket;
+
+namespace trikControl {
+class Brick;
+}
+
+namespace benchmarks {
+
+/// Benchmarks of serving clients by TrikCommunicator in thread-per-connection and single-threaded modes. Clients
+/// and server run in one process on loopback interface, Brick works on simulated devices.
+class TrikCommunicatorBenchmark : public QObject
+{
+	Q_OBJECT
+
+public:
+	TrikCommunicatorBenchmark();
+	~TrikCommunicatorBenchmark() override;
+
+private slots:
+	/// Creates simulated Brick.
+	void initTestCase();
+
+	/// Prints collected runtime metrics.
+	void cleanupTestCase();
+
+	/// Time to connect 20 clients, get a reply to "stats" command from each of them and disconnect them.
+	void connectionSetup_data();
+	void connectionSetup();
+
+	/// Growth of resident and virtual memory of the process per connection, with 50 connected clients.
+	void memoryFootprint_data();
+	void memoryFootprint();
+
+private:
+	/// Connects given number of clients to a server on a given port and waits for a reply to "stats" from each.
+	/// @returns false if not all clients got a reply in time.
+	static bool connectClients(quint16 port, int count, QList<QTcpSocket *> &clients);
+
+	/// Disconnects and deletes clients and waits until server closes all connections.
+	static void disconnectClients(QList<QTcpSocket *> &clients);
+
+	QString mStartDirPath;
+	QScopedPointer<trikControl::Brick> mBrick;
+};
+
+}
@@ -0,0 +1,44 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "benchmarkDeviceBackend.h"
+
+#include "src/evdevEventDevice.h"
+#include "src/fifoVirtualSensorDevice.h"
+#include "src/hardwareI2cBus.h"
+#include "src/sysfsDeviceFile.h"
+
+using namespace benchmarks;
+using namespace trikControl;
+
+I2cBusInterface *BenchmarkDeviceBackend::createI2cBus(QString const &devicePath, int deviceId)
+{
+	return new HardwareI2cBus(devicePath, deviceId);
+}
+
+DeviceFileInterface *BenchmarkDeviceBackend::createDeviceFile(QString const &fileName)
+{
+	return new SysfsDeviceFile(fileName);
+}
+
+EventDeviceInterface *BenchmarkDeviceBackend::createEventDevice(QString const &fileName)
+{
+	return new EvdevEventDevice(fileName);
+}
+
+VirtualSensorDeviceInterface *BenchmarkDeviceBackend::createVirtualSensorDevice(QString const &script
+		, QString const &inputFile, QString const &outputFile)
+{
+	return new FifoVirtualSensorDevice(script, inputFile, outputFile);
+}
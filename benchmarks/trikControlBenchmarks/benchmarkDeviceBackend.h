@@ -0,0 +1,38 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include "src/deviceBackendInterface.h"
+
+namespace benchmarks {
+
+/// Device backend for benchmarks. Creates the same device classes as a real robot does, so benchmarks include system
+/// calls and parsing of real device paths, but on files that stand in for hardware: FIFOs written by a benchmark
+/// instead of input devices and virtual sensor outputs, i2c-stub bus or a regular file instead of I2C bus, regular
+/// files instead of sysfs attributes.
+class BenchmarkDeviceBackend : public trikControl::DeviceBackendInterface
+{
+public:
+	trikControl::I2cBusInterface *createI2cBus(QString const &devicePath, int deviceId) override;
+
+	trikControl::DeviceFileInterface *createDeviceFile(QString const &fileName) override;
+
+	trikControl::EventDeviceInterface *createEventDevice(QString const &fileName) override;
+
+	trikControl::VirtualSensorDeviceInterface *createVirtualSensorDevice(QString const &script
+			, QString const &inputFile, QString const &outputFile) override;
+};
+
+}
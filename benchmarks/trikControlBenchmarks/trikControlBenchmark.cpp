@@ -0,0 +1,531 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "trikControlBenchmark.h"
+
+#include <functional>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+#include <QtXml/QDomDocument>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <linux/input.h>
+
+#include <trikControl/digitalSensor.h>
+#include <trikControl/display.h>
+#include <trikControl/pwmCapture.h>
+#include <trikKernel/metricsRegistry.h>
+
+#include "src/compiledConfig.h"
+#include "src/configurer.h"
+#include "src/graphicsWidget.h"
+#include "src/i2cCommunicator.h"
+#include "src/imageCache.h"
+#include "src/lineSensorWorker.h"
+#include "src/sensor3dWorker.h"
+
+using namespace benchmarks;
+using namespace trikControl;
+
+/// I2C address of a device on a bus used by benchmarks when i2c-stub does not tell its chip address.
+static int const defaultI2cAddress = 0x48;
+
+/// Time in milliseconds to wait for data written to a device to be processed.
+static int const deliveryTimeout = 1000;
+
+/// Processes events until given condition holds.
+/// @returns false if condition did not hold in deliveryTimeout.
+static bool processEventsUntil(std::function<bool()> const &condition)
+{
+	QElapsedTimer timer;
+	timer.start();
+	while (!condition()) {
+		if (timer.elapsed() > deliveryTimeout) {
+			return false;
+		}
+
+		QCoreApplication::processEvents();
+	}
+
+	return true;
+}
+
+/// Returns device file of a bus created by i2c-stub kernel module ("modprobe i2c-stub chip_addr=0x48"), or empty
+/// string if the module is not loaded.
+/// @param address - receives address of the first chip simulated by the module.
+static QString i2cStubDevice(int &address)
+{
+	for (QFileInfo const &bus : QDir("/sys/class/i2c-dev").entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+		QFile name(bus.filePath() + "/name");
+		if (name.open(QIODevice::ReadOnly) && name.readAll().startsWith("SMBus stub driver")) {
+			QFile chipAddresses("/sys/module/i2c_stub/parameters/chip_addr");
+			bool ok = false;
+			address = chipAddresses.open(QIODevice::ReadOnly)
+					? chipAddresses.readAll().split(',').first().trimmed().toInt(&ok, 0)
+					: 0;
+
+			if (!ok || address == 0) {
+				address = defaultI2cAddress;
+			}
+
+			return "/dev/" + bus.fileName();
+		}
+	}
+
+	return QString();
+}
+
+void TrikControlBenchmark::initTestCase()
+{
+	mDigitalSensorFile = createDeviceFile("digitalSensor", "42\n");
+	mPwmFrequencyFile = createDeviceFile("pwmFrequency", "1000,2000,3000,\n");
+	mPwmDutyFile = createDeviceFile("pwmDuty", "50%\n");
+
+	mI2cDevice = i2cStubDevice(mI2cAddress);
+	if (mI2cDevice.isEmpty()) {
+		// Bus calls still go through the driver code and ioctl system calls, but are rejected by the kernel.
+		qDebug() << "i2c-stub module is not loaded, I2C benchmarks use a regular file instead of a bus";
+		mI2cDevice = createDeviceFile("i2c", "");
+		mI2cAddress = defaultI2cAddress;
+	}
+}
+
+void TrikControlBenchmark::cleanupTestCase()
+{
+	QFile::remove(mDigitalSensorFile);
+	QFile::remove(mPwmFrequencyFile);
+	QFile::remove(mPwmDutyFile);
+	if (!mI2cDevice.startsWith("/dev/")) {
+		QFile::remove(mI2cDevice);
+	}
+
+	for (QString const &fifo : mFifos) {
+		QFile::remove(fifo);
+	}
+}
+
+void TrikControlBenchmark::i2cSend()
+{
+	I2cCommunicator communicator(mBackend.createI2cBus(mI2cDevice, mI2cAddress));
+	QByteArray command(2, '\0');
+	command[0] = 0x14;
+	command[1] = 50;
+
+	QBENCHMARK {
+		communicator.send(command);
+	}
+}
+
+void TrikControlBenchmark::i2cRead()
+{
+	I2cCommunicator communicator(mBackend.createI2cBus(mI2cDevice, mI2cAddress));
+	QByteArray command(1, '\0');
+	command[0] = 0x25;
+
+	QBENCHMARK {
+		communicator.read(command);
+	}
+}
+
+void TrikControlBenchmark::digitalSensorRead()
+{
+	DigitalSensor sensor(mBackend, 0, 100, mDigitalSensorFile);
+	QCOMPARE(sensor.read(), 42);
+
+	QBENCHMARK {
+		sensor.read();
+	}
+}
+
+void TrikControlBenchmark::pwmCaptureFrequency()
+{
+	PwmCapture capture(mBackend, mPwmFrequencyFile, mPwmDutyFile);
+	QCOMPARE(capture.frequency()[2], 3000);
+
+	QBENCHMARK {
+		capture.frequency();
+	}
+}
+
+void TrikControlBenchmark::sensor3dEvents()
+{
+	QString const deviceFile = createFifo("accelerometer");
+	Sensor3dWorker worker(mBackend, -32767, 32767, deviceFile);
+
+	// Reading end is already open by the device, so opening for writing does not block.
+	int const writer = open(deviceFile.toLocal8Bit().constData(), O_WRONLY | O_NONBLOCK);
+	QVERIFY(writer >= 0);
+
+	int value = 0;
+	QBENCHMARK {
+		++value;
+		struct input_event events[4] = {};
+		events[0].type = EV_ABS;
+		events[0].code = ABS_X;
+		events[0].value = value;
+		events[1].type = EV_ABS;
+		events[1].code = ABS_Y;
+		events[1].value = -value;
+		events[2].type = EV_ABS;
+		events[2].code = ABS_Z;
+		events[2].value = 2 * value;
+		events[3].type = EV_SYN;
+		events[3].code = SYN_REPORT;
+
+		if (write(writer, events, sizeof(events)) != static_cast<ssize_t>(sizeof(events))
+				|| !processEventsUntil([&worker, value]() { return worker.read()[2] == 2 * value; }))
+		{
+			break;
+		}
+	}
+
+	close(writer);
+	QCOMPARE(worker.read()[0], value);
+}
+
+void TrikControlBenchmark::lineSensorParsing()
+{
+	QString const inputFile = createFifo("lineSensorInput");
+	QString const outputFile = createFifo("lineSensorOutput");
+
+	// Plays the role of sensor process that reads commands, so the device can open input FIFO for writing.
+	int const commandReader = open(inputFile.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK);
+	QVERIFY(commandReader >= 0);
+
+	// Script is run only to stop the sensor, since its FIFOs already exist.
+	LineSensorWorker worker(mBackend, "/bin/true", inputFile, outputFile, 1.0);
+	worker.init(false);
+
+	int const writer = open(outputFile.toLocal8Bit().constData(), O_WRONLY | O_NONBLOCK);
+	if (writer < 0) {
+		close(commandReader);
+		QFAIL("Can not open line sensor output FIFO");
+	}
+
+	int value = 0;
+	QBENCHMARK {
+		++value;
+		QByteArray const line = QString("loc: %1 17 1530\n").arg(value).toLatin1();
+		if (write(writer, line.constData(), line.size()) != line.size()
+				|| !processEventsUntil([&worker, value]() { return worker.read()[0] == value; }))
+		{
+			break;
+		}
+	}
+
+	close(writer);
+	close(commandReader);
+	QCOMPARE(worker.read()[0], value);
+}
+
+void TrikControlBenchmark::graphicsWidgetDrawPoints_data()
+{
+	QTest::addColumn<int>("count");
+
+	QTest::newRow("100") << 100;
+	QTest::newRow("1000") << 1000;
+	QTest::newRow("100000") << 100000;
+}
+
+void TrikControlBenchmark::graphicsWidgetDrawPoints()
+{
+	QFETCH(int, count);
+
+	GraphicsWidget widget;
+
+	QBENCHMARK {
+		widget.deleteAllItems();
+		for (int i = 0; i < count; ++i) {
+			widget.drawPoint(i % 240, i / 240);
+		}
+	}
+}
+
+void TrikControlBenchmark::graphicsWidgetDrawLines_data()
+{
+	QTest::addColumn<int>("count");
+
+	QTest::newRow("100") << 100;
+	QTest::newRow("1000") << 1000;
+	QTest::newRow("100000") << 100000;
+}
+
+void TrikControlBenchmark::graphicsWidgetDrawLines()
+{
+	QFETCH(int, count);
+
+	GraphicsWidget widget;
+
+	QBENCHMARK {
+		widget.deleteAllItems();
+		for (int i = 0; i < count; ++i) {
+			widget.drawLine(0, i % 320, 240, i / 320);
+		}
+	}
+}
+
+void TrikControlBenchmark::graphicsWidgetRecolorPoints()
+{
+	int const count = 100000;
+	GraphicsWidget widget;
+	for (int i = 0; i < count; ++i) {
+		widget.drawPoint(i % 240, i / 240);
+	}
+
+	bool red = false;
+	QBENCHMARK {
+		red = !red;
+		widget.setPainterColor(red ? "red" : "black");
+		for (int i = 0; i < count; ++i) {
+			widget.drawPoint(i % 240, i / 240);
+		}
+	}
+}
+
+void TrikControlBenchmark::displayDrawPoints_data()
+{
+	QTest::addColumn<QString>("renderer");
+	QTest::addColumn<QString>("mode");
+	QTest::addColumn<int>("count");
+
+	for (QString const &renderer : {QString("widget"), QString("memory")}) {
+		for (int const count : {100, 1000, 10000}) {
+			for (QString const &mode : {QString("perCall"), QString("frame"), QString("array")}) {
+				QTest::newRow(qPrintable(QString("%1 %2 %3").arg(renderer).arg(mode).arg(count)))
+						<< renderer << mode << count;
+			}
+		}
+	}
+}
+
+void TrikControlBenchmark::displayDrawPoints()
+{
+	QFETCH(QString, renderer);
+	QFETCH(QString, mode);
+	QFETCH(int, count);
+
+	// GUI thread of a benchmark is the main thread, as in trikGui.
+	Display display(*QThread::currentThread(), "", renderer);
+	QVector<int> coordinates;
+	for (int i = 0; i < count; ++i) {
+		coordinates << i % 240 << i / 240;
+	}
+
+	QCoreApplication::processEvents();
+
+	QBENCHMARK {
+		display.clear();
+		if (mode == "array") {
+			display.drawPoints(coordinates);
+		} else {
+			if (mode == "frame") {
+				display.beginFrame();
+			}
+
+			for (int i = 0; i < count; ++i) {
+				display.drawPoint(i % 240, i / 240);
+			}
+
+			if (mode == "frame") {
+				display.endFrame();
+			}
+		}
+
+		QCoreApplication::processEvents();
+	}
+}
+
+void TrikControlBenchmark::displayUpdateLabels_data()
+{
+	QTest::addColumn<QString>("renderer");
+	QTest::addColumn<QString>("mode");
+
+	QTest::newRow("widget, calls") << QString("widget") << QString("calls");
+	QTest::newRow("widget, frame") << QString("widget") << QString("frame");
+	QTest::newRow("memory, calls") << QString("memory") << QString("calls");
+	QTest::newRow("memory, frame") << QString("memory") << QString("frame");
+}
+
+void TrikControlBenchmark::displayUpdateLabels()
+{
+	QFETCH(QString, renderer);
+	QFETCH(QString, mode);
+
+	Display display(*QThread::currentThread(), "", renderer);
+	QCoreApplication::processEvents();
+
+	int value = 0;
+	QBENCHMARK {
+		if (mode == "frame") {
+			display.beginFrame();
+		}
+
+		for (int i = 0; i < 10; ++i) {
+			display.addLabel(QString::number(++value), 10, 20 * i);
+		}
+
+		if (mode == "frame") {
+			display.endFrame();
+		}
+
+		QCoreApplication::processEvents();
+	}
+}
+
+void TrikControlBenchmark::imageCacheLookup()
+{
+	QString const fileName = QCoreApplication::applicationDirPath() + "/media/trik_smile_normal.png";
+	ImageCache cache(32 * 1024 * 1024);
+	cache.setTargetSize(QSize(220, 300));
+
+	QSignalSpy loadedSpy(&cache, SIGNAL(imageLoaded(QString,QImage)));
+	cache.preload(fileName);
+	QTRY_COMPARE(loadedSpy.count(), 1);
+
+	QBENCHMARK {
+		QImage const image = cache.image(fileName);
+		Q_UNUSED(image)
+	}
+}
+
+void TrikControlBenchmark::configCompile()
+{
+	QFile file(QCoreApplication::applicationDirPath() + "/config.xml");
+	if (!file.open(QIODevice::ReadOnly)) {
+		qFatal("Can not read config.xml");
+	}
+
+	QByteArray const xml = file.readAll();
+
+	QBENCHMARK {
+		CompiledConfig const config = CompiledConfig::compile(xml);
+		Q_UNUSED(config)
+	}
+}
+
+void TrikControlBenchmark::configParseDom()
+{
+	QFile file(QCoreApplication::applicationDirPath() + "/config.xml");
+	if (!file.open(QIODevice::ReadOnly)) {
+		qFatal("Can not read config.xml");
+	}
+
+	QByteArray const xml = file.readAll();
+
+	QBENCHMARK {
+		QDomDocument document("config");
+		QVERIFY(document.setContent(xml));
+
+		// Configurer used to read every attribute of every element once.
+		QDomElement element = document.documentElement();
+		while (!element.isNull()) {
+			QDomNamedNodeMap const attributes = element.attributes();
+			for (int i = 0; i < attributes.count(); ++i) {
+				QString const value = attributes.item(i).toAttr().value();
+				Q_UNUSED(value)
+			}
+
+			if (!element.firstChildElement().isNull()) {
+				element = element.firstChildElement();
+			} else {
+				while (!element.isNull() && element.nextSiblingElement().isNull()) {
+					element = element.parentNode().toElement();
+				}
+
+				if (!element.isNull()) {
+					element = element.nextSiblingElement();
+				}
+			}
+		}
+	}
+}
+
+void TrikControlBenchmark::configLoad()
+{
+	QString const xmlFile = QCoreApplication::applicationDirPath() + "/config.xml";
+
+	QBENCHMARK {
+		CompiledConfig const config = CompiledConfig::load(xmlFile);
+		Q_UNUSED(config)
+	}
+}
+
+void TrikControlBenchmark::configurerCacheMiss()
+{
+	QString const configPath = QCoreApplication::applicationDirPath() + "/";
+
+	QBENCHMARK {
+		QFile::remove(configPath + "config.xml.cache");
+		Configurer const configurer(configPath);
+		Q_UNUSED(configurer)
+	}
+}
+
+void TrikControlBenchmark::configurerCacheHit()
+{
+	QString const configPath = QCoreApplication::applicationDirPath() + "/";
+	trikKernel::Counter &cacheHits = trikKernel::MetricsRegistry::counter("configurer.cacheHits");
+
+	{
+		Configurer const configurer(configPath);
+		Q_UNUSED(configurer)
+	}
+
+	QVERIFY2(QFile::exists(configPath + "config.xml.cache"), "config.xml is modified too recently to be cached");
+
+	qint64 const hitsBefore = cacheHits.value();
+	int iterations = 0;
+
+	QBENCHMARK {
+		Configurer const configurer(configPath);
+		Q_UNUSED(configurer)
+		++iterations;
+	}
+
+	QCOMPARE(cacheHits.value() - hitsBefore, static_cast<qint64>(iterations));
+}
+
+QString TrikControlBenchmark::createFifo(QString const &name)
+{
+	QString const fileName = QDir::temp().filePath("trikControlBenchmark." + name);
+	QFile::remove(fileName);
+	if (mkfifo(fileName.toLocal8Bit().constData(), 0600) != 0) {
+		qFatal("Can not create FIFO %s", qPrintable(fileName));
+	}
+
+	mFifos << fileName;
+	return fileName;
+}
+
+QString TrikControlBenchmark::createDeviceFile(QString const &name, QByteArray const &contents)
+{
+	QString const fileName = QDir::temp().filePath("trikControlBenchmark." + name);
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		qFatal("Can not create device file %s", qPrintable(fileName));
+	}
+
+	file.write(contents);
+	file.close();
+	return fileName;
+}
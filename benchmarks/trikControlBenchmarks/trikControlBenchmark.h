@@ -0,0 +1,109 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "benchmarkDeviceBackend.h"
+
+namespace benchmarks {
+
+/// Microbenchmarks of trikControl device paths: I2C communication, device file reads, input events parsing,
+/// virtual sensor output parsing and drawing on a display.
+class TrikControlBenchmark : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/// Creates device files used by benchmarks and finds I2C bus.
+	void initTestCase();
+
+	/// Removes device files.
+	void cleanupTestCase();
+
+	/// Sends a command through I2C bus of i2c-stub module, or through ioctl on a regular file if it is not loaded.
+	void i2cSend();
+
+	/// Reads a register through I2C bus, like i2cSend.
+	void i2cRead();
+
+	void digitalSensorRead();
+	void pwmCaptureFrequency();
+
+	/// Writes a report of three axes into a FIFO read by input device and waits until the sensor sees it.
+	void sensor3dEvents();
+
+	/// Writes a line into virtual sensor output FIFO and waits until the sensor parses it.
+	void lineSensorParsing();
+
+	void graphicsWidgetDrawPoints_data();
+	void graphicsWidgetDrawPoints();
+
+	void graphicsWidgetDrawLines_data();
+	void graphicsWidgetDrawLines();
+
+	/// Draws 100000 points over existing ones with another color.
+	void graphicsWidgetRecolorPoints();
+
+	/// Draws points through Display one call at a time, in a frame and as one array, including delivery to GUI
+	/// thread, with widget and in-memory framebuffer renderers.
+	void displayDrawPoints_data();
+	void displayDrawPoints();
+
+	/// Updates ten labels showing changing numbers one call at a time and in a frame, and delivers them to a screen.
+	void displayUpdateLabels_data();
+	void displayUpdateLabels();
+
+	/// Looks up already decoded image in image cache, including check of file modification time.
+	void imageCacheLookup();
+
+	/// Compiles config.xml with streaming parser.
+	void configCompile();
+
+	/// Parses config.xml into DOM tree and reads all attributes, as configurer did before streaming parser.
+	void configParseDom();
+
+	/// Reads config.xml from a file and compiles it.
+	void configLoad();
+
+	/// Creates configurer from config.xml when there is no cache, including writing of cache.
+	void configurerCacheMiss();
+
+	/// Creates configurer from up to date cache, without reading config.xml.
+	void configurerCacheHit();
+
+private:
+	/// Creates a FIFO in temporary directory and returns its name.
+	QString createFifo(QString const &name);
+
+	/// Writes given contents to a file in temporary directory and returns its name.
+	QString createDeviceFile(QString const &name, QByteArray const &contents);
+
+	BenchmarkDeviceBackend mBackend;
+	QString mDigitalSensorFile;
+	QString mPwmFrequencyFile;
+	QString mPwmDutyFile;
+
+	/// Device file of I2C bus and address of a device on it.
+	QString mI2cDevice;
+	int mI2cAddress = 0;
+
+	/// FIFOs created by benchmarks.
+	QStringList mFifos;
+};
+
+}
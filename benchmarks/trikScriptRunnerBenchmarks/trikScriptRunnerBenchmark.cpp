@@ -0,0 +1,234 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "trikScriptRunnerBenchmark.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoop>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+#include <QtTest/QTest>
+
+#include <trikKernel/metricsRegistry.h>
+#include <trikControl/brick.h>
+#include <trikControl/keys.h>
+#include <trikScriptRunner/trikScriptRunner.h>
+
+#include "src/scriptEngineWorker.h"
+#include "simulatorConfig.h"
+
+using namespace benchmarks;
+
+/// Maximal time to wait for script completion in milliseconds.
+static int const scriptTimeout = 10000;
+
+/// Number of script or thread starts over which start latency is averaged.
+static int const latencySamples = 100;
+
+TrikScriptRunnerBenchmark::TrikScriptRunnerBenchmark()
+{
+}
+
+TrikScriptRunnerBenchmark::~TrikScriptRunnerBenchmark()
+{
+}
+
+void TrikScriptRunnerBenchmark::initTestCase()
+{
+	mConfigPath = SimulatorConfig::create();
+	mStartDirPath = QCoreApplication::applicationDirPath() + "/";
+	mBrick.reset(new trikControl::Brick(*QThread::currentThread(), mConfigPath, mStartDirPath));
+	mWorker.reset(new trikScriptRunner::ScriptEngineWorker(*mBrick, mStartDirPath));
+	mWorker->init();
+	trikKernel::MetricsRegistry::reset();
+}
+
+void TrikScriptRunnerBenchmark::cleanupTestCase()
+{
+	qDebug("%s", qPrintable(trikKernel::MetricsRegistry::toText()));
+
+	mWorker.reset();
+	mBrick.reset();
+}
+
+void TrikScriptRunnerBenchmark::runToFirstStatement()
+{
+	trikScriptRunner::TrikScriptRunner runner(*mBrick, mStartDirPath);
+	QVERIFY(mBrick->keys() != nullptr);
+
+	// Script emits keys signal in its first statement, handler is called directly in script thread and notes the time.
+	connect(mBrick->keys(), SIGNAL(buttonPressed(int,int)), this, SLOT(onFirstStatement()), Qt::DirectConnection);
+
+	qint64 totalLatency = 0;
+	int runs = 0;
+	QBENCHMARK {
+		mFirstStatementTime = -1;
+		qint64 const runTime = trikKernel::MetricsRegistry::now();
+		QVERIFY(runToCompletion(runner, "brick.keys().buttonPressed(-1, 0);"));
+		QVERIFY(mFirstStatementTime >= 0);
+		totalLatency += mFirstStatementTime - runTime;
+		++runs;
+	}
+
+	disconnect(mBrick->keys(), SIGNAL(buttonPressed(int,int)), this, SLOT(onFirstStatement()));
+
+	// Time to completion includes engine reset after the script, so only the time to first statement is reported.
+	QTest::setBenchmarkResult(totalLatency / 1000.0 / runs, QTest::WalltimeMilliseconds);
+}
+
+void TrikScriptRunnerBenchmark::scriptStartLatency()
+{
+	trikKernel::Histogram &startLatency = trikKernel::MetricsRegistry::histogram("scriptRunner.startLatencyUs");
+	trikScriptRunner::TrikScriptRunner runner(*mBrick, mStartDirPath);
+
+	startLatency.reset();
+	for (int i = 0; i < latencySamples; ++i) {
+		QVERIFY(runToCompletion(runner, "var a = 1;"));
+	}
+
+	QCOMPARE(startLatency.count(), static_cast<qint64>(latencySamples));
+	QTest::setBenchmarkResult(startLatency.sum() / 1000.0 / startLatency.count(), QTest::WalltimeMilliseconds);
+}
+
+void TrikScriptRunnerBenchmark::threadSpawnLatency()
+{
+	trikKernel::Histogram &spawnLatency = trikKernel::MetricsRegistry::histogram("threading.spawnLatencyUs");
+	QString const script =
+			"function worker() {}\n"
+			"function main() {\n"
+			"	Threading.start(\"worker\");\n"
+			"}\n";
+
+	spawnLatency.reset();
+	for (int i = 0; i < latencySamples; ++i) {
+		mWorker->run(script, false, "main");
+	}
+
+	QThreadPool::globalInstance()->waitForDone();
+	QCOMPARE(spawnLatency.count(), static_cast<qint64>(latencySamples));
+	QTest::setBenchmarkResult(spawnLatency.sum() / 1000.0 / spawnLatency.count(), QTest::WalltimeMilliseconds);
+}
+
+void TrikScriptRunnerBenchmark::resetScriptEngine()
+{
+	QBENCHMARK {
+		mWorker->init();
+
+		// Old engine is deleted with deleteLater(), so cost of its deletion is included too.
+		QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+	}
+}
+
+void TrikScriptRunnerBenchmark::clone_data()
+{
+	QTest::addColumn<int>("globals");
+
+	QTest::newRow("0") << 0;
+	QTest::newRow("100") << 100;
+	QTest::newRow("1000") << 1000;
+}
+
+void TrikScriptRunnerBenchmark::clone()
+{
+	QFETCH(int, globals);
+
+	QString script;
+	for (int i = 0; i < globals; ++i) {
+		script += QString("var g%1 = {number: %1, text: \"value %1\", array: [1, 2, 3]};\n").arg(i);
+	}
+
+	mWorker->init();
+	evaluate(script);
+
+	QBENCHMARK {
+		delete &mWorker->clone();
+	}
+
+	mBrick->reset();
+}
+
+void TrikScriptRunnerBenchmark::threadingStart()
+{
+	QString const script =
+			"function worker() {}\n"
+			"function main() {\n"
+			"	for (var i = 0; i < 10; ++i) {\n"
+			"		Threading.start(\"worker\");\n"
+			"	}\n"
+			"}\n";
+
+	QBENCHMARK {
+		mWorker->run(script, false, "main");
+	}
+}
+
+void TrikScriptRunnerBenchmark::motorSetPower()
+{
+	mWorker->init();
+
+	QBENCHMARK {
+		evaluate("var m = brick.motor(\"M1\"); for (var i = 0; i < 1000; ++i) { m.setPower(i % 100); }");
+	}
+
+	mBrick->reset();
+}
+
+void TrikScriptRunnerBenchmark::sensorRead()
+{
+	mWorker->init();
+
+	QBENCHMARK {
+		evaluate("var s = brick.sensor(\"A1\"); for (var i = 0; i < 1000; ++i) { s.read(); }");
+	}
+
+	mBrick->reset();
+}
+
+void TrikScriptRunnerBenchmark::vectorMarshalling()
+{
+	mWorker->init();
+
+	QBENCHMARK {
+		evaluate("var a = brick.accelerometer(); for (var i = 0; i < 1000; ++i) { a.read(); }");
+	}
+
+	mBrick->reset();
+}
+
+void TrikScriptRunnerBenchmark::onFirstStatement()
+{
+	if (mFirstStatementTime < 0) {
+		mFirstStatementTime = trikKernel::MetricsRegistry::now();
+	}
+}
+
+bool TrikScriptRunnerBenchmark::runToCompletion(trikScriptRunner::TrikScriptRunner &runner, QString const &script)
+{
+	QEventLoop loop;
+	QTimer timeout;
+	timeout.setSingleShot(true);
+	connect(&runner, SIGNAL(completed(QString)), &loop, SLOT(quit()));
+	connect(&timeout, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+	timeout.start(scriptTimeout);
+	runner.run(script);
+	loop.exec();
+	return timeout.isActive();
+}
+
+void TrikScriptRunnerBenchmark::evaluate(QString const &script)
+{
+	mWorker->run(script, true, "");
+}
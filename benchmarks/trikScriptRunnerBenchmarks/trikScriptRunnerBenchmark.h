@@ -0,0 +1,101 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QString>
+
+#include <atomic>
+
+namespace trikControl {
+class Brick;
+}
+
+namespace trikScriptRunner {
+class ScriptEngineWorker;
+class TrikScriptRunner;
+}
+
+namespace benchmarks {
+
+/// Benchmarks of script engine lifecycle and overhead of calls to Brick from scripts. Brick works on simulated
+/// devices without latencies, so only script runner and trikControl code is measured.
+class TrikScriptRunnerBenchmark : public QObject
+{
+	Q_OBJECT
+
+public:
+	TrikScriptRunnerBenchmark();
+	~TrikScriptRunnerBenchmark() override;
+
+public slots:
+	/// Notes the time when the first statement of a script run by runToFirstStatement() is executed. Not a test,
+	/// so it is not a private slot.
+	void onFirstStatement();
+
+private slots:
+	/// Creates simulated Brick and script engine worker.
+	void initTestCase();
+
+	/// Prints collected runtime metrics.
+	void cleanupTestCase();
+
+	/// Time from TrikScriptRunner::run() to execution of the first statement of a script in script runner thread.
+	void runToFirstStatement();
+
+	/// Mean of "scriptRunner.startLatencyUs" metric over 100 script runs, in milliseconds.
+	void scriptStartLatency();
+
+	/// Mean of "threading.spawnLatencyUs" metric over 100 Threading.start() calls, in milliseconds.
+	void threadSpawnLatency();
+
+	/// Cost of creating and initializing new script engine.
+	void resetScriptEngine();
+
+	/// Cost of ScriptEngineWorker::clone() depending on a number of global variables.
+	void clone_data();
+	void clone();
+
+	/// Time to start and join 10 threads with Threading.start().
+	void threadingStart();
+
+	/// 1000 calls of brick.motor().setPower() from script.
+	void motorSetPower();
+
+	/// 1000 calls of sensor.read() from script.
+	void sensorRead();
+
+	/// 1000 calls of accelerometer read, that marshals QVector<int> to script array.
+	void vectorMarshalling();
+
+private:
+	/// Runs script with given runner and waits for its completion.
+	/// @returns false if script did not complete in time.
+	bool runToCompletion(trikScriptRunner::TrikScriptRunner &runner, QString const &script);
+
+	/// Evaluates script in event-driven mode, so script engine is not reset after evaluation.
+	void evaluate(QString const &script);
+
+	QString mConfigPath;
+	QString mStartDirPath;
+	QScopedPointer<trikControl::Brick> mBrick;
+	QScopedPointer<trikScriptRunner::ScriptEngineWorker> mWorker;
+
+	/// Time of the first statement of a script in microseconds, written in script runner thread.
+	std::atomic<qint64> mFirstStatementTime {-1};
+};
+
+}
@@ -0,0 +1,53 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "trikWiFiBenchmark.h"
+
+#include <QtCore/QDir>
+#include <QtTest/QTest>
+
+#include <trikWiFi/trikWiFi.h>
+
+#include "src/wpaRequestWorker.h"
+#include "src/wpaSupplicantCommunicator.h"
+
+using namespace benchmarks;
+using namespace tests;
+using namespace trikWiFi;
+
+void TrikWiFiBenchmark::init()
+{
+	mDaemonFile = QDir::temp().filePath("trikWiFiBenchmark.wpa");
+	mClientPrefix = QDir::temp().filePath("trikWiFiBenchmark.");
+	mWpaSupplicant.reset(new FakeWpaSupplicant(mDaemonFile));
+}
+
+void TrikWiFiBenchmark::cleanup()
+{
+	mWpaSupplicant.reset();
+}
+
+void TrikWiFiBenchmark::scanResultsFetch()
+{
+	mWpaSupplicant->setHandler([](QString const &command) {
+		return FakeWpaSupplicant::bssRangeReply(command, 100);
+	});
+
+	WpaSupplicantCommunicator communicator(mClientPrefix + "ctrl", mDaemonFile);
+
+	QBENCHMARK {
+		QList<ScanResult> const results = WpaRequestWorker::scanResults(communicator);
+		Q_UNUSED(results)
+	}
+}
@@ -0,0 +1,46 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QString>
+
+#include "fakeWpaSupplicant.h"
+
+namespace benchmarks {
+
+/// Benchmarks of trikWiFi against a fake wpa_supplicant from trikWiFi tests.
+class TrikWiFiBenchmark : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/// Starts fake wpa_supplicant.
+	void init();
+
+	/// Stops fake wpa_supplicant.
+	void cleanup();
+
+	/// Reads a table of 100 access points.
+	void scanResultsFetch();
+
+private:
+	QString mDaemonFile;
+	QString mClientPrefix;
+	QScopedPointer<tests::FakeWpaSupplicant> mWpaSupplicant;
+};
+
+}
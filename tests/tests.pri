@@ -0,0 +1,30 @@
+# Copyright 2014 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Settings common to all test projects.
+
+include(../global.pri)
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+QT += testlib
+
+# Tests use internal classes of libraries, so include paths to their sources are added too.
+INCLUDEPATH += \
+	$$PWD \
+	$$PWD/../trikKernel/include/ \
+	$$PWD/../trikWiFi/ \
+	$$PWD/../trikWiFi/include/ \
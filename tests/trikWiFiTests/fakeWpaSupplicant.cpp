@@ -0,0 +1,178 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "fakeWpaSupplicant.h"
+
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <QtCore/QFile>
+
+using namespace tests;
+
+/// How often serving thread checks whether it shall stop, in milliseconds.
+static int const pollInterval = 20;
+
+FakeWpaSupplicant::FakeWpaSupplicant(QString const &socketFile)
+	: mSocketFile(socketFile)
+	, mSocket(socket(PF_UNIX, SOCK_DGRAM, 0))
+	, mStopped(false)
+{
+	if (mSocket < 0) {
+		throw "Can not create fake wpa_supplicant socket";
+	}
+
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, QFile::encodeName(socketFile).constData(), sizeof(address.sun_path) - 1);
+	unlink(address.sun_path);
+	if (bind(mSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+		close(mSocket);
+		throw "Can not bind fake wpa_supplicant socket";
+	}
+
+	mThread = std::thread(&FakeWpaSupplicant::serve, this);
+}
+
+FakeWpaSupplicant::~FakeWpaSupplicant()
+{
+	mStopped = true;
+	mThread.join();
+	close(mSocket);
+	unlink(QFile::encodeName(mSocketFile).constData());
+}
+
+void FakeWpaSupplicant::setHandler(Handler const &handler)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mHandler = handler;
+}
+
+void FakeWpaSupplicant::sendEvent(QString const &event)
+{
+	QByteArray const message = "<3>" + event.toLatin1();
+
+	std::lock_guard<std::mutex> lock(mLock);
+	for (sockaddr_un const &client : mAttachedClients) {
+		sendto(mSocket, message.constData(), message.size(), 0
+				, reinterpret_cast<sockaddr const *>(&client), sizeof(client));
+	}
+}
+
+QStringList FakeWpaSupplicant::commands() const
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	return mCommands;
+}
+
+QStringList FakeWpaSupplicant::commands(QString const &prefix) const
+{
+	QStringList result;
+	for (QString const &command : commands()) {
+		if (command.startsWith(prefix)) {
+			result << command;
+		}
+	}
+
+	return result;
+}
+
+void FakeWpaSupplicant::clearCommands()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mCommands.clear();
+}
+
+void FakeWpaSupplicant::serve()
+{
+	while (!mStopped) {
+		pollfd descriptor = {mSocket, POLLIN, 0};
+		if (poll(&descriptor, 1, pollInterval) <= 0) {
+			continue;
+		}
+
+		char buffer[4096];
+		sockaddr_un client;
+		socklen_t clientSize = sizeof(client);
+		memset(&client, 0, sizeof(client));
+		ssize_t const size = recvfrom(mSocket, buffer, sizeof(buffer), 0
+				, reinterpret_cast<sockaddr *>(&client), &clientSize);
+
+		if (size <= 0) {
+			continue;
+		}
+
+		// Clients send commands with terminating zero.
+		QString const command = QString::fromLatin1(buffer, static_cast<int>(size)).remove(QChar('\0'));
+
+		QByteArray reply;
+		Handler handler;
+		{
+			std::lock_guard<std::mutex> lock(mLock);
+			mCommands << command;
+			if (command == "ATTACH") {
+				mAttachedClients << client;
+				reply = "OK\n";
+			} else if (command == "DETACH") {
+				for (int i = mAttachedClients.size() - 1; i >= 0; --i) {
+					if (strcmp(mAttachedClients[i].sun_path, client.sun_path) == 0) {
+						mAttachedClients.removeAt(i);
+					}
+				}
+
+				reply = "OK\n";
+			} else {
+				handler = mHandler;
+			}
+		}
+
+		if (handler) {
+			reply = handler(command);
+		}
+
+		sendto(mSocket, reply.constData(), reply.size(), 0, reinterpret_cast<sockaddr const *>(&client), clientSize);
+	}
+}
+
+QByteArray FakeWpaSupplicant::bssEntry(int id)
+{
+	return QString("id=%1\nbssid=02:00:00:00:00:%2\nfreq=2412\nlevel=%3\nssid=network%1\n")
+			.arg(id).arg(id, 2, 16, QChar('0')).arg(-40 - id % 50).toLatin1();
+}
+
+QByteArray FakeWpaSupplicant::bssRangeReply(QString const &command, int tableSize)
+{
+	if (!command.startsWith("BSS RANGE=")) {
+		return QByteArray();
+	}
+
+	QString const range = command.section(' ', 1, 1).mid(QString("RANGE=").length());
+	int const first = range == "ALL" ? 0 : range.section('-', 0, 0).toInt();
+
+	QByteArray reply;
+	for (int id = first; id < tableSize; ++id) {
+		QByteArray const entry = bssEntry(id) + (id == tableSize - 1 ? "" : "====\n");
+		if (reply.size() + entry.size() > replySize) {
+			break;
+		}
+
+		reply += entry;
+	}
+
+	return reply;
+}
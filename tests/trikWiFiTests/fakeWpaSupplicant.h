@@ -0,0 +1,86 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <sys/un.h>
+
+namespace tests {
+
+/// Stand-in for wpa_supplicant control interface: binds a UNIX datagram socket and replies to commands with
+/// a scripted handler. Serves requests in its own thread, since TrikWiFi waits for replies synchronously.
+/// Clients that sent ATTACH receive events sent by sendEvent(). Used by trikWiFi tests and benchmarks.
+class FakeWpaSupplicant
+{
+public:
+	/// Produces a reply to a command, called in the thread of the fake.
+	typedef std::function<QByteArray(QString const &command)> Handler;
+
+	/// Constructor. Throws an exception if the socket can not be created.
+	/// @param socketFile - file to bind the socket to, the one passed to TrikWiFi as daemon file.
+	explicit FakeWpaSupplicant(QString const &socketFile);
+
+	~FakeWpaSupplicant();
+
+	/// Sets a handler of commands other than ATTACH and DETACH. Without a handler every command gets empty reply.
+	void setHandler(Handler const &handler);
+
+	/// Sends unsolicited event, like "CTRL-EVENT-SCAN-RESULTS", to attached clients. Can be called from any thread,
+	/// including the handler.
+	void sendEvent(QString const &event);
+
+	/// Returns all commands received so far, in order of arrival.
+	QStringList commands() const;
+
+	/// Returns received commands that start with given prefix.
+	QStringList commands(QString const &prefix) const;
+
+	/// Forgets received commands.
+	void clearCommands();
+
+	/// Size of wpa_supplicant reply buffer.
+	static int const replySize = 4096;
+
+	/// Returns BSS entry with given id, as wpa_supplicant prints it for requested fields.
+	static QByteArray bssEntry(int id);
+
+	/// Returns reply of wpa_supplicant to "BSS RANGE=" command for a table of given size: as many entries as fit into
+	/// reply buffer, with "====" after every entry except the last one in the table. Other commands get empty reply.
+	static QByteArray bssRangeReply(QString const &command, int tableSize);
+
+private:
+	void serve();
+
+	QString mSocketFile;
+	int mSocket;
+	std::atomic<bool> mStopped;
+	std::thread mThread;
+
+	mutable std::mutex mLock;
+	Handler mHandler;
+	QStringList mCommands;
+	QList<sockaddr_un> mAttachedClients;
+};
+
+}
@@ -0,0 +1,221 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "trikWiFiTest.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QRegExp>
+#include <QtCore/QStringList>
+#include <QtTest/QTest>
+
+#include <trikKernel/metricsRegistry.h>
+#include <trikWiFi/connectionManager.h>
+#include <trikWiFi/trikWiFi.h>
+
+#include "src/wpaRequestWorker.h"
+#include "src/wpaSupplicantCommunicator.h"
+
+using namespace tests;
+using namespace trikWiFi;
+
+void TrikWiFiTest::init()
+{
+	mDaemonFile = QDir::temp().filePath("trikWiFiTest.wpa");
+	mClientPrefix = QDir::temp().filePath("trikWiFiTest.");
+	mWpaSupplicant.reset(new FakeWpaSupplicant(mDaemonFile));
+}
+
+void TrikWiFiTest::cleanup()
+{
+	mWpaSupplicant.reset();
+}
+
+void TrikWiFiTest::scanResultsRangeContinuation()
+{
+	int const tableSize = 100;
+	mWpaSupplicant->setHandler([](QString const &command) {
+		return FakeWpaSupplicant::bssRangeReply(command, tableSize);
+	});
+
+	WpaSupplicantCommunicator communicator(mClientPrefix + "ctrl", mDaemonFile);
+	QList<ScanResult> const results = WpaRequestWorker::scanResults(communicator);
+
+	QCOMPARE(results.size(), tableSize);
+	for (int i = 0; i < tableSize; ++i) {
+		QCOMPARE(results[i].ssid, QString("network%1").arg(i));
+	}
+
+	QStringList const requests = mWpaSupplicant->commands("BSS RANGE=");
+	QVERIFY(requests.size() > 1);
+	QVERIFY(requests[0].startsWith("BSS RANGE=ALL "));
+	for (int i = 1; i < requests.size(); ++i) {
+		QVERIFY(QRegExp("BSS RANGE=\\d+- .*").exactMatch(requests[i]));
+	}
+}
+
+void TrikWiFiTest::scanResultsFallback()
+{
+	mWpaSupplicant->setHandler([](QString const &command) {
+		if (command.startsWith("BSS RANGE=")) {
+			return QByteArray("FAIL\n");
+		}
+
+		int const id = command.mid(QString("BSS ").length()).toInt();
+		return id < 3 ? FakeWpaSupplicant::bssEntry(id) : QByteArray();
+	});
+
+	WpaSupplicantCommunicator communicator(mClientPrefix + "ctrl", mDaemonFile);
+	QList<ScanResult> const results = WpaRequestWorker::scanResults(communicator);
+
+	QCOMPARE(results.size(), 3);
+	QCOMPARE(results[2].bssid, QString("02:00:00:00:00:02"));
+	QCOMPARE(mWpaSupplicant->commands("BSS ").mid(1), QStringList() << "BSS 0" << "BSS 1" << "BSS 2" << "BSS 3");
+}
+
+void TrikWiFiTest::requestAsyncOrder()
+{
+	mWpaSupplicant->setHandler([](QString const &command) {
+		return command.startsWith("BSS ") ? QByteArray() : "reply to " + command.toLatin1();
+	});
+
+	TrikWiFi wiFi(mClientPrefix, mDaemonFile);
+
+	int const requestCount = 50;
+	QStringList replies;
+	for (int i = 0; i < requestCount; ++i) {
+		wiFi.requestAsync("PING " + QString::number(i), [&replies](int result, QString const &reply) {
+			replies << QString::number(result) + " " + reply;
+		});
+	}
+
+	QTRY_COMPARE(replies.size(), requestCount);
+	for (int i = 0; i < requestCount; ++i) {
+		QCOMPARE(replies[i], QString("0 reply to PING %1").arg(i));
+	}
+}
+
+void TrikWiFiTest::roamOnWeakSignal()
+{
+	trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("wifi.reconnectLatencyUs");
+
+	mWpaSupplicant->setHandler([](QString const &command) {
+		return officeReply(command, "OK\n");
+	});
+
+	TrikWiFi wiFi(mClientPrefix, mDaemonFile);
+	wiFi.setDhcpCommand("");
+	ConnectionManager manager(wiFi);
+	connectManager(wiFi, manager);
+
+	mWpaSupplicant->sendEvent("CTRL-EVENT-SIGNAL-CHANGE above=0 signal=-75 noise=-95 txrate=65000");
+	QTRY_COMPARE(mWpaSupplicant->commands("SCAN"), QStringList() << "SCAN");
+
+	mWpaSupplicant->sendEvent("CTRL-EVENT-SCAN-RESULTS ");
+	QTRY_COMPARE(mWpaSupplicant->commands("ROAM "), QStringList() << "ROAM 02:00:00:00:00:02");
+
+	qint64 const reconnects = latency.count();
+	mWpaSupplicant->sendEvent("CTRL-EVENT-CONNECTED - Connection to 02:00:00:00:00:02 completed [id=0 id_str=]");
+	QTRY_COMPARE(latency.count(), reconnects + 1);
+	QVERIFY(manager.lastReconnectLatency() >= 0);
+}
+
+void TrikWiFiTest::failedRoamIsRetried()
+{
+	trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("wifi.reconnectLatencyUs");
+
+	mWpaSupplicant->setHandler([](QString const &command) {
+		return officeReply(command, "FAIL\n");
+	});
+
+	TrikWiFi wiFi(mClientPrefix, mDaemonFile);
+	wiFi.setDhcpCommand("");
+	ConnectionManager manager(wiFi);
+	connectManager(wiFi, manager);
+
+	mWpaSupplicant->sendEvent("CTRL-EVENT-SIGNAL-CHANGE above=0 signal=-75 noise=-95 txrate=65000");
+	mWpaSupplicant->sendEvent("CTRL-EVENT-SCAN-RESULTS ");
+	QTRY_COMPARE(mWpaSupplicant->commands("ROAM ").size(), 1);
+
+	// Roaming would be suppressed as already in progress if failed attempt left reconnect start time set.
+	mWpaSupplicant->sendEvent("CTRL-EVENT-SCAN-RESULTS ");
+	QTRY_COMPARE(mWpaSupplicant->commands("ROAM ").size(), 2);
+
+	// Link stayed up, so a connection event that comes now is not a reconnect.
+	qint64 const reconnects = latency.count();
+	mWpaSupplicant->sendEvent("CTRL-EVENT-CONNECTED - Connection to 02:00:00:00:00:01 completed [id=0 id_str=]");
+	QTRY_COMPARE(mWpaSupplicant->commands("STATUS").size(), 2);
+	QCOMPARE(latency.count(), reconnects);
+}
+
+void TrikWiFiTest::reassociateOnLinkLoss()
+{
+	trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("wifi.reconnectLatencyUs");
+
+	mWpaSupplicant->setHandler([](QString const &command) {
+		return officeReply(command, "OK\n");
+	});
+
+	TrikWiFi wiFi(mClientPrefix, mDaemonFile);
+	wiFi.setDhcpCommand("");
+	ConnectionManager manager(wiFi);
+	connectManager(wiFi, manager);
+
+	mWpaSupplicant->sendEvent("CTRL-EVENT-DISCONNECTED bssid=02:00:00:00:00:01 reason=4");
+	QTRY_COMPARE(mWpaSupplicant->commands("REASSOCIATE").size(), 1);
+
+	// Retry timer reassociates again while link is down.
+	QTRY_COMPARE_WITH_TIMEOUT(mWpaSupplicant->commands("REASSOCIATE").size(), 2, 5000);
+
+	qint64 const reconnects = latency.count();
+	mWpaSupplicant->sendEvent("CTRL-EVENT-CONNECTED - Connection to 02:00:00:00:00:01 completed [id=0 id_str=]");
+	QTRY_COMPARE(latency.count(), reconnects + 1);
+	QVERIFY(manager.lastReconnectLatency() >= 3000);
+
+	// And stops when connection is restored.
+	QTest::qWait(4000);
+	QCOMPARE(mWpaSupplicant->commands("REASSOCIATE").size(), 2);
+}
+
+void TrikWiFiTest::connectManager(TrikWiFi &wiFi, ConnectionManager &manager)
+{
+	manager.connectTo(0);
+	QTRY_COMPARE(mWpaSupplicant->commands("SELECT_NETWORK"), QStringList() << "SELECT_NETWORK 0");
+
+	mWpaSupplicant->sendEvent("CTRL-EVENT-CONNECTED - Connection to 02:00:00:00:00:01 completed [id=0 id_str=]");
+	QTRY_COMPARE(mWpaSupplicant->commands("STATUS").size(), 1);
+
+	// Replies come in order of requests, so STATUS reply is processed when the next request is replied.
+	bool synchronized = false;
+	wiFi.requestAsync("PING", [&synchronized](int, QString const &) {
+		synchronized = true;
+	});
+	QTRY_VERIFY(synchronized);
+}
+
+QByteArray TrikWiFiTest::officeReply(QString const &command, QByteArray const &roamReply)
+{
+	if (command == "STATUS") {
+		return "bssid=02:00:00:00:00:01\nfreq=2412\nssid=office\nid=0\nwpa_state=COMPLETED\n";
+	} else if (command.startsWith("BSS RANGE=")) {
+		return "id=0\nbssid=02:00:00:00:00:01\nfreq=2412\nlevel=-75\nssid=office\n====\n"
+				"id=1\nbssid=02:00:00:00:00:02\nfreq=2437\nlevel=-50\nssid=office\n====\n"
+				"id=2\nbssid=02:00:00:00:00:03\nfreq=2462\nlevel=-30\nssid=guest\n";
+	} else if (command.startsWith("BSS ")) {
+		return "";
+	} else if (command.startsWith("ROAM ")) {
+		return roamReply;
+	}
+
+	return "OK\n";
+}
@@ -0,0 +1,76 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QString>
+
+#include "fakeWpaSupplicant.h"
+
+namespace trikWiFi {
+class ConnectionManager;
+class TrikWiFi;
+}
+
+namespace tests {
+
+/// Tests of trikWiFi against a fake wpa_supplicant that serves a table of access points the way the real one does.
+class TrikWiFiTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/// Starts fake wpa_supplicant.
+	void init();
+
+	/// Stops fake wpa_supplicant.
+	void cleanup();
+
+	/// Checks that scan results that do not fit into one reply are read with following "BSS RANGE=<id>-" requests.
+	void scanResultsRangeContinuation();
+
+	/// Checks that scan results are read with "BSS <n>" requests if wpa_supplicant fails range request.
+	void scanResultsFallback();
+
+	/// Checks that callbacks of asynchronous requests are called in order of submission, each with its own reply.
+	void requestAsyncOrder();
+
+	/// Checks that connection manager scans when signal becomes weak and roams to a stronger access point of the same
+	/// network, and that reconnect latency is recorded.
+	void roamOnWeakSignal();
+
+	/// Checks that failed roaming does not leave reconnect pending, so next scan results lead to a new attempt.
+	void failedRoamIsRetried();
+
+	/// Checks that connection manager reassociates right after link loss and then periodically until connected.
+	void reassociateOnLinkLoss();
+
+private:
+	/// Connects given manager to network 0 and waits until it knows current access point.
+	void connectManager(trikWiFi::TrikWiFi &wiFi, trikWiFi::ConnectionManager &manager);
+
+	/// Returns reply of wpa_supplicant that is connected to "office" network through 02:00:00:00:00:01 and sees
+	/// a stronger access point 02:00:00:00:00:02 of the same network.
+	/// @param roamReply - reply to "ROAM" command.
+	static QByteArray officeReply(QString const &command, QByteArray const &roamReply);
+
+	QString mDaemonFile;
+	QString mClientPrefix;
+	QScopedPointer<FakeWpaSupplicant> mWpaSupplicant;
+};
+
+}
@@ -32,11 +32,15 @@ class Brick;
 namespace trikCommunicator {
 
 class Connection;
+class FileHashCache;
 
 /// Class that enables connection with a client running on computer (TrikLab or remote control).
 /// Communication subsystem consists of TrikCommunicator object which runs in main thread and listens for incoming
 /// connections, Connection objects --- one for every connected client, they run in separate threads each, and
 /// ScriptRunnerWrapper object in main thread which processes signals from Connections.
+/// Alternatively, all Connection objects can be served by one common thread, see setSingleThreaded(). Sockets are
+/// non-blocking and each connection has its own input buffer, so one event loop is enough for all of them and
+/// idle clients do not cost a thread each.
 class TrikCommunicator : public QTcpServer
 {
 	Q_OBJECT
@@ -48,10 +52,16 @@ public:
 	explicit TrikCommunicator(trikControl::Brick &brick, QString const &startDirPath);
 
 	/// Constructor that accepts external script runner and issues commands to it.
-	explicit TrikCommunicator(trikScriptRunner::TrikScriptRunner &runner);
+	/// @param runner - script runner that executes commands of clients.
+	/// @param brick - brick that is controlled by the runner, its devices are read directly for telemetry.
+	TrikCommunicator(trikScriptRunner::TrikScriptRunner &runner, trikControl::Brick &brick);
 
 	~TrikCommunicator();
 
+	/// Sets whether all connections shall be served by one common thread instead of a thread per connection.
+	/// Affects only connections accepted after the call. Default is a thread per connection.
+	void setSingleThreaded(bool singleThreaded);
+
 	/// Starts listening given port on all network interfaces.
 	void startServer(int const &port);
 
@@ -72,7 +82,7 @@ protected:
 	void incomingConnection(int socketDescriptor);  // Override.
 
 private slots:
-	/// Called when connection thread finishes.
+	/// Called when client of a connection disconnects.
 	void onConnectionClosed();
 
 private:
@@ -87,8 +97,21 @@ private:
 	/// True, if we created our own script runner, false if we got it from someone.
 	bool const mHasScriptRunnerOwnership;
 
-	/// Maps thread object to corresponding connection worker object, to be able to correctly stop and delete them all.
-	QHash<QThread *, Connection *> mConnections;  // Has ownership over threads and connections.
+	/// Brick whose devices are sampled for telemetry.
+	trikControl::Brick &mBrick;
+
+	/// Checksums of files on a robot, shared by all connections.
+	QScopedPointer<FileHashCache> mHashCache;
+
+	/// True if all connections are served by mConnectionsThread.
+	bool mSingleThreaded;
+
+	/// Thread common to all connections in single-threaded mode, created when first needed.
+	QScopedPointer<QThread> mConnectionsThread;
+
+	/// Maps connection worker object to a thread it works in, to be able to correctly stop and delete them all.
+	/// In single-threaded mode all connections are mapped to mConnectionsThread.
+	QHash<Connection *, QThread *> mConnections;  // Has ownership over connections and their own threads.
 };
 
 }
@@ -14,24 +14,40 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QFile>
+#include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 #include <QtCore/QThread>
 
+#include <trikControl/brick.h>
 #include <trikKernel/fileUtils.h>
+#include <trikKernel/metricsRegistry.h>
 #include <trikScriptRunner/trikScriptRunner.h>
 
 #include "src/connection.h"
+#include "src/fileHashCache.h"
+#include "src/telemetryStream.h"
 
 using namespace trikCommunicator;
 
-Connection::Connection()
+/// Maximal telemetry sampling rate in Hz.
+static int const maxTelemetryRate = 100;
+
+Connection::Connection(FileHashCache &hashCache, trikControl::Brick &brick)
 	: mTrikScriptRunner(nullptr)
+	, mHashCache(hashCache)
+	, mBrick(brick)
+	, mCommandsProcessed(0)
+{
+}
+
+Connection::~Connection()
 {
 }
 
 void Connection::sendMessage(QString const &message)
 {
-	mSocket->write(message.toLocal8Bit());
+	QByteArray const data = message.toLocal8Bit();
+	mSocket->write(mParser.isLastMessageFramed() ? ProtocolParser::frame(data) : data);
 }
 
 void Connection::init(int socketDescriptor, trikScriptRunner::TrikScriptRunner *trikScriptRunner)
@@ -46,6 +62,8 @@ void Connection::init(int socketDescriptor, trikScriptRunner::TrikScriptRunner *
 
 	connect(mSocket.data(), SIGNAL(readyRead()), this, SLOT(onReadyRead()));
 	connect(mSocket.data(), SIGNAL(disconnected()), this, SLOT(disconnected()));
+
+	trikKernel::MetricsRegistry::gauge("communicator.connections").add(1);
 }
 
 void Connection::onReadyRead()
@@ -54,8 +72,38 @@ void Connection::onReadyRead()
 		return;
 	}
 
-	QByteArray const &data = mSocket->readAll();
-	QString command = QString::fromUtf8(data.constData());
+	mParser.append(mSocket->readAll());
+
+	QByteArray data;
+	while (mParser.takeMessage(data)) {
+		processCommand(data);
+	}
+
+	if (mParser.isBroken()) {
+		qDebug() << "Message longer than" << ProtocolParser::maxFrameSize << "bytes received, closing connection";
+		mSocket->abort();
+	}
+}
+
+void Connection::processCommand(QByteArray const &data)
+{
+	static trikKernel::Counter &commands = trikKernel::MetricsRegistry::counter("communicator.commands");
+
+	commands.increment();
+	++mCommandsProcessed;
+
+	if (data.startsWith("chunk:")) {
+		// Binary data, so it is passed to uploader as is, without conversion to a string.
+		static trikKernel::Counter &uploadedBytes = trikKernel::MetricsRegistry::counter("communicator.uploadedBytes");
+		int const headerLength = QByteArray("chunk:").length();
+		if (mUploader.write(QByteArray::fromRawData(data.constData() + headerLength, data.size() - headerLength))) {
+			uploadedBytes.increment(data.size() - headerLength);
+		}
+
+		return;
+	}
+
+	QString command = QString::fromUtf8(data.constData(), data.size());
 
 	if (!command.startsWith("keepalive")) {
 		// Discard "keepalive" output.
@@ -75,6 +123,7 @@ void Connection::onReadyRead()
 		QString const fileName = command.left(separatorPosition);
 		QString const fileContents = command.mid(separatorPosition + 1);
 		trikKernel::FileUtils::writeToFile(fileName, fileContents);
+		mHashCache.invalidate(fileName);
 	} else if (command.startsWith("run")) {
 		command.remove(0, QString("run:").length());
 		QString const fileContents = trikKernel::FileUtils::readFromFile(command);
@@ -86,11 +135,90 @@ void Connection::onReadyRead()
 		command.remove(0, QString("direct:").length());
 		QMetaObject::invokeMethod(mTrikScriptRunner, "run", Q_ARG(QString, command));
 		emit startedDirectScript();
+	} else if (command == "stats") {
+		sendMessage("stats:" + trikKernel::MetricsRegistry::toText());
+	} else if (command.startsWith("uploadEnd")) {
+		command.remove(0, QString("uploadEnd:").length());
+		QString const fileName = mUploader.fileName();
+		QByteArray const checksum = command.trimmed().toLower().toLatin1();
+		bool const uploaded = mUploader.finish(checksum);
+		if (uploaded) {
+			mHashCache.update(fileName, checksum);
+		}
+
+		sendMessage((uploaded ? "upload:ok:" : "upload:error:") + fileName);
+	} else if (command.startsWith("upload")) {
+		command.remove(0, QString("upload:").length());
+		if (!mUploader.start(command)) {
+			sendMessage("upload:error:" + command);
+		}
+	} else if (command.startsWith("sync")) {
+		command.remove(0, QString("sync:").length());
+		QStringList missingFiles;
+		for (QString const &entry : command.split('\n', QString::SkipEmptyParts)) {
+			int const separatorPosition = entry.indexOf(' ');
+			if (separatorPosition == -1) {
+				qDebug() << "Malformed 'sync' manifest entry" << entry;
+				continue;
+			}
+
+			QString const fileName = entry.mid(separatorPosition + 1).trimmed();
+			QByteArray const checksum = entry.left(separatorPosition).toLower().toLatin1();
+			if (mHashCache.hash(fileName) != checksum) {
+				missingFiles << fileName;
+			}
+		}
+
+		sendMessage("sync:" + missingFiles.join("\n"));
+	} else if (command.startsWith("subscribe")) {
+		command.remove(0, QString("subscribe:").length());
+		subscribe(command);
+	} else if (command == "unsubscribe") {
+		mTelemetry.reset();
+	}
+}
+
+void Connection::subscribe(QString const &parameters)
+{
+	mTelemetry.reset();
+
+	int const separatorPosition = parameters.indexOf(':');
+	bool rateOk = false;
+	int const rate = parameters.left(separatorPosition).toInt(&rateOk);
+	if (separatorPosition == -1 || !rateOk || rate <= 0 || rate > maxTelemetryRate) {
+		qDebug() << "Malformed 'subscribe' command";
+		sendMessage("subscribe:error");
+		return;
+	}
+
+	QList<TelemetryStream::Channel> channels;
+	for (QString const &port : parameters.mid(separatorPosition + 1).split(',', QString::SkipEmptyParts)) {
+		TelemetryStream::Channel const channel = TelemetryStream::channel(mBrick, port.trimmed());
+		if (!channel) {
+			sendMessage("subscribe:error:" + port.trimmed());
+			return;
+		}
+
+		channels << channel;
+	}
+
+	if (channels.isEmpty() || channels.size() > TelemetryEncoder::maxChannels) {
+		qDebug() << "Wrong number of ports in 'subscribe' command";
+		sendMessage("subscribe:error");
+		return;
 	}
+
+	mTelemetry.reset(new TelemetryStream(*mSocket, channels, rate));
 }
 
 void Connection::disconnected()
 {
 	qDebug() << "Disconnected.";
-	thread()->quit();
+
+	mTelemetry.reset();
+
+	trikKernel::MetricsRegistry::gauge("communicator.connections").add(-1);
+	trikKernel::MetricsRegistry::histogram("communicator.commandsPerConnection").record(mCommandsProcessed);
+
+	emit closed();
 }
@@ -18,14 +18,28 @@
 #include <QtCore/QScopedPointer>
 #include <QtNetwork/QTcpSocket>
 
+#include "src/fileUploader.h"
+#include "src/protocolParser.h"
+
 namespace trikScriptRunner {
 class TrikScriptRunner;
 }
 
+namespace trikControl {
+class Brick;
+}
+
 namespace trikCommunicator {
 
-/// Class that serves one client of TrikCommunicator. Meant to work in separate thread. Creates its own socket and
-/// handles all incoming messages, calling ScriptRunnerWrapper for brick functionality.
+class FileHashCache;
+class TelemetryStream;
+
+/// Class that serves one client of TrikCommunicator. Meant to work in separate thread, its own or shared with other
+/// connections. Creates its own socket and handles all incoming messages, calling ScriptRunnerWrapper for brick
+/// functionality.
+///
+/// Commands can be sent either framed, as "<length>:<command>", or as plain text, one command at a time, see
+/// ProtocolParser. Replies use the same format as the last command received.
 ///
 /// Connection accepts commands:
 /// - file:<file name>:<file contents> --- save given contents to a file with given name in current directory.
@@ -33,11 +47,30 @@ namespace trikCommunicator {
 /// - stop --- stop current script execution and a robot.
 /// - direct:<command> --- execute given script without saving it to a file.
 /// - keepalive --- do nothing, used to check the availability of connection.
+/// - stats --- reply with "stats:" followed by current values of runtime metrics, see trikKernel::MetricsRegistry.
+/// - upload:<file name> --- start binary upload of a file with given name, see FileUploader.
+/// - chunk:<bytes> --- append bytes to the file being uploaded. Chunks may contain arbitrary binary data, so they
+///   shall be framed.
+/// - uploadEnd:<checksum> --- finish upload, checksum is hex encoded SHA-1 of file contents. Connection replies with
+///   "upload:ok:<file name>" if file is saved or "upload:error:<file name>" if upload has failed.
+/// - sync:<manifest> --- manifest lists files of a project, one per line, as "<checksum> <file name>" where checksum is
+///   hex encoded SHA-1 of file contents. Connection replies with "sync:" followed by names of files that are missing
+///   or differ on a robot, one per line, so a client needs to upload only them.
+/// - subscribe:<rate>:<port>[,<port>...] --- start sending values of devices on given ports with given rate in Hz,
+///   see TelemetryStream for supported ports and TelemetryEncoder for format of frames. Frames are always framed.
+///   Connection replies with "subscribe:error:<port>" if there is no such port and with "subscribe:error" if the
+///   command is malformed.
+/// - unsubscribe --- stop sending device values.
 class Connection : public QObject {
 	Q_OBJECT
 
 public:
-	Connection();
+	/// Constructor.
+	/// @param hashCache - checksums of files on a robot, shared between connections.
+	/// @param brick - brick whose devices are sampled for telemetry.
+	Connection(FileHashCache &hashCache, trikControl::Brick &brick);
+
+	~Connection() override;
 
 	/// Writes a given message to inner socket.
 	void sendMessage(QString const &message);
@@ -49,6 +82,9 @@ signals:
 	/// Emitted when command to run script directly is received.
 	void startedDirectScript();
 
+	/// Emitted when client disconnects, connection shall be deleted after that.
+	void closed();
+
 public slots:
 	/// Creates socket and initializes connection, shall be called when Connection is already in its own thread.
 	/// @param socketDescriptor - native socket descriptor.
@@ -63,12 +99,36 @@ private slots:
 	void disconnected();
 
 private:
+	/// Executes one command received from a client.
+	void processCommand(QByteArray const &data);
+
+	/// Starts telemetry stream with parameters given as "<rate>:<port>[,<port>...]".
+	void subscribe(QString const &parameters);
+
 	/// Socket for this connection.
 	QScopedPointer<QTcpSocket> mSocket;
 
 	/// Common script runner object, located in another thread.
 	/// Does not have ownership.
 	trikScriptRunner::TrikScriptRunner *mTrikScriptRunner;
+
+	/// Splits incoming data into commands.
+	ProtocolParser mParser;
+
+	/// Writes uploaded files to disk.
+	FileUploader mUploader;
+
+	/// Checksums of files on a robot, used by "sync" command.
+	FileHashCache &mHashCache;
+
+	/// Brick whose devices are sampled for telemetry.
+	trikControl::Brick &mBrick;
+
+	/// Telemetry stream to a client, null if client is not subscribed.
+	QScopedPointer<TelemetryStream> mTelemetry;
+
+	/// Number of commands received through this connection.
+	int mCommandsProcessed;
 };
 
 }
@@ -0,0 +1,97 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/fileHashCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+
+using namespace trikCommunicator;
+
+/// Size of a block in which files are read when computing checksum.
+static qint64 const readBlockSize = 64 * 1024;
+
+/// Minimal time in milliseconds between file modification and caching of its checksum for the entry to be trusted.
+static qint64 const racyInterval = 1000;
+
+QByteArray FileHashCache::hash(QString const &fileName)
+{
+	QFileInfo const info(fileName);
+	if (!info.isFile()) {
+		return QByteArray();
+	}
+
+	QString const path = info.absoluteFilePath();
+
+	{
+		QMutexLocker locker(&mLock);
+		auto const entry = mEntries.constFind(path);
+		if (entry != mEntries.constEnd() && entry->size == info.size() && entry->lastModified == info.lastModified()
+				&& entry->lastModified.msecsTo(entry->cachedAt) >= racyInterval)
+		{
+			return entry->hash;
+		}
+	}
+
+	// File is read without holding the lock, so other connections are not blocked by disk IO.
+	QByteArray const result = computeHash(path);
+	if (!result.isEmpty()) {
+		QMutexLocker locker(&mLock);
+		mEntries.insert(path, Entry{info.size(), info.lastModified(), result, QDateTime::currentDateTime()});
+	}
+
+	return result;
+}
+
+void FileHashCache::update(QString const &fileName, QByteArray const &hash)
+{
+	QFileInfo const info(fileName);
+	if (!info.isFile()) {
+		return;
+	}
+
+	QMutexLocker locker(&mLock);
+	mEntries.insert(info.absoluteFilePath()
+			, Entry{info.size(), info.lastModified(), hash, QDateTime::currentDateTime()});
+}
+
+void FileHashCache::invalidate(QString const &fileName)
+{
+	QString const path = QFileInfo(fileName).absoluteFilePath();
+
+	QMutexLocker locker(&mLock);
+	mEntries.remove(path);
+}
+
+QByteArray FileHashCache::computeHash(QString const &fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return QByteArray();
+	}
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	while (!file.atEnd()) {
+		QByteArray const block = file.read(readBlockSize);
+		if (block.isEmpty()) {
+			return QByteArray();
+		}
+
+		hash.addData(block);
+	}
+
+	return hash.result().toHex();
+}
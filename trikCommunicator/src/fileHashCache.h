@@ -0,0 +1,62 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+namespace trikCommunicator {
+
+/// Cache of SHA-1 checksums of files on a robot, used to find out which files of a deployed project have changed.
+/// Checksum is recomputed only when file size or modification time differs from the cached one. Entries cached
+/// less than a second after file modification are not trusted, since file systems with coarse timestamps would not
+/// show one more write within the same second. Shared between connections, thread-safe.
+class FileHashCache
+{
+public:
+	/// Returns hex encoded SHA-1 of file contents, or empty array if file does not exist or can not be read.
+	QByteArray hash(QString const &fileName);
+
+	/// Records checksum of a file that was just written, so it will not be read again to compute it.
+	void update(QString const &fileName, QByteArray const &hash);
+
+	/// Forgets checksum of a file that was rewritten by other means, so it will be computed again when requested.
+	void invalidate(QString const &fileName);
+
+private:
+	/// Cached checksum along with file attributes it was computed for.
+	struct Entry {
+		qint64 size;
+		QDateTime lastModified;
+		QByteArray hash;
+
+		/// Time when the entry was stored.
+		QDateTime cachedAt;
+	};
+
+	/// Computes checksum of file contents reading it in blocks.
+	static QByteArray computeHash(QString const &fileName);
+
+	/// Maps absolute file path to its cached checksum.
+	QHash<QString, Entry> mEntries;
+
+	/// Guards mEntries.
+	QMutex mLock;
+};
+
+}
@@ -0,0 +1,117 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/fileUploader.h"
+
+#include <cstdio>
+
+#include <QtCore/QDebug>
+
+using namespace trikCommunicator;
+
+FileUploader::FileUploader()
+	: mHash(QCryptographicHash::Sha1)
+{
+}
+
+FileUploader::~FileUploader()
+{
+	abort();
+}
+
+bool FileUploader::start(QString const &fileName)
+{
+	abort();
+
+	mFile.setFileName(fileName + ".part");
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		qDebug() << "Failed to open file" << mFile.fileName() << "for writing";
+		return false;
+	}
+
+	mFileName = fileName;
+	mHash.reset();
+	return true;
+}
+
+bool FileUploader::write(QByteArray const &chunk)
+{
+	if (!isActive()) {
+		return false;
+	}
+
+	if (mFile.write(chunk) != chunk.size()) {
+		qDebug() << "Failed to write to" << mFile.fileName() << ":" << mFile.errorString();
+		abort();
+		return false;
+	}
+
+	mHash.addData(chunk);
+	return true;
+}
+
+bool FileUploader::finish(QByteArray const &checksum)
+{
+	if (!isActive()) {
+		return false;
+	}
+
+	mFile.close();
+
+	if (mHash.result().toHex() != checksum.trimmed().toLower()) {
+		qDebug() << "Checksum mismatch for uploaded file" << mFileName;
+		abort();
+		return false;
+	}
+
+	// std::rename atomically replaces existing file on POSIX systems. Where it can not replace existing file, remove
+	// it first, losing atomicity but not the upload.
+	QByteArray const source = QFile::encodeName(mFile.fileName());
+	QByteArray const target = QFile::encodeName(mFileName);
+	bool renamed = std::rename(source.constData(), target.constData()) == 0;
+	if (!renamed) {
+		renamed = QFile::remove(mFileName) && QFile::rename(mFile.fileName(), mFileName);
+	}
+
+	if (!renamed) {
+		qDebug() << "Failed to rename" << mFile.fileName() << "to" << mFileName;
+		abort();
+		return false;
+	}
+
+	mFileName.clear();
+	return true;
+}
+
+void FileUploader::abort()
+{
+	if (mFile.isOpen()) {
+		mFile.close();
+	}
+
+	if (isActive()) {
+		mFile.remove();
+		mFileName.clear();
+	}
+}
+
+bool FileUploader::isActive() const
+{
+	return !mFileName.isEmpty();
+}
+
+QString FileUploader::fileName() const
+{
+	return mFileName;
+}
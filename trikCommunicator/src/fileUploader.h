@@ -0,0 +1,69 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+namespace trikCommunicator {
+
+/// Receives a file in chunks and writes it to disk as they arrive, so memory consumption does not depend on file
+/// size. Data is written to a temporary "<file name>.part" file next to the target, SHA-1 checksum is computed on the
+/// fly, and when upload is finished and checksum matches the temporary file is renamed to the target one, so a
+/// partially uploaded file never replaces a good one.
+class FileUploader
+{
+public:
+	FileUploader();
+
+	~FileUploader();
+
+	/// Starts new upload, aborting the current one if any.
+	/// @param fileName - name of the file to write.
+	/// @returns false if temporary file can not be created.
+	bool start(QString const &fileName);
+
+	/// Appends a chunk to the file being uploaded.
+	/// @returns false if there is no upload in progress or write failed, upload is aborted in the latter case.
+	bool write(QByteArray const &chunk);
+
+	/// Finishes current upload.
+	/// @param checksum - hex encoded SHA-1 of file contents as computed by a client.
+	/// @returns true if checksum matches and file was successfully moved to its place.
+	bool finish(QByteArray const &checksum);
+
+	/// Aborts current upload and removes temporary file.
+	void abort();
+
+	/// Returns true if there is upload in progress.
+	bool isActive() const;
+
+	/// Returns name of the file being uploaded.
+	QString fileName() const;
+
+private:
+	/// Name of the file being uploaded, empty if there is no upload in progress.
+	QString mFileName;
+
+	/// Temporary file where uploaded data is written.
+	QFile mFile;
+
+	/// Checksum of data received so far.
+	QCryptographicHash mHash;
+};
+
+}
@@ -0,0 +1,131 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/protocolParser.h"
+
+using namespace trikCommunicator;
+
+/// Maximal number of digits in length prefix, longer numbers do not fit into int anyway.
+static int const maxLengthDigits = 9;
+
+ProtocolParser::ProtocolParser()
+	: mPosition(0)
+	, mExpectedLength(-1)
+	, mIsLastMessageFramed(false)
+	, mIsBroken(false)
+{
+}
+
+void ProtocolParser::append(QByteArray const &data)
+{
+	mBuffer.append(data);
+}
+
+bool ProtocolParser::takeMessage(QByteArray &message)
+{
+	if (mIsBroken) {
+		return false;
+	}
+
+	if (mExpectedLength < 0) {
+		if (mPosition == mBuffer.size()) {
+			return false;
+		}
+
+		switch (parseHeader()) {
+		case incomplete:
+			return false;
+		case tooLong:
+			// Data after an unacceptable header can not be parsed, so it is dropped along with the stream.
+			mIsBroken = true;
+			mBuffer.clear();
+			mPosition = 0;
+			return false;
+		case absent:
+			message = mBuffer.mid(mPosition);
+			mPosition = mBuffer.size();
+			mIsLastMessageFramed = false;
+			compact();
+			return true;
+		case complete:
+			break;
+		}
+	}
+
+	if (mBuffer.size() - mPosition < mExpectedLength) {
+		return false;
+	}
+
+	message = mBuffer.mid(mPosition, mExpectedLength);
+	mPosition += mExpectedLength;
+	mExpectedLength = -1;
+	mIsLastMessageFramed = true;
+	compact();
+	return true;
+}
+
+bool ProtocolParser::isBroken() const
+{
+	return mIsBroken;
+}
+
+bool ProtocolParser::isLastMessageFramed() const
+{
+	return mIsLastMessageFramed;
+}
+
+QByteArray ProtocolParser::frame(QByteArray const &payload)
+{
+	return QByteArray::number(payload.size()) + ':' + payload;
+}
+
+ProtocolParser::HeaderState ProtocolParser::parseHeader()
+{
+	int length = 0;
+	int digits = 0;
+	for (int i = mPosition; i < mBuffer.size(); ++i) {
+		char const c = mBuffer.at(i);
+		if (c >= '0' && c <= '9' && digits < maxLengthDigits) {
+			length = length * 10 + (c - '0');
+			++digits;
+			if (length > maxFrameSize) {
+				return tooLong;
+			}
+		} else if (c == ':' && digits > 0) {
+			mExpectedLength = length;
+			mPosition = i + 1;
+
+			// Make room for the whole message at once instead of growing buffer with every received packet, length is
+			// already checked against maxFrameSize.
+			compact();
+			mBuffer.reserve(mPosition + mExpectedLength);
+			return complete;
+		} else {
+			return absent;
+		}
+	}
+
+	return digits > 0 ? incomplete : absent;
+}
+
+void ProtocolParser::compact()
+{
+	if (mPosition == mBuffer.size()) {
+		mBuffer.resize(0);
+		mPosition = 0;
+	} else if (mPosition > mBuffer.size() / 2) {
+		mBuffer.remove(0, mPosition);
+		mPosition = 0;
+	}
+}
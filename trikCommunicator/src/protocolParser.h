@@ -0,0 +1,89 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+
+namespace trikCommunicator {
+
+/// Incremental parser of a stream of commands received by Connection. Two message formats are supported:
+/// - framed: <payload length in bytes as decimal number>:<payload>, for example "9:keepalive". Framed messages can be
+///   split between several network packets or sent back to back, parser extracts them exactly.
+/// - legacy text: command without length prefix. All data received so far is treated as one command, as it was
+///   before framing was introduced, so old clients that send one command at a time keep working.
+/// Received data is accumulated in one buffer that is compacted only when most of it is already consumed, and
+/// when length of a framed message is known, buffer is grown at once to hold the whole message. Framed messages
+/// longer than maxFrameSize are rejected, after that the stream is broken and shall be closed.
+class ProtocolParser
+{
+public:
+	/// Maximal payload length of a framed message in bytes.
+	static int const maxFrameSize = 4 * 1024 * 1024;
+
+	ProtocolParser();
+
+	/// Adds received data to the end of the stream.
+	void append(QByteArray const &data);
+
+	/// Extracts next complete message from the stream.
+	/// @param message - receives message payload.
+	/// @returns false if there is no complete message yet or the stream is broken.
+	bool takeMessage(QByteArray &message);
+
+	/// Returns true if a framed message longer than maxFrameSize was announced. Such stream can not be parsed further.
+	bool isBroken() const;
+
+	/// Returns true if the last message returned by takeMessage() was framed.
+	bool isLastMessageFramed() const;
+
+	/// Returns framed message with given payload.
+	static QByteArray frame(QByteArray const &payload);
+
+private:
+	/// Result of parsing a length prefix.
+	enum HeaderState {
+		/// Length prefix is parsed, mExpectedLength contains payload length.
+		complete
+
+		/// Only a part of length prefix is received.
+		, incomplete
+
+		/// Data at current position is not a length prefix.
+		, absent
+
+		/// Length prefix announces a message longer than maxFrameSize.
+		, tooLong
+	};
+
+	/// Parses length prefix at current position.
+	HeaderState parseHeader();
+
+	/// Drops consumed data from the beginning of the buffer if it takes most of the buffer.
+	void compact();
+
+	/// Received data, bytes before mPosition are already consumed.
+	QByteArray mBuffer;
+
+	/// Position of the first unconsumed byte in mBuffer.
+	int mPosition;
+
+	/// Payload length of a framed message whose length prefix is already consumed, -1 if there is no such message.
+	int mExpectedLength;
+
+	bool mIsLastMessageFramed;
+	bool mIsBroken;
+};
+
+}
@@ -0,0 +1,74 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/telemetryEncoder.h"
+
+using namespace trikCommunicator;
+
+TelemetryEncoder::TelemetryEncoder(int keyFrameInterval)
+	: mKeyFrameInterval(keyFrameInterval)
+	, mFramesSinceKeyFrame(0)
+{
+}
+
+QByteArray TelemetryEncoder::encode(quint32 sequence, QVector<int> const &sample)
+{
+	QByteArray frame("telemetry:");
+	bool const isKeyFrame = mPrevious.size() != sample.size() || mFramesSinceKeyFrame >= mKeyFrameInterval;
+	frame.append(isKeyFrame ? 'K' : 'D');
+	writeVarint(frame, sequence);
+
+	if (isKeyFrame) {
+		writeVarint(frame, sample.size());
+		for (int const value : sample) {
+			writeVarint(frame, zigzag(value));
+		}
+
+		mFramesSinceKeyFrame = 0;
+	} else {
+		quint32 mask = 0;
+		for (int i = 0; i < sample.size(); ++i) {
+			if (sample[i] != mPrevious[i]) {
+				mask |= 1u << i;
+			}
+		}
+
+		writeVarint(frame, mask);
+		for (int i = 0; i < sample.size(); ++i) {
+			if (mask & (1u << i)) {
+				writeVarint(frame, zigzag(sample[i] - mPrevious[i]));
+			}
+		}
+
+		++mFramesSinceKeyFrame;
+	}
+
+	mPrevious = sample;
+	return frame;
+}
+
+void TelemetryEncoder::writeVarint(QByteArray &out, quint32 value)
+{
+	while (value >= 0x80) {
+		out.append(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+
+	out.append(static_cast<char>(value));
+}
+
+quint32 TelemetryEncoder::zigzag(int value)
+{
+	return (static_cast<quint32>(value) << 1) ^ static_cast<quint32>(value >> 31);
+}
@@ -0,0 +1,60 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+
+namespace trikCommunicator {
+
+/// Encodes telemetry samples into compact binary frames. Each frame starts with "telemetry:" followed by:
+/// - frame type byte, 'K' for key frame or 'D' for delta frame;
+/// - sequence number of a sample as varint, gaps in sequence mean that samples were dropped;
+/// - for key frame: number of channels as varint, then values of all channels;
+/// - for delta frame: bit mask of changed channels as varint, then differences with previous frame for changed
+///   channels only.
+/// Values and differences are zigzag encoded varints (protobuf style), so small numbers take one byte. Deltas are
+/// computed relative to the previous encoded frame, so every encoded frame shall be delivered to a client.
+class TelemetryEncoder
+{
+public:
+	/// Maximal number of channels, limited by the size of a change mask.
+	static int const maxChannels = 32;
+
+	/// Constructor.
+	/// @param keyFrameInterval - number of frames after which key frame is sent, so a client that has missed
+	///        something can resynchronize.
+	explicit TelemetryEncoder(int keyFrameInterval);
+
+	/// Encodes a sample as key frame or as difference with previously encoded sample.
+	QByteArray encode(quint32 sequence, QVector<int> const &sample);
+
+private:
+	/// Appends unsigned value in base 128 varint encoding.
+	static void writeVarint(QByteArray &out, quint32 value);
+
+	/// Maps signed integers to unsigned ones so that numbers with small absolute value have small codes.
+	static quint32 zigzag(int value);
+
+	/// Previously encoded sample.
+	QVector<int> mPrevious;
+
+	int const mKeyFrameInterval;
+
+	/// Number of frames encoded since last key frame.
+	int mFramesSinceKeyFrame;
+};
+
+}
@@ -0,0 +1,99 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/telemetryStream.h"
+
+#include <QtNetwork/QTcpSocket>
+
+#include <trikControl/brick.h>
+#include <trikKernel/metricsRegistry.h>
+
+#include "src/protocolParser.h"
+
+using namespace trikCommunicator;
+
+/// Maximal number of samples waiting to be written, older ones are dropped.
+static int const maxPendingSamples = 8;
+
+/// Samples are not written while socket has more than this number of bytes not sent yet.
+static qint64 const maxBufferedBytes = 4096;
+
+/// Every this number of frames a key frame is sent instead of a delta frame.
+static int const keyFrameInterval = 50;
+
+TelemetryStream::TelemetryStream(QTcpSocket &socket, QList<Channel> const &channels, int rate)
+	: mSocket(socket)
+	, mChannels(channels)
+	, mEncoder(keyFrameInterval)
+	, mSequence(0)
+{
+	connect(&mTimer, SIGNAL(timeout()), this, SLOT(sample()));
+	connect(&mSocket, SIGNAL(bytesWritten(qint64)), this, SLOT(flush()));
+
+	mTimer.setInterval(1000 / rate);
+	mTimer.start();
+}
+
+TelemetryStream::Channel TelemetryStream::channel(trikControl::Brick &brick, QString const &port)
+{
+	if (port == "battery") {
+		trikControl::Battery * const battery = brick.battery();
+		if (!battery) {
+			return Channel();
+		}
+
+		return [battery]() { return static_cast<int>(battery->readVoltage() * 1000); };
+	}
+
+	if (trikControl::Encoder * const encoder = brick.encoder(port)) {
+		return [encoder]() { return encoder->read(); };
+	}
+
+	if (trikControl::Motor * const motor = brick.motor(port)) {
+		return [motor]() { return motor->power(); };
+	}
+
+	if (trikControl::Sensor * const sensor = brick.sensor(port)) {
+		return [sensor]() { return sensor->read(); };
+	}
+
+	return Channel();
+}
+
+void TelemetryStream::sample()
+{
+	static trikKernel::Counter &dropped = trikKernel::MetricsRegistry::counter("communicator.telemetryDropped");
+
+	QVector<int> values;
+	values.reserve(mChannels.size());
+	for (Channel const &channel : mChannels) {
+		values << channel();
+	}
+
+	if (mPending.size() >= maxPendingSamples) {
+		mPending.dequeue();
+		dropped.increment();
+	}
+
+	mPending.enqueue(qMakePair(mSequence++, values));
+	flush();
+}
+
+void TelemetryStream::flush()
+{
+	while (!mPending.isEmpty() && mSocket.bytesToWrite() < maxBufferedBytes) {
+		QPair<quint32, QVector<int>> const sample = mPending.dequeue();
+		mSocket.write(ProtocolParser::frame(mEncoder.encode(sample.first, sample.second)));
+	}
+}
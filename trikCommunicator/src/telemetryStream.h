@@ -0,0 +1,80 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QQueue>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include "src/telemetryEncoder.h"
+
+class QTcpSocket;
+
+namespace trikControl {
+class Brick;
+}
+
+namespace trikCommunicator {
+
+/// Periodically samples values of robot devices and pushes them to a client as binary frames encoded by
+/// TelemetryEncoder. Devices are read directly through trikControl, without script engine. If a client does not
+/// keep up, samples are queued up to a small limit and then the oldest ones are dropped, so a client always gets
+/// recent values and memory consumption stays bounded.
+class TelemetryStream : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Function that reads current value of one channel.
+	typedef std::function<int()> Channel;
+
+	/// Constructor.
+	/// @param socket - socket of a client to which frames are written.
+	/// @param channels - channels to sample, values are sent in the same order.
+	/// @param rate - sampling rate in Hz.
+	TelemetryStream(QTcpSocket &socket, QList<Channel> const &channels, int rate);
+
+	/// Returns channel that reads given port of a brick, or empty function if there is no such port. Supported are
+	/// sensor ports, encoder ports, motor ports (currently set power is sent) and "battery" (voltage in millivolts).
+	static Channel channel(trikControl::Brick &brick, QString const &port);
+
+private slots:
+	/// Reads all channels and queues a sample.
+	void sample();
+
+	/// Writes queued samples while socket output buffer is not too full.
+	void flush();
+
+private:
+	QTcpSocket &mSocket;
+	QList<Channel> const mChannels;
+	QTimer mTimer;
+
+	/// Samples not written to a socket yet along with their sequence numbers.
+	QQueue<QPair<quint32, QVector<int>>> mPending;
+
+	TelemetryEncoder mEncoder;
+
+	/// Sequence number of the next sample.
+	quint32 mSequence;
+};
+
+}
@@ -17,44 +17,65 @@
 #include <QtCore/QFile>
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QSet>
 
 #include <trikScriptRunner/trikScriptRunner.h>
 
 #include "src/connection.h"
+#include "src/fileHashCache.h"
 
 using namespace trikCommunicator;
 
 TrikCommunicator::TrikCommunicator(trikControl::Brick &brick, QString const &startDirPath)
 	: mTrikScriptRunner(new trikScriptRunner::TrikScriptRunner(brick, startDirPath))
 	, mHasScriptRunnerOwnership(true)
+	, mBrick(brick)
+	, mHashCache(new FileHashCache())
+	, mSingleThreaded(false)
 {
 	init();
 }
 
-TrikCommunicator::TrikCommunicator(trikScriptRunner::TrikScriptRunner &runner)
+TrikCommunicator::TrikCommunicator(trikScriptRunner::TrikScriptRunner &runner, trikControl::Brick &brick)
 	: mTrikScriptRunner(&runner)
 	, mHasScriptRunnerOwnership(false)
+	, mBrick(brick)
+	, mHashCache(new FileHashCache())
+	, mSingleThreaded(false)
 {
 	init();
 }
 
 TrikCommunicator::~TrikCommunicator()
 {
-	foreach (QThread *thread, mConnections.keys()) {
+	QSet<QThread *> threads = QSet<QThread *>::fromList(mConnections.values());
+	if (mConnectionsThread) {
+		threads.insert(mConnectionsThread.data());
+	}
+
+	for (QThread * const thread : threads) {
 		thread->quit();
 		if (!thread->wait(1000)) {
 			qDebug() << "Unable to stop thread" << thread;
 		}
 	}
 
-	qDeleteAll(mConnections);
 	qDeleteAll(mConnections.keys());
 
+	// Shared thread is owned by mConnectionsThread, own threads of connections are deleted here.
+	threads.remove(mConnectionsThread.data());
+	qDeleteAll(threads);
+
 	if (mHasScriptRunnerOwnership) {
 		delete mTrikScriptRunner;
 	}
 }
 
+void TrikCommunicator::setSingleThreaded(bool singleThreaded)
+{
+	mSingleThreaded = singleThreaded;
+}
+
 void TrikCommunicator::startServer(int const &port)
 {
 	if (!listen(QHostAddress::Any, port)) {
@@ -66,7 +87,7 @@ void TrikCommunicator::startServer(int const &port)
 
 void TrikCommunicator::sendMessage(QString const &message)
 {
-	for (Connection * const connection : mConnections.values()) {
+	for (Connection * const connection : mConnections.keys()) {
 		connection->sendMessage(message);
 	}
 }
@@ -75,21 +96,32 @@ void TrikCommunicator::incomingConnection(int socketDescriptor)
 {
 	qDebug() << "New connection, socket descriptor: " << socketDescriptor;
 
-	QThread * const connectionThread = new QThread();
+	QThread *connectionThread = nullptr;
+	if (mSingleThreaded) {
+		if (!mConnectionsThread) {
+			mConnectionsThread.reset(new QThread());
+			mConnectionsThread->start();
+		}
 
-	connect(connectionThread, SIGNAL(finished()), connectionThread, SLOT(deleteLater()));
-	connect(connectionThread, SIGNAL(finished()), this, SLOT(onConnectionClosed()));
+		connectionThread = mConnectionsThread.data();
+	} else {
+		connectionThread = new QThread();
+		connect(connectionThread, SIGNAL(finished()), connectionThread, SLOT(deleteLater()));
+	}
 
-	Connection * const connectionWorker = new Connection();
+	Connection * const connectionWorker = new Connection(*mHashCache, mBrick);
 
 	connect(connectionWorker, SIGNAL(startedDirectScript()), this, SIGNAL(startedDirectScript()));
 	connect(connectionWorker, SIGNAL(startedScript(QString)), this, SIGNAL(startedScript(QString)));
+	connect(connectionWorker, SIGNAL(closed()), this, SLOT(onConnectionClosed()));
 
 	connectionWorker->moveToThread(connectionThread);
 
-	mConnections.insert(connectionThread, connectionWorker);
+	mConnections.insert(connectionWorker, connectionThread);
 
-	connectionThread->start();
+	if (!connectionThread->isRunning()) {
+		connectionThread->start();
+	}
 
 	QMetaObject::invokeMethod(connectionWorker, "init", Q_ARG(int, socketDescriptor)
 			, Q_ARG(trikScriptRunner::TrikScriptRunner *, mTrikScriptRunner));
@@ -97,12 +129,18 @@ void TrikCommunicator::incomingConnection(int socketDescriptor)
 
 void TrikCommunicator::onConnectionClosed()
 {
-	QThread * const thread = static_cast<QThread *>(sender());
-
-	// Thread shall already be finished here.
-	delete mConnections.value(thread);
+	Connection * const connection = static_cast<Connection *>(sender());
+	QThread * const thread = mConnections.take(connection);
+	if (!thread) {
+		return;
+	}
 
-	mConnections.remove(thread);
+	// Connection is deleted in its own thread. Own thread of a connection deletes itself when finished, and it
+	// processes pending deferred deletes before finishing.
+	connection->deleteLater();
+	if (thread != mConnectionsThread.data()) {
+		thread->quit();
+	}
 }
 
 void TrikCommunicator::init()
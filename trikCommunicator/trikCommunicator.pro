@@ -17,10 +17,20 @@ include(../global.pri)
 HEADERS += \
 	$$PWD/include/trikCommunicator/trikCommunicator.h \
 	$$PWD/src/connection.h \
+	$$PWD/src/fileHashCache.h \
+	$$PWD/src/fileUploader.h \
+	$$PWD/src/protocolParser.h \
+	$$PWD/src/telemetryEncoder.h \
+	$$PWD/src/telemetryStream.h \
 
 SOURCES += \
 	$$PWD/src/trikCommunicator.cpp \
 	$$PWD/src/connection.cpp \
+	$$PWD/src/fileHashCache.cpp \
+	$$PWD/src/fileUploader.cpp \
+	$$PWD/src/protocolParser.cpp \
+	$$PWD/src/telemetryEncoder.cpp \
+	$$PWD/src/telemetryStream.cpp \
 
 TEMPLATE = lib
 
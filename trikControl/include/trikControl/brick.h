@@ -41,6 +41,7 @@
 namespace trikControl {
 
 class Configurer;
+class DeviceBackendInterface;
 class I2cCommunicator;
 class PowerMotor;
 class ServoMotor;
@@ -179,6 +180,7 @@ private:
 	QHash<QString, DigitalSensor *> mDigitalSensors;  // Has ownership.
 
 	Configurer const * const mConfigurer;  // Has ownership.
+	DeviceBackendInterface *mDeviceBackend = nullptr;  // Has ownership.
 	I2cCommunicator *mI2cCommunicator = nullptr;  // Has ownership.
 	Display mDisplay;
 	Led *mLed = nullptr;  // Has ownership.
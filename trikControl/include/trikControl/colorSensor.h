@@ -25,6 +25,7 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
 class ColorSensorWorker;
 
 class TRIKCONTROL_EXPORT ColorSensor : public QObject
@@ -33,12 +34,14 @@ class TRIKCONTROL_EXPORT ColorSensor : public QObject
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides connection to a sensor.
 	/// @param script - file name of a scrit used to start or stop a sensor.
 	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
 	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
 	/// @param m - horisontal dimension of a sensor.
 	/// @param n - vertical dimension of a sensor.
-	ColorSensor(QString const &script, QString const &inputFile, QString const &outputFile, int m, int n);
+	ColorSensor(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+			, QString const &outputFile, int m, int n);
 
 	~ColorSensor();
 
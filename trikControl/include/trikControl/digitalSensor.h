@@ -16,14 +16,16 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
-#include <QtCore/QFile>
-#include <QtCore/QTextStream>
+#include <QtCore/QScopedPointer>
 
 #include "declSpec.h"
 #include "sensor.h"
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+class DeviceFileInterface;
+
 /// Generic TRIK sensor.
 class TRIKCONTROL_EXPORT DigitalSensor : public Sensor
 {
@@ -31,10 +33,13 @@ class TRIKCONTROL_EXPORT DigitalSensor : public Sensor
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to device file.
 	/// @param min - minimal actual (physical) value returned by sensor. Used to normalize returned values.
 	/// @param max - maximal actual (physical) value returned by sensor. Used to normalize returned values.
 	/// @param deviceFile - device file for this sensor.
-	DigitalSensor(int min, int max, QString const &deviceFile);
+	DigitalSensor(DeviceBackendInterface &backend, int min, int max, QString const &deviceFile);
+
+	~DigitalSensor() override;
 
 public slots:
 	/// Returns current raw reading of a sensor.
@@ -43,8 +48,7 @@ public slots:
 private:
 	int mMin;
 	int mMax;
-	QFile mDeviceFile;
-	QTextStream mStream;
+	QScopedPointer<DeviceFileInterface> mDeviceFile;
 };
 
 }
@@ -14,14 +14,19 @@
 
 #pragma once
 
+#include <QtCore/QMutex>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QThread>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
 
 #include "declSpec.h"
 
 namespace trikControl {
 
-class GuiWorker;
+class AbstractDisplayWorker;
+class DrawCommandBuffer;
 
 /// Provides ability to draw something on robot display.
 class TRIKCONTROL_EXPORT Display : public QObject
@@ -32,7 +37,11 @@ public:
 	/// Constructor.
 	/// @param guiThread - GUI thread of an application.
 	/// @param startDirPath - path to the directory from which the application was executed.
-	explicit Display(QThread &guiThread, QString const &startDirPath);
+	/// @param renderer - "widget" to draw using Qt widgets, "framebuffer" to draw directly into a framebuffer device,
+	///        "memory" to draw into in-memory framebuffer, for testing and benchmarking.
+	/// @param framebufferDevice - framebuffer device file used by "framebuffer" renderer.
+	Display(QThread &guiThread, QString const &startDirPath, QString const &renderer = "widget"
+			, QString const &framebufferDevice = "/dev/fb0");
 
 	~Display();
 
@@ -42,6 +51,33 @@ public slots:
 	/// supported formats, but .jpg, .png, .bmp, .gif are supported.
 	void showImage(QString const &fileName);
 
+	/// Decodes image in background so that later showImage() with the same file will show it without delay.
+	/// @param fileName - file name (with path) of an image.
+	void preloadImage(QString const &fileName);
+
+	/// Loads animation consisting of a sequence of images. Frames are decoded in background, so animation can be
+	/// loaded in advance and played later without delays.
+	/// @param fileNames - array of file names (with path) of frames.
+	void loadAnimation(QStringList const &fileNames);
+
+	/// Loads animation from a sprite sheet, an image with frames of equal size placed left to right, top to bottom.
+	/// @param fileName - file name (with path) of a sprite sheet.
+	/// @param frameWidth - width of a frame.
+	/// @param frameHeight - height of a frame.
+	void loadSpriteSheet(QString const &fileName, int frameWidth, int frameHeight);
+
+	/// Sets animation playback speed.
+	/// @param fps - frames per second.
+	void setAnimationFps(double fps);
+
+	/// Starts playback of loaded animation from the first frame. Animation is played independently of a script,
+	/// if it is not loaded yet, playback starts when loading finishes. Showing an image stops animation.
+	/// @param loop - true if animation shall be repeated until stopAnimation() is called.
+	void playAnimation(bool loop = false);
+
+	/// Stops animation playback, current frame stays on the screen.
+	void stopAnimation();
+
 	/// Add a label to the specific position of the screen. If there already is a label in these coordinates, its
 	/// contents will be updated.
 	/// @param text - label text.
@@ -96,6 +132,21 @@ public slots:
 	/// @param spanAngle - end andle.
 	void drawArc(int x, int y, int width, int height, int startAngle, int spanAngle);
 
+	/// Draw lines connecting consecutive points.
+	/// @param coordinates - array of point coordinates in the form [x0, y0, x1, y1, ...].
+	void drawPolyline(QVector<int> const &coordinates);
+
+	/// Draw a set of points.
+	/// @param coordinates - array of point coordinates in the form [x0, y0, x1, y1, ...].
+	void drawPoints(QVector<int> const &coordinates);
+
+	/// Starts a frame. Until endFrame() is called, drawing, painter settings, images, labels, background and hiding
+	/// are not sent to a display one by one but are recorded and then shown all at once.
+	void beginFrame();
+
+	/// Ends a frame and draws everything recorded since beginFrame().
+	void endFrame();
+
 	/// Shortcut to showImage, shows sad smile.
 	void sadSmile();
 
@@ -110,9 +161,21 @@ public slots:
 	void clear();
 
 private:
+	/// Creates worker for given renderer.
+	static AbstractDisplayWorker *createWorker(QString const &renderer, QString const &framebufferDevice);
+
 	QThread &mGuiThread;
 	QString const mStartDirPath;
-	GuiWorker *mGuiWorker;  // Has ownership.
+	AbstractDisplayWorker *mGuiWorker;  // Has ownership.
+
+	/// Commands recorded in current frame or polyline being sent.
+	QScopedPointer<DrawCommandBuffer> mFrame;
+
+	/// True between beginFrame() and endFrame().
+	bool mInFrame;
+
+	/// Guards mFrame and mInFrame, since display can be used by several script threads.
+	QMutex mFrameLock;
 };
 
 }
@@ -17,26 +17,29 @@
 #include <QtCore/QObject>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QThread>
-#include <QtCore/QHash>
-#include <QtCore/QSet>
+#include <QtCore/QVector>
 
 #include "declSpec.h"
 
 namespace trikControl {
 
-class TcpConnector;
+class AbstractConnector;
+class GamepadState;
 
-/// Class to support remote control of a robot using TCP client.
+/// Class to support remote control of a robot using TCP or UDP client. Commands are received in network thread,
+/// state of pads and buttons can be safely read from any thread.
 class TRIKCONTROL_EXPORT Gamepad : public QObject
 {
 	Q_OBJECT
 
 public:
 	/// Constructor.
-	/// @param port - TCP port of a gamepad server.
-	Gamepad(int port);
+	/// @param port - TCP or UDP port of a gamepad server.
+	/// @param transport - "tcp" for text commands over TCP connection or "udp" for datagrams with sequence numbers,
+	///        see UdpConnector.
+	Gamepad(int port, QString const &transport = "tcp");
 
-	/// Destructor declared here for QScopedPointer to be able to clean up forward-declared TcpConnector.
+	/// Destructor declared here for QScopedPointer to be able to clean up forward-declared AbstractConnector.
 	virtual ~Gamepad();
 
 public slots:
@@ -55,6 +58,10 @@ public slots:
 	/// Returns current Y coordinate of given pad or -1 if this pad is not pressed.
 	int padY(int pad);
 
+	/// Returns current state of given pad as array of X coordinate, Y coordinate and 1 if pad is pressed or 0 if not,
+	/// all taken from one update. Coordinates are -1 if pad is not pressed.
+	QVector<int> padState(int pad);
+
 signals:
 	/// @todo ??!
 	void padUp(int pad);
@@ -68,17 +75,11 @@ private slots:
 private:
 	Q_DISABLE_COPY(Gamepad)
 
-	struct PadStatus {
-		int x;
-		int y;
-		bool isPressed;
-	};
-
-	QScopedPointer<TcpConnector> mListener;
+	QScopedPointer<AbstractConnector> mListener;
 	QThread mNetworkThread;
 
-	QSet<int> mButtonWasPressed;
-	QHash<int, PadStatus> mPads;
+	/// State of pads and buttons, written by parse() and read by scripts.
+	QScopedPointer<GamepadState> mState;
 };
 
 }
@@ -17,11 +17,13 @@
 #include <QtCore/QObject>
 #include <QtCore/QThread>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QVector>
 
 #include "declSpec.h"
 
 namespace trikControl {
 
+class DeviceBackendInterface;
 class KeysWorker;
 
 /// Class for handling keys on a brick.
@@ -31,8 +33,9 @@ class TRIKCONTROL_EXPORT Keys : public QObject
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to input device.
 	/// @param keysPath - path to device file that controls brick keys.
-	Keys(QString const &keysPath);
+	Keys(DeviceBackendInterface &backend, QString const &keysPath);
 
 	~Keys();
 
@@ -43,12 +46,32 @@ public slots:
 	/// Returns true, if button with given code was pressed, and clears "pressed" state for that button.
 	bool wasPressed(int code);
 
+	/// Returns true if button with given code is pressed now.
+	bool isPressed(int code);
+
+	/// Returns time in milliseconds for which button with given code is held, or 0 if it is not pressed.
+	int pressDuration(int code);
+
 signals:
 	/// Triggered when button state changed (pressed or released).
 	/// @param code - key code.
 	/// @param value - key state.
 	void buttonPressed(int code, int value);
 
+	/// Triggered when button is released.
+	/// @param code - key code.
+	/// @param duration - time in milliseconds for which button was held, measured by input event timestamps.
+	void released(int code, int duration);
+
+	/// Triggered once per press when button is held long enough (0.8 seconds).
+	/// @param code - key code.
+	void longPressed(int code);
+
+	/// Triggered when a button is pressed while other buttons, pressed not earlier than 0.3 seconds before it, are
+	/// still held.
+	/// @param codes - sorted codes of all buttons in a chord.
+	void chordPressed(QVector<int> const &codes);
+
 private:
 	QScopedPointer<KeysWorker> mKeysWorker;
 	QThread mWorkerThread;
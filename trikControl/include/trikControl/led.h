@@ -16,12 +16,15 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
-#include <QtCore/QFile>
+#include <QtCore/QScopedPointer>
 
 #include "declSpec.h"
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+class DeviceFileInterface;
+
 /// Controls light-emitting diode on control brick.
 class TRIKCONTROL_EXPORT Led : public QObject
 {
@@ -29,7 +32,8 @@ class TRIKCONTROL_EXPORT Led : public QObject
 
 public:
 	/// Constructor.
-	Led(QString const &redDeviceFile, QString const &greenDeviceFile, int on, int off);
+	/// @param backend - device backend that provides access to device files.
+	Led(DeviceBackendInterface &backend, QString const &redDeviceFile, QString const &greenDeviceFile, int on, int off);
 
 	~Led();
 
@@ -47,8 +51,8 @@ public slots:
 	void off();
 
 private:
-	QFile mRedDeviceFile;
-	QFile mGreenDeviceFile;
+	QScopedPointer<DeviceFileInterface> mRedDeviceFile;
+	QScopedPointer<DeviceFileInterface> mGreenDeviceFile;
 	int mOn;
 	int mOff;
 };
@@ -25,6 +25,7 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
 class LineSensorWorker;
 
 /// Uses virtual line sensor to detect x coordinate of a center of an object that was in camera's field of view
@@ -35,12 +36,14 @@ class TRIKCONTROL_EXPORT LineSensor : public QObject
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides connection to a sensor.
 	/// @param script - file name of a scrit used to start or stop a sensor.
 	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
 	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
 	/// @param toleranceFactor - a value on which hueTolerance, saturationTolerance and valueTolerance is multiplied
 	///        after "detect" command. Higher values allow to count more points on an image as tracked object.
-	LineSensor(QString const &script, QString const &inputFile, QString const &outputFile, double toleranceFactor);
+	LineSensor(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+			, QString const &outputFile, double toleranceFactor);
 
 	~LineSensor();
 
@@ -15,13 +15,16 @@
 #pragma once
 
 #include <QtCore/QObject>
-#include <QtCore/QFile>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QVector>
 
 #include "declSpec.h"
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+class DeviceFileInterface;
+
 /// Provides characteristics of PWM signal supplied to the port.
 class TRIKCONTROL_EXPORT PwmCapture : public QObject
 {
@@ -29,9 +32,10 @@ class TRIKCONTROL_EXPORT PwmCapture : public QObject
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to device files.
 	/// @param frequencyFile - device file with frequency.
 	/// @param dutyFile - device file with duty.
-	PwmCapture(QString const &frequencyFile, QString const &dutyFile);
+	PwmCapture(DeviceBackendInterface &backend, QString const &frequencyFile, QString const &dutyFile);
 
 	/// Destructor.
 	~PwmCapture();
@@ -45,8 +49,8 @@ public slots:
 	int duty();
 
 private:
-	QFile mFrequencyFile;
-	QFile mDutyFile;
+	QScopedPointer<DeviceFileInterface> mFrequencyFile;
+	QScopedPointer<DeviceFileInterface> mDutyFile;
 };
 
 }
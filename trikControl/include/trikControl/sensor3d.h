@@ -23,6 +23,7 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
 class Sensor3dWorker;
 
 /// Sensor that returns 3d vector.
@@ -32,10 +33,11 @@ class TRIKCONTROL_EXPORT Sensor3d : public QObject
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to input device.
 	/// @param min - minimal actual (physical) value returned by sensor. Used to normalize returned values.
 	/// @param max - maximal actual (physical) value returned by sensor. Used to normalize returned values.
 	/// @param deviceFile - device file for this sensor.
-	Sensor3d(int min, int max, QString const &deviceFile);
+	Sensor3d(DeviceBackendInterface &backend, int min, int max, QString const &deviceFile);
 
 	~Sensor3d();
 
@@ -0,0 +1,39 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+namespace trikControl {
+
+/// Base class for network transports that receive gamepad commands. Works in separate network thread.
+class AbstractConnector : public QObject
+{
+	Q_OBJECT
+
+public:
+	~AbstractConnector() override {}
+
+signals:
+	/// Emitted for every received command, commands are in text format like "pad 1 10 20".
+	void dataReady(QString const &message);
+
+public slots:
+	/// Starts a server and begins listening port for incoming data.
+	virtual void startServer() = 0;
+};
+
+}
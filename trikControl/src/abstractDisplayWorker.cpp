@@ -0,0 +1,189 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "abstractDisplayWorker.h"
+
+#include "animationPlayer.h"
+#include "drawCommandBuffer.h"
+#include "imageCache.h"
+
+using namespace trikControl;
+
+/// Maximal total size of decoded images in cache, in bytes. Fits more than a hundred of full screen images.
+static int const imageCacheCapacity = 32 * 1024 * 1024;
+
+AbstractDisplayWorker::AbstractDisplayWorker()
+	: mImageCache(new ImageCache(imageCacheCapacity, this))
+	, mAnimationPlayer(new AnimationPlayer(this))
+{
+	connect(mImageCache, SIGNAL(imageLoaded(QString,QImage)), this, SLOT(onImageLoaded(QString,QImage)));
+	connect(mAnimationPlayer, SIGNAL(frameChanged(QImage)), this, SLOT(onAnimationFrame(QImage)));
+}
+
+AbstractDisplayWorker::~AbstractDisplayWorker()
+{
+	qDeleteAll(mPendingFrames);
+	qDeleteAll(mFreeFrames);
+}
+
+void AbstractDisplayWorker::submitFrame(DrawCommandBuffer &frame)
+{
+	if (frame.isEmpty()) {
+		return;
+	}
+
+	{
+		QMutexLocker locker(&mFramesLock);
+		DrawCommandBuffer * const buffer = mFreeFrames.isEmpty() ? new DrawCommandBuffer() : mFreeFrames.takeLast();
+		buffer->swap(frame);
+		mPendingFrames.enqueue(buffer);
+	}
+
+	QMetaObject::invokeMethod(this, "drawPendingFrame", Qt::QueuedConnection);
+}
+
+void AbstractDisplayWorker::drawPendingFrame()
+{
+	DrawCommandBuffer *frame = nullptr;
+	{
+		QMutexLocker locker(&mFramesLock);
+		if (mPendingFrames.isEmpty()) {
+			return;
+		}
+
+		frame = mPendingFrames.dequeue();
+	}
+
+	drawFrame(*frame);
+	frame->clear();
+
+	QMutexLocker locker(&mFramesLock);
+	mFreeFrames.append(frame);
+}
+
+void AbstractDisplayWorker::showImage(QString const &fileName)
+{
+	mAnimationPlayer->stop();
+	QImage const image = mImageCache->image(fileName);
+	if (image.isNull()) {
+		mPendingImage = fileName;
+	} else {
+		mPendingImage.clear();
+		setImage(image);
+	}
+}
+
+void AbstractDisplayWorker::preloadImage(QString const &fileName)
+{
+	mImageCache->preload(fileName);
+}
+
+void AbstractDisplayWorker::onImageLoaded(QString const &fileName, QImage const &image)
+{
+	if (fileName == mPendingImage) {
+		mPendingImage.clear();
+		setImage(image);
+	}
+}
+
+void AbstractDisplayWorker::loadAnimation(QStringList const &fileNames)
+{
+	mAnimationPlayer->loadFrames(fileNames);
+}
+
+void AbstractDisplayWorker::loadSpriteSheet(QString const &fileName, int frameWidth, int frameHeight)
+{
+	mAnimationPlayer->loadSpriteSheet(fileName, frameWidth, frameHeight);
+}
+
+void AbstractDisplayWorker::setAnimationFps(double fps)
+{
+	mAnimationPlayer->setFps(fps);
+}
+
+void AbstractDisplayWorker::playAnimation(bool loop)
+{
+	// Animation replaces image that is still being decoded.
+	mPendingImage.clear();
+	mAnimationPlayer->play(loop);
+}
+
+void AbstractDisplayWorker::stopAnimation()
+{
+	mAnimationPlayer->stop();
+}
+
+void AbstractDisplayWorker::onAnimationFrame(QImage const &frame)
+{
+	setImage(frame);
+}
+
+void AbstractDisplayWorker::clearImage()
+{
+	mAnimationPlayer->stop();
+	mPendingImage.clear();
+	setImage(QImage());
+}
+
+void AbstractDisplayWorker::setImageSize(QSize const &size)
+{
+	mImageCache->setTargetSize(size);
+	mAnimationPlayer->setTargetSize(size);
+}
+
+void AbstractDisplayWorker::deleteWorker()
+{
+	deleteLater();
+}
+
+QColor AbstractDisplayWorker::backgroundColor(QString const &color)
+{
+	if (color == tr("white")) {
+		return Qt::white;
+	} else if (color == tr("black")) {
+		return Qt::black;
+	} else if (color == tr("red")) {
+		return Qt::red;
+	} else if (color == tr("darkRed")) {
+		return Qt::darkRed;
+	} else if (color == tr("green")) {
+		return Qt::green;
+	} else if (color == tr("darkGreen")) {
+		return Qt::darkGreen;
+	} else if (color == tr("blue")) {
+		return Qt::blue;
+	} else if (color == tr("darkBlue")) {
+		return Qt::darkBlue;
+	} else if (color == tr("cyan")) {
+		return Qt::cyan;
+	} else if (color == tr("darkCyan")) {
+		return Qt::darkCyan;
+	} else if (color == tr("magenta")) {
+		return Qt::magenta;
+	} else if (color == tr("darkMagenta")) {
+		return Qt::darkMagenta;
+	} else if (color == tr("yellow")) {
+		return Qt::yellow;
+	} else if (color == tr("darkYellow")) {
+		return Qt::darkYellow;
+	} else if (color == tr("gray")) {
+		return Qt::gray;
+	} else if (color == tr("darkGray")) {
+		return Qt::darkGray;
+	} else if (color == tr("lightGray")) {
+		return Qt::lightGray;
+	} else {
+		return QColor(color);
+	}
+}
@@ -0,0 +1,187 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtGui/QColor>
+#include <QtGui/QImage>
+
+namespace trikControl {
+
+class AnimationPlayer;
+class DrawCommandBuffer;
+class ImageCache;
+
+/// Base class for workers that live in GUI thread and are responsible for all output to display. Display calls slots
+/// of a worker by name through queued connections, descendants implement actual rendering.
+class AbstractDisplayWorker : public QObject
+{
+	Q_OBJECT
+
+public:
+	AbstractDisplayWorker();
+
+	~AbstractDisplayWorker() override;
+
+	/// Passes frame recorded on a script side to GUI thread. Contents of a frame are taken by swapping with
+	/// preallocated buffer of already drawn frame, so given frame becomes empty. Frames are drawn in order of
+	/// submission, in the same event queue as other slots of the worker. Can be called from any thread.
+	void submitFrame(DrawCommandBuffer &frame);
+
+public slots:
+	/// Initializes worker. Shall be called when worker is moved to correct thread. Not supposed to be called from .qts.
+	virtual void init() = 0;
+
+	/// Shows image with given filename on display. Image is scaled to fill the screen and is cached for better
+	/// performance. If image is not in cache yet, it is decoded in background and shown when ready, previous image
+	/// stays on the screen meanwhile.
+	void showImage(QString const &fileName);
+
+	/// Decodes image in background and puts it into cache, so later showImage() will show it without delay.
+	void preloadImage(QString const &fileName);
+
+	/// Loads animation consisting of a sequence of image files.
+	void loadAnimation(QStringList const &fileNames);
+
+	/// Loads animation from a sprite sheet with frames of given size placed left to right, top to bottom.
+	void loadSpriteSheet(QString const &fileName, int frameWidth, int frameHeight);
+
+	/// Sets animation playback speed in frames per second.
+	void setAnimationFps(double fps);
+
+	/// Starts animation playback from the first frame.
+	/// @param loop - true if animation shall be repeated until stopped.
+	void playAnimation(bool loop);
+
+	/// Stops animation playback, current frame stays on the screen.
+	void stopAnimation();
+
+	/// Add a label to the specific position of the screen. If there already is a label in these coordinates, its
+	/// contents will be updated.
+	/// @param text - label text.
+	/// @param x - label x coordinate.
+	/// @param y - label y coordinate.
+	virtual void addLabel(QString const &text, int x, int y) = 0;
+
+	/// Remove all labels from the screen.
+	virtual void removeLabels() = 0;
+
+	/// Queues worker object for deletion. It is actually deleted when control flow returns to event loop.
+	void deleteWorker();
+
+	/// Hides everything shown by this worker and stops animation.
+	virtual void hide() = 0;
+
+	/// Sets background for a picture.
+	/// @param color - color of a background.
+	virtual void setBackground(QString const &color) = 0;
+
+	/// Set painter width.
+	virtual void setPainterWidth(int penWidth) = 0;
+
+	/// Set painter color.
+	virtual void setPainterColor(QString const &color) = 0;
+
+	/// Clear everything painted with this object.
+	virtual void clear() = 0;
+
+	/// Draw point.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	virtual void drawPoint(int x, int y) = 0;
+
+	/// Draw line.
+	/// @param x1 - first point's x coordinate.
+	/// @param y1 - first point's y coordinate.
+	/// @param x2 - second point's x coordinate.
+	/// @param y2 - second point's y coordinate.
+	virtual void drawLine(int x1, int y1, int x2, int y2) = 0;
+
+	/// Draw rect.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	/// @param width - rect's width.
+	/// @param height - rect's height.
+	virtual void drawRect(int x, int y, int width, int height) = 0;
+
+	/// Draw ellipse.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	/// @param width - width of ellipse.
+	/// @param height - height of ellipse.
+	virtual void drawEllipse(int x, int y, int width, int height) = 0;
+
+	/// Draw arc.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	/// @param width - width rect forming an arc.
+	/// @param height - height rect forming an arc.
+	/// @param startAngle - start angle.
+	/// @param spanAngle - end andle.
+	virtual void drawArc(int x, int y, int width, int height, int startAngle, int spanAngle) = 0;
+
+protected:
+	/// Draws all commands of a frame submitted by a script.
+	virtual void drawFrame(DrawCommandBuffer const &frame) = 0;
+
+	/// Shows decoded image, null image removes currently shown image.
+	virtual void setImage(QImage const &image) = 0;
+
+	/// Removes currently shown image, cancels showing of image that is being decoded and stops animation.
+	void clearImage();
+
+	/// Sets size to which images and animation frames are scaled to fit the screen.
+	void setImageSize(QSize const &size);
+
+	/// Returns background color by its name used in scripts.
+	static QColor backgroundColor(QString const &color);
+
+private slots:
+	/// Draws the oldest submitted frame.
+	void drawPendingFrame();
+
+	/// Shows decoded image if it is the last one requested by showImage().
+	void onImageLoaded(QString const &fileName, QImage const &image);
+
+	/// Shows animation frame.
+	void onAnimationFrame(QImage const &frame);
+
+private:
+	/// Frames submitted by a script and not yet drawn. Has ownership.
+	QQueue<DrawCommandBuffer *> mPendingFrames;
+
+	/// Empty buffers of already drawn frames, kept to reuse their memory. Has ownership.
+	QList<DrawCommandBuffer *> mFreeFrames;
+
+	/// Guards mPendingFrames and mFreeFrames.
+	QMutex mFramesLock;
+
+	/// Has ownership through Qt object hierarchy, so it is moved to GUI thread along with the worker.
+	ImageCache *mImageCache;
+
+	/// Has ownership through Qt object hierarchy.
+	AnimationPlayer *mAnimationPlayer;
+
+	/// Image requested by showImage() that is being decoded now, empty if there is no such image.
+	QString mPendingImage;
+};
+
+}
@@ -15,56 +15,51 @@
 #include "src/abstractVirtualSensorWorker.h"
 
 #include <QtCore/QDebug>
-#include <QtCore/QFileInfo>
-#include <QtCore/QWaitCondition>
-#include <QtCore/QMutex>
+
+#include "src/deviceBackendInterface.h"
+#include "src/virtualSensorDeviceInterface.h"
 
 using namespace trikControl;
 
-AbstractVirtualSensorWorker::AbstractVirtualSensorWorker(QString const &script, QString const &inputFile
-		, QString const &outputFile)
+AbstractVirtualSensorWorker::AbstractVirtualSensorWorker(DeviceBackendInterface &backend, QString const &script
+		, QString const &inputFile, QString const &outputFile)
+	: mDevice(backend.createVirtualSensorDevice(script, inputFile, outputFile))
 {
-	Q_UNUSED(script)
-	Q_UNUSED(inputFile)
-	Q_UNUSED(outputFile)
+	// Device shall be moved to worker thread together with a worker.
+	mDevice->setParent(this);
+	connect(mDevice.data(), SIGNAL(newData(QString)), this, SLOT(onNewData(QString)));
 }
 
 AbstractVirtualSensorWorker::~AbstractVirtualSensorWorker()
 {
+	mDevice->stop();
 }
 
-void AbstractVirtualSensorWorker::init()
-{
-}
-
-void AbstractVirtualSensorWorker::readFile()
+void AbstractVirtualSensorWorker::stop()
 {
+	mDevice->stop();
 }
 
-bool AbstractVirtualSensorWorker::launchSensorScript(QString const &command)
-{
-	Q_UNUSED(command)
-
-	return true;
-}
-
-void AbstractVirtualSensorWorker::startVirtualSensor()
-{
-}
-
-void AbstractVirtualSensorWorker::openFifos()
+void AbstractVirtualSensorWorker::init()
 {
+	qDebug() << "Initializing" << sensorName() << "sensor";
+	mDevice->start();
+	sync();
 }
 
 void AbstractVirtualSensorWorker::sendCommand(QString const &command)
 {
-	Q_UNUSED(command)
-}
-
-void AbstractVirtualSensorWorker::deinitialize()
-{
+	mCommandQueue << command;
+	sync();
 }
 
 void AbstractVirtualSensorWorker::sync()
 {
+	if (mDevice->isReady()) {
+		for (QString const &command : mCommandQueue) {
+			mDevice->send(command);
+		}
+
+		mCommandQueue.clear();
+	}
 }
@@ -16,29 +16,30 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QScopedPointer>
-#include <QtCore/QSocketNotifier>
 #include <QtCore/QString>
-#include <QtCore/QProcess>
-#include <QtCore/QFile>
-#include <QtCore/QTextStream>
 #include <QtCore/QList>
 
 namespace trikControl {
 
-/// Base class for all virtual sensor workers. Virtual sensor is an external process that communicates using input and
-/// output FIFOs and uses script that allows to start, stop or restart it. This class is a worker that is intended to
-/// run in separate process and is responsible for technical side of communication with virtual server. Actual
-/// protocol and interpretation of data must be implemented in descendants.
+class DeviceBackendInterface;
+class VirtualSensorDeviceInterface;
+
+/// Base class for all virtual sensor workers. Virtual sensor is an external process that communicates using text
+/// commands and text output lines, technical side of communication is handled by virtual sensor device provided by
+/// device backend. This class is a worker that is intended to run in separate thread, it queues commands until
+/// sensor is ready. Actual protocol and interpretation of data must be implemented in descendants.
 class AbstractVirtualSensorWorker : public QObject
 {
 	Q_OBJECT
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides connection to a sensor.
 	/// @param script - file name of a scrit used to start or stop a sensor.
 	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
 	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
-	AbstractVirtualSensorWorker(QString const &script, QString const &inputFile, QString const &outputFile);
+	AbstractVirtualSensorWorker(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+			, QString const &outputFile);
 
 	~AbstractVirtualSensorWorker() override;
 
@@ -50,68 +51,25 @@ protected:
 	/// Launch sensor.
 	void init();
 
-	/// If sensor is ready, sends a command to its input FIFO, otherwise queues this command and sends it later.
+	/// If sensor is ready, sends a command to it, otherwise queues this command and sends it later.
 	void sendCommand(QString const &command);
 
 private slots:
-	/// Updates current reading when new value is ready.
-	void readFile();
+	/// Called when new data is available from a sensor, called separately for each line.
+	virtual void onNewData(QString const &dataLine) = 0;
 
 private:
 	/// Provides user-friendly name of a sensor used in debug output.
 	virtual QString sensorName() const = 0;
 
-	/// Called when new data is available in sensor output fifo, called separately for each line.
-	virtual void onNewData(QString const &dataLine) = 0;
-
-	/// Starts virtual sensor if needed and opens its fifos.
-	void initVirtualSensor();
-
-	/// Launches sensor control script with given command as a parameter.
-	/// @returns true if sensor script launched successfully.
-	bool launchSensorScript(QString const &command);
-
-	/// Starts virtual sensor process.
-	void startVirtualSensor();
-
-	/// Opens input and output fifos of a sensor.
-	void openFifos();
-
-	/// Closes fifos and stops sensor.
-	void deinitialize();
-
 	/// Flushes queued commands to a sensor, if it is ready, otherwise does nothing.
 	void sync();
 
-	/// Listener for output fifo.
-	QScopedPointer<QSocketNotifier> mSocketNotifier;
+	/// Connection to a sensor.
+	QScopedPointer<VirtualSensorDeviceInterface> mDevice;
 
-	/// File name (with path) of a script that launches or stops sensor.
-	QString mScript;
-
-	/// File descriptor for output fifo.
-	int mOutputFileDescriptor = -1;
-
-	/// Virtual sensor process.
-	QProcess mSensorProcess;
-
-	/// Input fifo.
-	QFile mInputFile;
-
-	/// Output fifo.
-	QFile mOutputFile;
-
-	/// File stream for command fifo. Despite its name it is used to output commands. It is input for virtual sensor.
-	QTextStream mInputStream;
-
-	/// Flag that sensor is ready and waiting for commands.
-	bool mReady = false;
-
-	/// A queue of commands to be passed to input fifo when it is ready.
+	/// A queue of commands to be passed to a sensor when it is ready.
 	QList<QString> mCommandQueue;
-
-	/// Buffer with current line being read from FIFO.
-	QString mBuffer;
 };
 
 }
@@ -18,9 +18,9 @@
 
 using namespace trikControl;
 
-AngularServoMotor::AngularServoMotor(int min, int max, int zero, int stop, QString const &dutyFile
-		, QString const &periodFile, int period, bool invert)
-	: ServoMotor(min, max, zero, stop, dutyFile, periodFile, period, invert)
+AngularServoMotor::AngularServoMotor(DeviceBackendInterface &backend, int min, int max, int zero
+		, int stop, QString const &dutyFile, QString const &periodFile, int period, bool invert)
+	: ServoMotor(backend, min, max, zero, stop, dutyFile, periodFile, period, invert)
 {
 }
 
@@ -21,6 +21,8 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+
 /// Angular servomotor.
 class AngularServoMotor : public ServoMotor
 {
@@ -28,6 +30,7 @@ class AngularServoMotor : public ServoMotor
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to device files.
 	/// @param min - value of duty_ns corresponding to full clockwise rotation of a motor. Used to calculate actual
 	///        values from values in range [-90..90] from client program.
 	/// @param max - value of duty_ns corresponding to full counter clockwise rotation of a motor. Used to calculate
@@ -37,8 +40,8 @@ public:
 	/// @param periodFile - file for setting period of PWM signal supplied to this motor
 	/// @param period - value of period for setting while initialization
 	/// @param invert - true, if power values set by setPower slot shall be negated before sent to motor.
-	AngularServoMotor(int min, int max, int zero, int stop, QString const &dutyFile, QString const &periodFile
-			, int period, bool invert);
+	AngularServoMotor(DeviceBackendInterface &backend, int min, int max, int zero, int stop
+			, QString const &dutyFile, QString const &periodFile, int period, bool invert);
 
 public slots:
 	/// Sets current motor angle to specified value.
@@ -0,0 +1,211 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "animationPlayer.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QRunnable>
+
+using namespace trikControl;
+
+Q_DECLARE_METATYPE(QVector<QImage>)
+
+/// Decodes all frames of an animation and passes them back to a player.
+class AnimationPlayer::DecodeTask : public QRunnable
+{
+public:
+	/// Constructor.
+	/// @param frameSize - size of a frame in a sprite sheet, invalid if animation is a sequence of files.
+	DecodeTask(AnimationPlayer &player, int generation, QStringList const &fileNames, QSize const &frameSize
+			, QSize const &targetSize)
+		: mPlayer(player)
+		, mGeneration(generation)
+		, mFileNames(fileNames)
+		, mFrameSize(frameSize)
+		, mTargetSize(targetSize)
+	{
+	}
+
+	void run() override
+	{
+		QVector<QImage> frames;
+		if (mFrameSize.isValid()) {
+			QImage const sheet(mFileNames.first());
+			for (int y = 0; y + mFrameSize.height() <= sheet.height(); y += mFrameSize.height()) {
+				for (int x = 0; x + mFrameSize.width() <= sheet.width(); x += mFrameSize.width()) {
+					frames << prepare(sheet.copy(QRect(QPoint(x, y), mFrameSize)));
+				}
+			}
+		} else {
+			for (QString const &fileName : mFileNames) {
+				frames << prepare(QImage(fileName));
+			}
+		}
+
+		QMetaObject::invokeMethod(&mPlayer, "onFramesDecoded", Qt::QueuedConnection
+				, Q_ARG(int, mGeneration), Q_ARG(QVector<QImage>, frames));
+	}
+
+private:
+	/// Scales a frame to target size and converts it to the format that is the fastest to draw.
+	QImage prepare(QImage const &frame) const
+	{
+		QImage const scaled = !frame.isNull() && mTargetSize.isValid()
+				? frame.scaled(mTargetSize, Qt::KeepAspectRatio)
+				: frame;
+
+		return scaled.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+	}
+
+	AnimationPlayer &mPlayer;
+	int const mGeneration;
+	QStringList const mFileNames;
+	QSize const mFrameSize;
+	QSize const mTargetSize;
+};
+
+AnimationPlayer::AnimationPlayer(QObject *parent)
+	: QObject(parent)
+	, mGeneration(0)
+	, mIsLoading(false)
+	, mIsPlaying(false)
+	, mIsLooping(false)
+	, mFps(10)
+	, mCurrentFrame(-1)
+	, mFpsChangeTime(0)
+	, mFpsChangeFrame(0)
+{
+	qRegisterMetaType<QVector<QImage>>("QVector<QImage>");
+
+	mDecoderPool.setMaxThreadCount(1);
+
+	// Timer shall be moved to GUI thread together with the player.
+	mTimer.setParent(this);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+	mTimer.setTimerType(Qt::PreciseTimer);
+#endif
+	connect(&mTimer, SIGNAL(timeout()), this, SLOT(onTimer()));
+}
+
+AnimationPlayer::~AnimationPlayer()
+{
+	mDecoderPool.waitForDone();
+}
+
+void AnimationPlayer::setTargetSize(QSize const &size)
+{
+	mTargetSize = size;
+}
+
+void AnimationPlayer::loadFrames(QStringList const &fileNames)
+{
+	load(fileNames, QSize());
+}
+
+void AnimationPlayer::loadSpriteSheet(QString const &fileName, int frameWidth, int frameHeight)
+{
+	if (frameWidth <= 0 || frameHeight <= 0) {
+		qDebug() << "Incorrect sprite sheet frame size" << frameWidth << frameHeight;
+		return;
+	}
+
+	load(QStringList(fileName), QSize(frameWidth, frameHeight));
+}
+
+void AnimationPlayer::load(QStringList const &fileNames, QSize const &frameSize)
+{
+	stop();
+	mFrames.clear();
+	++mGeneration;
+	mIsLoading = !fileNames.isEmpty();
+	if (mIsLoading) {
+		mDecoderPool.start(new DecodeTask(*this, mGeneration, fileNames, frameSize, mTargetSize));
+	}
+}
+
+void AnimationPlayer::onFramesDecoded(int generation, QVector<QImage> const &frames)
+{
+	if (generation != mGeneration) {
+		return;
+	}
+
+	mFrames = frames;
+	mIsLoading = false;
+	start();
+}
+
+void AnimationPlayer::setFps(double fps)
+{
+	if (fps <= 0) {
+		qDebug() << "Incorrect animation fps" << fps;
+		return;
+	}
+
+	if (mTimer.isActive()) {
+		mFpsChangeFrame = position();
+		mFpsChangeTime = mPlaybackTime.elapsed();
+		mTimer.setInterval(qMax(1, static_cast<int>(1000 / fps)));
+	}
+
+	mFps = fps;
+}
+
+void AnimationPlayer::play(bool loop)
+{
+	mIsPlaying = true;
+	mIsLooping = loop;
+	start();
+}
+
+void AnimationPlayer::stop()
+{
+	mIsPlaying = false;
+	mTimer.stop();
+}
+
+void AnimationPlayer::start()
+{
+	if (!mIsPlaying || mIsLoading || mFrames.isEmpty()) {
+		return;
+	}
+
+	mCurrentFrame = -1;
+	mFpsChangeTime = 0;
+	mFpsChangeFrame = 0;
+	mPlaybackTime.start();
+	mTimer.start(qMax(1, static_cast<int>(1000 / mFps)));
+	onTimer();
+}
+
+double AnimationPlayer::position() const
+{
+	return mFpsChangeFrame + (mPlaybackTime.elapsed() - mFpsChangeTime) * mFps / 1000;
+}
+
+void AnimationPlayer::onTimer()
+{
+	int const frameCount = mFrames.size();
+	int frame = static_cast<int>(position());
+	bool const isFinished = !mIsLooping && frame >= frameCount - 1;
+	frame = mIsLooping ? frame % frameCount : qMin(frame, frameCount - 1);
+
+	if (frame != mCurrentFrame) {
+		mCurrentFrame = frame;
+		emit frameChanged(mFrames[frame]);
+	}
+
+	if (isFinished) {
+		stop();
+	}
+}
@@ -0,0 +1,124 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QSize>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+
+namespace trikControl {
+
+/// Plays animations on a display. Frames are decoded and scaled in background when animation is loaded, and shown
+/// by a timer in the thread the player lives in, so playback does not depend on a script. Current frame is computed
+/// from time elapsed since start of playback, so late timer ticks do not accumulate into a drift.
+class AnimationPlayer : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param parent - parent of this object in Qt object hierarchy.
+	explicit AnimationPlayer(QObject *parent = nullptr);
+
+	~AnimationPlayer() override;
+
+	/// Sets size to which frames shall be scaled, keeping aspect ratio. Affects animations loaded after the call.
+	void setTargetSize(QSize const &size);
+
+	/// Loads animation consisting of a sequence of image files. Stops current animation.
+	void loadFrames(QStringList const &fileNames);
+
+	/// Loads animation from a sprite sheet, an image with frames of equal size placed left to right, top to bottom.
+	/// Stops current animation.
+	/// @param fileName - sprite sheet file.
+	/// @param frameWidth - width of a frame in pixels.
+	/// @param frameHeight - height of a frame in pixels.
+	void loadSpriteSheet(QString const &fileName, int frameWidth, int frameHeight);
+
+	/// Sets playback speed in frames per second. Takes effect immediately.
+	void setFps(double fps);
+
+	/// Starts playback from the first frame. If animation is still loading, playback starts when it is loaded.
+	/// @param loop - true if animation shall be repeated until stop() is called.
+	void play(bool loop);
+
+	/// Stops playback, last shown frame stays on a screen.
+	void stop();
+
+signals:
+	/// Emitted when a frame shall be shown.
+	void frameChanged(QImage const &frame);
+
+private slots:
+	/// Shows frame corresponding to current time.
+	void onTimer();
+
+	/// Accepts decoded frames. Called from decoding thread by queued connection.
+	/// @param generation - number of animation load request, used to drop results of outdated requests.
+	void onFramesDecoded(int generation, QVector<QImage> const &frames);
+
+private:
+	class DecodeTask;
+
+	/// Drops current animation and starts decoding of a new one.
+	void load(QStringList const &fileNames, QSize const &frameSize);
+
+	/// Starts timer if animation is loaded and playback is requested.
+	void start();
+
+	/// Returns number of frames played since playback start, with fractional part.
+	double position() const;
+
+	QVector<QImage> mFrames;
+
+	/// Number of current animation load request.
+	int mGeneration;
+
+	/// True if animation is being decoded now.
+	bool mIsLoading;
+
+	/// True if playback is requested.
+	bool mIsPlaying;
+
+	bool mIsLooping;
+
+	double mFps;
+
+	/// Index of currently shown frame, -1 if no frame of current playback is shown yet.
+	int mCurrentFrame;
+
+	QSize mTargetSize;
+
+	QTimer mTimer;
+
+	/// Time since playback start.
+	QElapsedTimer mPlaybackTime;
+
+	/// Playback time at which current fps was set, in milliseconds.
+	qint64 mFpsChangeTime;
+
+	/// Number of frames played before current fps was set.
+	double mFpsChangeFrame;
+
+	/// Thread used for decoding.
+	QThreadPool mDecoderPool;
+};
+
+}
@@ -0,0 +1,87 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QtGlobal>
+
+namespace trikControl {
+
+/// Fixed-size set of bits that can be set, tested and cleared from different threads without locks.
+/// @tparam bitCount - number of bits in a set.
+template<int bitCount>
+class AtomicBitset
+{
+public:
+	AtomicBitset()
+	{
+		reset();
+	}
+
+	/// Sets given bit. Bits out of range are ignored.
+	void set(int bit)
+	{
+		if (inRange(bit)) {
+			mWords[bit / bitsPerWord].fetch_or(mask(bit), std::memory_order_relaxed);
+		}
+	}
+
+	/// Clears given bit. Bits out of range are ignored.
+	void clear(int bit)
+	{
+		if (inRange(bit)) {
+			mWords[bit / bitsPerWord].fetch_and(~mask(bit), std::memory_order_relaxed);
+		}
+	}
+
+	/// Returns value of given bit, false for bits out of range.
+	bool test(int bit) const
+	{
+		return inRange(bit) && (mWords[bit / bitsPerWord].load(std::memory_order_relaxed) & mask(bit));
+	}
+
+	/// Clears given bit and returns its previous value in one atomic operation.
+	bool testAndClear(int bit)
+	{
+		return inRange(bit) && (mWords[bit / bitsPerWord].fetch_and(~mask(bit), std::memory_order_relaxed) & mask(bit));
+	}
+
+	/// Clears all bits.
+	void reset()
+	{
+		for (std::atomic<quint64> &word : mWords) {
+			word.store(0, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	static int const bitsPerWord = 64;
+	static int const wordCount = (bitCount + bitsPerWord - 1) / bitsPerWord;
+
+	static bool inRange(int bit)
+	{
+		return bit >= 0 && bit < bitCount;
+	}
+
+	static quint64 mask(int bit)
+	{
+		return static_cast<quint64>(1) << (bit % bitsPerWord);
+	}
+
+	std::atomic<quint64> mWords[wordCount];
+};
+
+}
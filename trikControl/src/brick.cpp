@@ -25,21 +25,31 @@
 #include "powerMotor.h"
 
 #include "configurer.h"
+#include "hardwareDeviceBackend.h"
 #include "i2cCommunicator.h"
+#include "simulatedDeviceBackend.h"
 
 using namespace trikControl;
 
 Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &startDirPath)
 	: mConfigurer(new Configurer(configFilePath))
 	, mI2cCommunicator(NULL)
-	, mDisplay(guiThread, startDirPath)
+	, mDisplay(guiThread, startDirPath, mConfigurer->displayRenderer(), mConfigurer->framebufferDevice())
 	, mInEventDrivenMode(false)
 {
-	if (::system(mConfigurer->initScript().toStdString().c_str()) != 0) {
-		qDebug() << "Init script failed";
+	if (mConfigurer->isSimulator()) {
+		qDebug() << "Using simulated devices";
+		mDeviceBackend = new SimulatedDeviceBackend(*mConfigurer);
+	} else {
+		mDeviceBackend = new HardwareDeviceBackend();
+		if (::system(mConfigurer->initScript().toStdString().c_str()) != 0) {
+			qDebug() << "Init script failed";
+		}
 	}
 
-	mI2cCommunicator = new I2cCommunicator(mConfigurer->i2cPath(), mConfigurer->i2cDeviceId());
+	mI2cCommunicator = new I2cCommunicator(
+			mDeviceBackend->createI2cBus(mConfigurer->i2cPath(), mConfigurer->i2cDeviceId())
+			);
 
 	for (QString const &port : mConfigurer->servoMotorPorts()) {
 		QString const servoMotorType = mConfigurer->servoMotorDefaultType(port);
@@ -47,7 +57,8 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 		ServoMotor *servoMotor = NULL;
 		if (mConfigurer->isServoMotorTypeContiniousRotation(servoMotorType)) {
 			servoMotor = new ContiniousRotationServoMotor(
-					mConfigurer->servoMotorTypeMin(servoMotorType)
+					*mDeviceBackend
+					, mConfigurer->servoMotorTypeMin(servoMotorType)
 					, mConfigurer->servoMotorTypeMax(servoMotorType)
 					, mConfigurer->servoMotorTypeZero(servoMotorType)
 					, mConfigurer->servoMotorTypeStop(servoMotorType)
@@ -58,7 +69,8 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 					);
 		} else {
 			servoMotor = new AngularServoMotor(
-					mConfigurer->servoMotorTypeMin(servoMotorType)
+					*mDeviceBackend
+					, mConfigurer->servoMotorTypeMin(servoMotorType)
 					, mConfigurer->servoMotorTypeMax(servoMotorType)
 					, mConfigurer->servoMotorTypeZero(servoMotorType)
 					, mConfigurer->servoMotorTypeStop(servoMotorType)
@@ -74,7 +86,8 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 
 	for (QString const &port : mConfigurer->pwmCapturePorts()) {
 		PwmCapture *pwmCapture = new PwmCapture(
-				mConfigurer->pwmCaptureFrequencyFile(port)
+				*mDeviceBackend
+				, mConfigurer->pwmCaptureFrequencyFile(port)
 				, mConfigurer->pwmCaptureDutyFile(port)
 				);
 
@@ -110,7 +123,8 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 		QString const digitalSensorType = mConfigurer->digitalSensorDefaultType(port);
 
 		DigitalSensor *digitalSensor = new DigitalSensor(
-				mConfigurer->digitalSensorTypeMin(digitalSensorType)
+				*mDeviceBackend
+				, mConfigurer->digitalSensorTypeMin(digitalSensorType)
 				, mConfigurer->digitalSensorTypeMax(digitalSensorType)
 				, mConfigurer->digitalSensorDeviceFile(port)
 				);
@@ -131,33 +145,37 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 	mBattery = new Battery(*mI2cCommunicator);
 
 	if (mConfigurer->hasAccelerometer()) {
-		mAccelerometer = new Sensor3d(mConfigurer->accelerometerMin()
+		mAccelerometer = new Sensor3d(*mDeviceBackend
+				, mConfigurer->accelerometerMin()
 				, mConfigurer->accelerometerMax()
 				, mConfigurer->accelerometerDeviceFile()
 				);
 	}
 
 	if (mConfigurer->hasGyroscope()) {
-		mGyroscope = new Sensor3d(mConfigurer->gyroscopeMin()
+		mGyroscope = new Sensor3d(*mDeviceBackend
+				, mConfigurer->gyroscopeMin()
 				, mConfigurer->gyroscopeMax()
 				, mConfigurer->gyroscopeDeviceFile()
 				);
 	}
 
-	mKeys = new Keys(mConfigurer->keysDeviceFile());
+	mKeys = new Keys(*mDeviceBackend, mConfigurer->keysDeviceFile());
 
-	mLed = new Led(mConfigurer->ledRedDeviceFile()
+	mLed = new Led(*mDeviceBackend
+			, mConfigurer->ledRedDeviceFile()
 			, mConfigurer->ledGreenDeviceFile()
 			, mConfigurer->ledOn()
 			, mConfigurer->ledOff()
 			);
 
 	if (mConfigurer->hasGamepad()) {
-		mGamepad = new Gamepad(mConfigurer->gamepadPort());
+		mGamepad = new Gamepad(mConfigurer->gamepadPort(), mConfigurer->gamepadTransport());
 	}
 
 	if (mConfigurer->hasLineSensor()) {
-		mLineSensor = new LineSensor(mConfigurer->lineSensorScript()
+		mLineSensor = new LineSensor(*mDeviceBackend
+				, mConfigurer->lineSensorScript()
 				, mConfigurer->lineSensorInFifo()
 				, mConfigurer->lineSensorOutFifo()
 				, mConfigurer->lineSensorToleranceFactor()
@@ -165,7 +183,8 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 	}
 
 	if (mConfigurer->hasObjectSensor()) {
-		mObjectSensor = new ObjectSensor(mConfigurer->objectSensorScript()
+		mObjectSensor = new ObjectSensor(*mDeviceBackend
+				, mConfigurer->objectSensorScript()
 				, mConfigurer->objectSensorInFifo()
 				, mConfigurer->objectSensorOutFifo()
 				, mConfigurer->objectSensorToleranceFactor()
@@ -173,7 +192,8 @@ Brick::Brick(QThread &guiThread, QString const &configFilePath, const QString &s
 	}
 
 	if (mConfigurer->hasColorSensor()) {
-		mColorSensor = new ColorSensor(mConfigurer->colorSensorScript()
+		mColorSensor = new ColorSensor(*mDeviceBackend
+				, mConfigurer->colorSensorScript()
 				, mConfigurer->colorSensorInFifo()
 				, mConfigurer->colorSensorOutFifo()
 				, mConfigurer->colorSensorM()
@@ -201,6 +221,7 @@ Brick::~Brick()
 	delete mLineSensor;
 	delete mColorSensor;
 	delete mObjectSensor;
+	delete mDeviceBackend;
 }
 
 void Brick::reset()
@@ -0,0 +1,244 @@
+/* Copyright 2014 Kogutich Denis, Smirnov Mikhail, CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "canvas.h"
+
+#include <QtGui/QPen>
+
+using namespace trikControl;
+
+Canvas::Canvas()
+	: mCurrentPenColor(Qt::black)
+	, mCurrentPenWidth(0)
+	, mNextSequence(0)
+{
+}
+
+void Canvas::resize(QSize const &size)
+{
+	mImage = QImage(size, QImage::Format_ARGB32_Premultiplied);
+	redraw(mImage.rect());
+}
+
+QImage const &Canvas::image() const
+{
+	return mImage;
+}
+
+void Canvas::redraw(QRect const &area)
+{
+	QPainter painter(&mImage);
+	painter.setClipRect(area);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+	painter.fillRect(area, Qt::transparent);
+	painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+	// Each store is ordered by sequence numbers, so they are merged by picking a store with the least next number.
+	int line = 0;
+	int point = 0;
+	int rect = 0;
+	int ellipse = 0;
+	int arc = 0;
+	forever {
+		quint64 const lineSequence = mLines.sequenceAt(line, area);
+		quint64 const pointSequence = mPoints.sequenceAt(point, area);
+		quint64 const rectSequence = mRects.sequenceAt(rect, area);
+		quint64 const ellipseSequence = mEllipses.sequenceAt(ellipse, area);
+		quint64 const arcSequence = mArcs.sequenceAt(arc, area);
+		quint64 const next = qMin(qMin(qMin(lineSequence, pointSequence), qMin(rectSequence, ellipseSequence))
+				, arcSequence);
+
+		if (next == PrimitiveStore<LineCoordinates>::noSequence) {
+			break;
+		} else if (next == lineSequence) {
+			paint(painter, mLines.at(line++));
+		} else if (next == pointSequence) {
+			paint(painter, mPoints.at(point++));
+		} else if (next == rectSequence) {
+			paint(painter, mRects.at(rect++));
+		} else if (next == ellipseSequence) {
+			paint(painter, mEllipses.at(ellipse++));
+		} else {
+			paint(painter, mArcs.at(arc++));
+		}
+	}
+}
+
+void Canvas::setPen(QPainter &painter, QColor const &color, int penWidth)
+{
+	if (painter.pen().color() != color || painter.pen().width() != penWidth) {
+		painter.setPen(QPen(color, penWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
+	}
+}
+
+void Canvas::paint(QPainter &painter, PointCoordinates const &point)
+{
+	setPen(painter, point.color, point.penWidth);
+	painter.drawPoint(point.coord);
+}
+
+void Canvas::paint(QPainter &painter, LineCoordinates const &line)
+{
+	setPen(painter, line.color, line.penWidth);
+	painter.drawLine(line.coord1, line.coord2);
+}
+
+void Canvas::paint(QPainter &painter, RectCoordinates const &rect)
+{
+	setPen(painter, rect.color, rect.penWidth);
+	painter.drawRect(rect.rect);
+}
+
+void Canvas::paint(QPainter &painter, EllipseCoordinates const &ellipse)
+{
+	setPen(painter, ellipse.color, ellipse.penWidth);
+	painter.drawEllipse(ellipse.ellipse);
+}
+
+void Canvas::paint(QPainter &painter, ArcCoordinates const &arc)
+{
+	setPen(painter, arc.color, arc.penWidth);
+	painter.drawArc(arc.arc, arc.startAngle, arc.spanAngle);
+}
+
+QRect Canvas::paintedArea(QRect const &boundingRect, int penWidth)
+{
+	// Square cap and miter join can extend a primitive by half of pen width in every direction.
+	int const margin = penWidth / 2 + 1;
+	return boundingRect.normalized().adjusted(-margin, -margin, margin, margin);
+}
+
+template<typename Primitive>
+void Canvas::rasterize(Primitive const &primitive)
+{
+	QPainter painter(&mImage);
+	paint(painter, primitive);
+}
+
+template<typename Primitive>
+QRect Canvas::add(PrimitiveStore<Primitive> &store, Primitive const &primitive, QRect const &boundingRect)
+{
+	QRect const area = paintedArea(boundingRect, primitive.penWidth);
+	Primitive previous;
+	switch (store.insert(primitive, mNextSequence++, area, &previous)) {
+	case PrimitiveStore<Primitive>::added:
+		rasterize(primitive);
+		return area;
+	case PrimitiveStore<Primitive>::replaced:
+		if (previous.penWidth > primitive.penWidth) {
+			// New primitive does not cover the old one completely, so area of the old one is redrawn without it.
+			QRect const previousArea = paintedArea(boundingRect, previous.penWidth);
+			redraw(previousArea);
+			return previousArea;
+		}
+
+		rasterize(primitive);
+		return area;
+	case PrimitiveStore<Primitive>::unchanged:
+		break;
+	}
+
+	return QRect();
+}
+
+void Canvas::deleteAllItems()
+{
+	mPoints.clear();
+	mLines.clear();
+	mRects.clear();
+	mEllipses.clear();
+	mArcs.clear();
+	mNextSequence = 0;
+
+	mImage.fill(Qt::transparent);
+}
+
+void Canvas::setPainterColor(QString const &color)
+{
+	if (color == tr("white")) {
+		mCurrentPenColor = Qt::white;
+	} else if (color == tr("red")) {
+		mCurrentPenColor = Qt::red;
+	} else if (color == tr("darkRed")) {
+		mCurrentPenColor = Qt::darkRed;
+	} else if (color == tr("green")) {
+		mCurrentPenColor = Qt::green;
+	} else if (color == tr("darkGreen")) {
+		mCurrentPenColor = Qt::darkGreen;
+	} else if (color == tr("blue")) {
+		mCurrentPenColor = Qt::blue;
+	} else if (color == tr("darkBlue")) {
+		mCurrentPenColor = Qt::darkBlue;
+	} else if (color == tr("cyan")) {
+		mCurrentPenColor = Qt::cyan;
+	} else if (color == tr("darkCyan")) {
+		mCurrentPenColor = Qt::darkCyan;
+	} else if (color == tr("magenta")) {
+		mCurrentPenColor = Qt::magenta;
+	} else if (color == tr("darkMagenta")) {
+		mCurrentPenColor = Qt::darkMagenta;
+	} else if (color == tr("yellow")) {
+		mCurrentPenColor = Qt::yellow;
+	} else if (color == tr("darkYellow")) {
+		mCurrentPenColor = Qt::darkYellow;
+	} else if (color == tr("gray")) {
+		mCurrentPenColor = Qt::gray;
+	} else if (color == tr("darkGray")) {
+		mCurrentPenColor = Qt::darkGray;
+	} else if (color == tr("lightGray")) {
+		mCurrentPenColor = Qt::lightGray;
+	} else {
+		mCurrentPenColor = Qt::black;
+	}
+}
+
+void Canvas::setPainterWidth(int penWidth)
+{
+	mCurrentPenWidth = penWidth;
+}
+
+QRect Canvas::drawPoint(int x, int y)
+{
+	PointCoordinates const coordinates(x, y, mCurrentPenColor, mCurrentPenWidth);
+	return add(mPoints, coordinates, QRect(coordinates.coord, coordinates.coord));
+}
+
+QRect Canvas::drawLine(int x1, int y1, int x2, int y2)
+{
+	LineCoordinates const coordinates(x1, y1, x2, y2, mCurrentPenColor, mCurrentPenWidth);
+	return add(mLines, coordinates, QRect(coordinates.coord1, coordinates.coord2));
+}
+
+QRect Canvas::drawRect(int x, int y, int width, int height)
+{
+	RectCoordinates const coordinates(x, y, width, height, mCurrentPenColor, mCurrentPenWidth);
+	return add(mRects, coordinates, coordinates.rect);
+}
+
+QRect Canvas::drawEllipse(int x, int y, int width, int height)
+{
+	EllipseCoordinates const coordinates(x, y, width, height, mCurrentPenColor, mCurrentPenWidth);
+	return add(mEllipses, coordinates, coordinates.ellipse);
+}
+
+QRect Canvas::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
+{
+	ArcCoordinates const coordinates(x, y, width, height, startAngle, spanAngle, mCurrentPenColor, mCurrentPenWidth);
+	return add(mArcs, coordinates, coordinates.arc);
+}
+
+QColor Canvas::currentPenColor() const
+{
+	return mCurrentPenColor;
+}
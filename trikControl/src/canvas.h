@@ -0,0 +1,317 @@
+/* Copyright 2014 Kogutich Denis, Smirnov Mikhail, CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QPoint>
+#include <QtCore/QRect>
+#include <QtCore/QSize>
+#include <QtGui/QColor>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+
+#include "primitiveStore.h"
+
+namespace trikControl {
+
+/// Retained set of display primitives rasterized into an image. Primitives are drawn on the image once, when they are
+/// added, lists of primitives are used only when a part of the image needs to be redrawn, for example when its
+/// size changes. Primitives are always painted in order in which they were added, both when drawn one by one
+/// and when redrawn. Drawing methods return area of the image that was changed.
+class Canvas
+{
+	Q_DECLARE_TR_FUNCTIONS(Canvas)
+
+public:
+	Canvas();
+
+	/// Recreates image with given size and draws all primitives on it.
+	void resize(QSize const &size);
+
+	/// Returns image with all primitives drawn on transparent background.
+	QImage const &image() const;
+
+	/// Set painter color.
+	void setPainterColor(QString const &color);
+
+	/// Set painter width.
+	void setPainterWidth(int penWidth);
+
+	/// Returns current pen color.
+	QColor currentPenColor() const;
+
+	/// Delete all items.
+	void deleteAllItems();
+
+	/// Draw point.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	QRect drawPoint(int x, int y);
+
+	/// Draw line.
+	/// @param x1 - first point's x coordinate.
+	/// @param y1 - first point's y coordinate.
+	/// @param x2 - second point's x coordinate.
+	/// @param y2 - second point's y coordinate.
+	QRect drawLine(int x1, int y1, int x2, int y2);
+
+	/// Draw rect.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	/// @param width - rect's width.
+	/// @param height - rect's height.
+	QRect drawRect(int x, int y, int width, int height);
+
+	/// Draw ellipse.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	/// @param width - width of ellipse.
+	/// @param height - height of ellipse.
+	QRect drawEllipse(int x, int y, int width, int height);
+
+	/// Draw arc.
+	/// @param x - x coordinate.
+	/// @param y - y coordinate.
+	/// @param width - width rect forming an arc.
+	/// @param height - height rect forming an arc.
+	/// @param startAngle - start angle.
+	/// @param spanAngle - end angle.
+	QRect drawArc(int x, int y, int width, int height, int startAngle, int spanAngle);
+
+private:
+	/// Geometry of a primitive used to find primitives drawn at the same place. Unused values are zero.
+	struct GeometryKey
+	{
+		GeometryKey(int v0, int v1, int v2 = 0, int v3 = 0, int v4 = 0, int v5 = 0)
+			: values{v0, v1, v2, v3, v4, v5}
+		{
+		}
+
+		bool operator ==(GeometryKey const &other) const
+		{
+			for (int i = 0; i < 6; ++i) {
+				if (values[i] != other.values[i]) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		friend uint qHash(GeometryKey const &key)
+		{
+			uint result = 0;
+			for (int i = 0; i < 6; ++i) {
+				result = result * 31 + static_cast<uint>(key.values[i]);
+			}
+
+			return result;
+		}
+
+		int values[6];
+	};
+
+	/// Information about point.
+	struct PointCoordinates
+	{
+		typedef GeometryKey Key;
+
+		PointCoordinates()
+			: penWidth(0)
+		{
+		}
+
+		PointCoordinates(int x, int y, QColor color, int penWidth)
+				: coord(QPoint(x, y)), color(color), penWidth(penWidth)
+		{
+		}
+
+		Key key() const
+		{
+			return Key(coord.x(), coord.y());
+		}
+
+		QPoint coord;
+		QColor color;
+		int penWidth;
+	};
+
+	/// Information about rectangle.
+	struct RectCoordinates
+	{
+		typedef GeometryKey Key;
+
+		RectCoordinates()
+			: penWidth(0)
+		{
+		}
+
+		RectCoordinates(int x, int y, int width, int height, QColor color, int penWidth)
+			: rect(QRect(x, y, width, height)), color(color), penWidth(penWidth)
+		{
+		}
+
+		Key key() const
+		{
+			return Key(rect.x(), rect.y(), rect.width(), rect.height());
+		}
+
+		QRect rect;
+		QColor color;
+		int penWidth;
+	};
+
+	/// Information about line.
+	struct LineCoordinates
+	{
+		typedef GeometryKey Key;
+
+		LineCoordinates()
+			: penWidth(0)
+		{
+		}
+
+		LineCoordinates(int x1, int y1, int x2, int y2, QColor color, int penWidth)
+			: coord1(QPoint(x1, y1)), coord2(QPoint(x2, y2)), color(color), penWidth(penWidth)
+		{
+		}
+
+		Key key() const
+		{
+			return Key(coord1.x(), coord1.y(), coord2.x(), coord2.y());
+		}
+
+		QPoint coord1;
+		QPoint coord2;
+		QColor color;
+		int penWidth;
+	};
+
+	/// Struct of ellipse coordinates.
+	struct EllipseCoordinates
+	{
+		typedef GeometryKey Key;
+
+		EllipseCoordinates()
+			: penWidth(0)
+		{
+		}
+
+		EllipseCoordinates(int x, int y, int width, int height, QColor color, int penWidth)
+			: ellipse(QRect(x, y, width, height)), color(color), penWidth(penWidth)
+		{
+		}
+
+		Key key() const
+		{
+			return Key(ellipse.x(), ellipse.y(), ellipse.width(), ellipse.height());
+		}
+
+		QRect ellipse;
+		QColor color;
+		int penWidth;
+	};
+
+	/// Struct of arc coordinates.
+	struct ArcCoordinates
+	{
+		typedef GeometryKey Key;
+
+		ArcCoordinates()
+			: startAngle(0)
+			, spanAngle(0)
+			, penWidth(0)
+		{
+		}
+
+		ArcCoordinates(int x, int y, int width, int height, int startAngle, int spanAngle, QColor color, int penWidth)
+			: arc(QRect(x, y, width, height))
+			, startAngle(startAngle)
+			, spanAngle(spanAngle)
+			, color(color)
+			, penWidth(penWidth)
+		{
+		}
+
+		Key key() const
+		{
+			return Key(arc.x(), arc.y(), arc.width(), arc.height(), startAngle, spanAngle);
+		}
+
+		QRect arc;
+		int startAngle;
+		int spanAngle;
+		QColor color;
+		int penWidth;
+	};
+
+	/// Clears given area of the image and draws there all stored primitives that affect it, in order of addition.
+	void redraw(QRect const &area);
+
+	/// Sets pen for a primitive with given color and width.
+	static void setPen(QPainter &painter, QColor const &color, int penWidth);
+
+	/// Draws primitive on an image using given painter.
+	static void paint(QPainter &painter, PointCoordinates const &point);
+	static void paint(QPainter &painter, LineCoordinates const &line);
+	static void paint(QPainter &painter, RectCoordinates const &rect);
+	static void paint(QPainter &painter, EllipseCoordinates const &ellipse);
+	static void paint(QPainter &painter, ArcCoordinates const &arc);
+
+	/// Returns area affected by painting a primitive with given geometry and pen width.
+	/// @param boundingRect - rect containing geometry of a primitive, without regard to pen width.
+	static QRect paintedArea(QRect const &boundingRect, int penWidth);
+
+	/// Draws new primitive on the image.
+	template<typename Primitive>
+	void rasterize(Primitive const &primitive);
+
+	/// Adds primitive to a store and draws it if it is new or replaces primitive with the same geometry.
+	/// Returns affected area of the image.
+	/// @param store - store for primitives of this type.
+	/// @param primitive - primitive to add.
+	/// @param boundingRect - rect containing geometry of a primitive, without regard to pen width.
+	template<typename Primitive>
+	QRect add(PrimitiveStore<Primitive> &store, Primitive const &primitive, QRect const &boundingRect);
+
+	/// All lines.
+	PrimitiveStore<LineCoordinates> mLines;
+
+	/// All points.
+	PrimitiveStore<PointCoordinates> mPoints;
+
+	/// All rectangles.
+	PrimitiveStore<RectCoordinates> mRects;
+
+	/// All ellipses.
+	PrimitiveStore<EllipseCoordinates> mEllipses;
+
+	/// All arcs.
+	PrimitiveStore<ArcCoordinates> mArcs;
+
+	/// Image with all primitives drawn on transparent background.
+	QImage mImage;
+
+	/// Current pen color.
+	QColor mCurrentPenColor;
+
+	/// Current pen width.
+	int mCurrentPenWidth;
+
+	/// Sequence number of the next added primitive.
+	quint64 mNextSequence;
+};
+
+}
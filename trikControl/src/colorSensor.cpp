@@ -20,8 +20,9 @@
 
 using namespace trikControl;
 
-ColorSensor::ColorSensor(QString const &script, QString const &inputFile, QString const &outputFile, int m, int n)
-	: mColorSensorWorker(new ColorSensorWorker(script, inputFile, outputFile, m, n))
+ColorSensor::ColorSensor(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+		, QString const &outputFile, int m, int n)
+	: mColorSensorWorker(new ColorSensorWorker(backend, script, inputFile, outputFile, m, n))
 {
 	mColorSensorWorker->moveToThread(&mWorkerThread);
 	mWorkerThread.start();
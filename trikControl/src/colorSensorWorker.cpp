@@ -18,9 +18,9 @@
 
 using namespace trikControl;
 
-ColorSensorWorker::ColorSensorWorker(QString const &script, QString const &inputFile, QString const &outputFile
-		, int m, int n)
-	: AbstractVirtualSensorWorker(script, inputFile, outputFile)
+ColorSensorWorker::ColorSensorWorker(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+		, QString const &outputFile, int m, int n)
+	: AbstractVirtualSensorWorker(backend, script, inputFile, outputFile)
 {
 	/// @todo Throw an exception here.
 	Q_ASSERT(m > 0);
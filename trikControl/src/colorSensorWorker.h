@@ -23,6 +23,8 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+
 /// Worker object that processes color sensor output and updates stored reading. Meant to be executed in separate
 /// thread.
 class ColorSensorWorker : public AbstractVirtualSensorWorker
@@ -31,12 +33,14 @@ class ColorSensorWorker : public AbstractVirtualSensorWorker
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides connection to a sensor.
 	/// @param script - file name of a scrit used to start or stop a sensor.
 	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
 	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
 	/// @param m - horisontal dimension of a sensor.
 	/// @param n - vertical dimension of a sensor.
-	ColorSensorWorker(QString const &script, QString const &inputFile, QString const &outputFile, int m, int n);
+	ColorSensorWorker(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+			, QString const &outputFile, int m, int n);
 
 	~ColorSensorWorker() override;
 
@@ -0,0 +1,137 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "compiledConfig.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QXmlStreamReader>
+#include <QtCore/QDebug>
+
+using namespace trikControl;
+
+QString CompiledConfig::Element::attribute(QString const &attributeName, QString const &defaultValue) const
+{
+	return attributes.value(attributeName, defaultValue);
+}
+
+CompiledConfig CompiledConfig::load(QString const &xmlFile)
+{
+	QFile file(xmlFile);
+	if (!file.open(QIODevice::ReadOnly)) {
+		qDebug() << "Failed to open config.xml for reading";
+		throw "Failed to open config.xml for reading";
+	}
+
+	return compile(file.readAll());
+}
+
+CompiledConfig CompiledConfig::compile(QByteArray const &xml)
+{
+	CompiledConfig result;
+	QXmlStreamReader reader(xml);
+
+	// Indexes of elements that are started but not finished yet, current element is the last one.
+	QVector<int> openElements;
+
+	while (!reader.atEnd()) {
+		switch (reader.readNext()) {
+		case QXmlStreamReader::StartElement: {
+			Element element;
+			element.name = reader.name().toString();
+			element.parent = openElements.isEmpty() ? -1 : openElements.last();
+			for (QXmlStreamAttribute const &attribute : reader.attributes()) {
+				element.attributes.insert(attribute.name().toString(), attribute.value().toString());
+			}
+
+			openElements.append(result.mElements.size());
+			result.mElements.append(element);
+			break;
+		}
+		case QXmlStreamReader::EndElement:
+			openElements.removeLast();
+			break;
+		case QXmlStreamReader::Characters:
+			if (!openElements.isEmpty() && !reader.isWhitespace()) {
+				result.mElements[openElements.last()].text += reader.text().toString();
+			}
+
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (reader.hasError()) {
+		qDebug() << "config.xml parsing failed:" << reader.errorString() << "at line" << reader.lineNumber();
+		throw "config.xml parsing failed";
+	}
+
+	result.index();
+	return result;
+}
+
+bool CompiledConfig::contains(QString const &name) const
+{
+	return mFirstElements.contains(name);
+}
+
+int CompiledConfig::count(QString const &name) const
+{
+	return mCounts.value(name);
+}
+
+CompiledConfig::Element const &CompiledConfig::element(QString const &name) const
+{
+	static Element const empty;
+
+	auto const first = mFirstElements.constFind(name);
+	return first == mFirstElements.constEnd() ? empty : mElements[first.value()];
+}
+
+QList<CompiledConfig::Element const *> CompiledConfig::children(QString const &name) const
+{
+	QList<Element const *> result;
+
+	auto const first = mFirstElements.constFind(name);
+	if (first == mFirstElements.constEnd()) {
+		return result;
+	}
+
+	for (int i = first.value() + 1; i < mElements.size(); ++i) {
+		if (mElements[i].parent == first.value()) {
+			result.append(&mElements[i]);
+		}
+	}
+
+	return result;
+}
+
+void CompiledConfig::index()
+{
+	mFirstElements.clear();
+	mCounts.clear();
+
+	for (int i = 0; i < mElements.size(); ++i) {
+		if (mElements[i].parent < 0) {
+			continue;
+		}
+
+		QString const &name = mElements[i].name;
+		if (!mFirstElements.contains(name)) {
+			mFirstElements.insert(name, i);
+		}
+
+		++mCounts[name];
+	}
+}
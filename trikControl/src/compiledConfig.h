@@ -0,0 +1,80 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace trikControl {
+
+/// Flat representation of config.xml: all elements in document order with their attributes and text. Compiled from
+/// XML by one pass of a streaming parser, without building DOM tree.
+class CompiledConfig
+{
+public:
+	/// Config element.
+	struct Element {
+		/// Returns value of an attribute with given name or given default value if there is no such attribute.
+		QString attribute(QString const &attributeName, QString const &defaultValue = QString()) const;
+
+		/// Tag name.
+		QString name;
+
+		/// Index of a parent element in a list of elements, -1 for root element.
+		int parent = -1;
+
+		QHash<QString, QString> attributes;
+
+		/// Text directly inside the element.
+		QString text;
+	};
+
+	/// Reads and compiles given XML file. Throws an exception if XML can not be read or parsed.
+	/// @param xmlFile - path to config.xml.
+	static CompiledConfig load(QString const &xmlFile);
+
+	/// Compiles config from XML contents. Throws an exception if XML can not be parsed.
+	static CompiledConfig compile(QByteArray const &xml);
+
+	/// Returns true if there is at least one element with given name below root element.
+	bool contains(QString const &name) const;
+
+	/// Returns number of elements with given name below root element.
+	int count(QString const &name) const;
+
+	/// Returns first element with given name below root element, or element without attributes if there is no such
+	/// element.
+	Element const &element(QString const &name) const;
+
+	/// Returns direct children of the first element with given name.
+	QList<Element const *> children(QString const &name) const;
+
+private:
+	/// Builds index of elements by name.
+	void index();
+
+	QVector<Element> mElements;
+
+	/// Index of the first element with given name.
+	QHash<QString, int> mFirstElements;
+
+	/// Number of elements with given name.
+	QHash<QString, int> mCounts;
+};
+
+}
@@ -14,57 +14,177 @@
 
 #include "configurer.h"
 
-#include <QtXml/QDomDocument>
-#include <QtCore/QFile>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <cstdio>
+#include <type_traits>
+
+#include <trikKernel/metricsRegistry.h>
+#include <trikKernel/scopedTimer.h>
+
+#include "compiledConfig.h"
 
 using namespace trikControl;
 
+/// Identifies config cache file, "TRKC".
+static quint32 const cacheMagic = 0x54524b43;
+
+/// Version of cache format, shall be increased when the set of serialized parameters changes.
+static quint32 const cacheVersion = 2;
+
+/// Minimal time in milliseconds between modification of config.xml and writing of cache for it.
+static qint64 const racyInterval = 1000;
+
+namespace {
+
+/// Writes parameters passed by Configurer::serialize() to a stream.
+class CacheWriter
+{
+public:
+	explicit CacheWriter(QDataStream &stream)
+		: mStream(stream)
+	{
+	}
+
+	template<typename T>
+	CacheWriter &operator ()(T &value)
+	{
+		write(value, std::is_enum<T>());
+		return *this;
+	}
+
+	/// Writes hash, values are written by given function that passes their fields to an archive.
+	template<typename T, typename Fields>
+	void hash(QHash<QString, T> &hash, Fields const &fields)
+	{
+		mStream << static_cast<qint32>(hash.size());
+		for (auto i = hash.begin(); i != hash.end(); ++i) {
+			mStream << i.key();
+			fields(*this, i.value());
+		}
+	}
+
+private:
+	template<typename T>
+	void write(T &value, std::false_type)
+	{
+		mStream << value;
+	}
+
+	template<typename T>
+	void write(T &value, std::true_type)
+	{
+		mStream << static_cast<qint32>(value);
+	}
+
+	QDataStream &mStream;
+};
+
+/// Reads parameters passed by Configurer::serialize() from a stream.
+class CacheReader
+{
+public:
+	explicit CacheReader(QDataStream &stream)
+		: mStream(stream)
+	{
+	}
+
+	template<typename T>
+	CacheReader &operator ()(T &value)
+	{
+		read(value, std::is_enum<T>());
+		return *this;
+	}
+
+	/// Reads hash, values are read by given function that passes their fields to an archive.
+	template<typename T, typename Fields>
+	void hash(QHash<QString, T> &hash, Fields const &fields)
+	{
+		qint32 size = 0;
+		mStream >> size;
+
+		hash.clear();
+		for (int i = 0; i < size && mStream.status() == QDataStream::Ok; ++i) {
+			QString key;
+			T value = T();
+			mStream >> key;
+			fields(*this, value);
+			hash.insert(key, value);
+		}
+	}
+
+private:
+	template<typename T>
+	void read(T &value, std::false_type)
+	{
+		mStream >> value;
+	}
+
+	template<typename T>
+	void read(T &value, std::true_type)
+	{
+		qint32 rawValue = 0;
+		mStream >> rawValue;
+		value = static_cast<T>(rawValue);
+	}
+
+	QDataStream &mStream;
+};
+
+}
+
 Configurer::Configurer(QString const &configFilePath)
 	: mI2cDeviceId(0)
 	, mLedOn(0)
 	, mLedOff(0)
 	, mGamepadPort(0)
 {
-	QDomDocument config("config");
+	static trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("configurer.loadLatencyUs");
+	static trikKernel::Counter &cacheHits = trikKernel::MetricsRegistry::counter("configurer.cacheHits");
+	trikKernel::ScopedTimer timer(latency);
 
-	QFile file(configFilePath + "config.xml");
-	if (!file.open(QIODevice::ReadOnly)) {
-		qDebug() << "Failed to open config.xml for reading";
-		throw "Failed to open config.xml for reading";
-	} if (!config.setContent(&file)) {
-		file.close();
-		qDebug() << "config.xml parsing failed";
-		throw "config.xml parsing failed";
+	QString const xmlFile = configFilePath + "config.xml";
+	QString const cacheFile = xmlFile + ".cache";
+	QFileInfo const xml(xmlFile);
+	if (xml.isFile() && loadCache(cacheFile, xml)) {
+		cacheHits.increment();
+		return;
 	}
 
-	file.close();
-
-	QDomElement const root = config.documentElement();
-
-	loadInit(root);
-	loadServoMotors(root);
-	loadPwmCaptures(root);
-	loadPowerMotors(root);
-	loadAnalogSensors(root);
-	loadEncoders(root);
-	loadDigitalSensors(root);
-	loadServoMotorTypes(root);
-	loadAnalogSensorTypes(root);
-	loadDigitalSensorTypes(root);
-	loadEncoderTypes(root);
-	loadSound(root);
-
-	mAccelerometer = loadSensor3d(root, "accelerometer");
-	mGyroscope = loadSensor3d(root, "gyroscope");
-
-	loadI2c(root);
-	loadLed(root);
-	loadKeys(root);
-	loadGamepadPort(root);
-	mLineSensor = loadVirtualSensor(root, "lineSensor");
-	mObjectSensor = loadVirtualSensor(root, "objectSensor");
-	mMxNColorSensor = loadVirtualSensor(root, "colorSensor");
+	CompiledConfig const config = CompiledConfig::load(xmlFile);
+
+	loadInit(config);
+	loadServoMotors(config);
+	loadPwmCaptures(config);
+	loadPowerMotors(config);
+	loadAnalogSensors(config);
+	loadEncoders(config);
+	loadDigitalSensors(config);
+	loadServoMotorTypes(config);
+	loadAnalogSensorTypes(config);
+	loadDigitalSensorTypes(config);
+	loadEncoderTypes(config);
+	loadSound(config);
+
+	mAccelerometer = loadSensor3d(config, "accelerometer");
+	mGyroscope = loadSensor3d(config, "gyroscope");
+
+	loadI2c(config);
+	loadLed(config);
+	loadKeys(config);
+	loadGamepadPort(config);
+	mLineSensor = loadVirtualSensor(config, "lineSensor");
+	mObjectSensor = loadVirtualSensor(config, "objectSensor");
+	mMxNColorSensor = loadVirtualSensor(config, "colorSensor");
+	loadDeviceBackend(config);
+	loadDisplay(config);
+
+	saveCache(cacheFile, xml);
 }
 
 QString Configurer::initScript() const
@@ -347,6 +467,11 @@ int Configurer::gamepadPort() const
 	return mGamepadPort;
 }
 
+QString Configurer::gamepadTransport() const
+{
+	return mGamepadTransport;
+}
+
 bool Configurer::hasLineSensor() const
 {
 	return mLineSensor.enabled;
@@ -427,346 +552,290 @@ int Configurer::colorSensorN() const
 	return mColorSensorN;
 }
 
-void Configurer::loadInit(QDomElement const &root)
+bool Configurer::isSimulator() const
+{
+	return mIsSimulator;
+}
+
+int Configurer::simulatorI2cLatency() const
 {
-	if (root.elementsByTagName("initScript").isEmpty()) {
+	return mSimulatorI2cLatency;
+}
+
+int Configurer::simulatorDeviceFileLatency() const
+{
+	return mSimulatorDeviceFileLatency;
+}
+
+double Configurer::simulatorMotorMaxSpeed() const
+{
+	return mSimulatorMotorMaxSpeed;
+}
+
+double Configurer::simulatorMotorTimeConstant() const
+{
+	return mSimulatorMotorTimeConstant;
+}
+
+QString Configurer::displayRenderer() const
+{
+	return mDisplayRenderer;
+}
+
+QString Configurer::framebufferDevice() const
+{
+	return mFramebufferDevice;
+}
+
+void Configurer::loadInit(CompiledConfig const &config)
+{
+	if (!config.contains("initScript")) {
 		qDebug() << "config.xml does not have <initScript> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const init = root.elementsByTagName("initScript").at(0).toElement();
-	mInitScript = init.text();
+	mInitScript = config.element("initScript").text;
 }
 
-void Configurer::loadServoMotors(QDomElement const &root)
+void Configurer::loadServoMotors(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("servoMotors").isEmpty()) {
+	if (!config.contains("servoMotors")) {
 		qDebug() << "config.xml does not have <servoMotors> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const servoMotors = root.elementsByTagName("servoMotors").at(0).toElement();
-	for (QDomNode child = servoMotors.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		if (childElement.nodeName() != "servoMotor") {
+	for (CompiledConfig::Element const *childElement : config.children("servoMotors")) {
+		if (childElement->name != "servoMotor") {
 			qDebug() << "Malformed <servoMotors> tag";
 			throw "config.xml parsing failed";
 		}
 
 		ServoMotorMapping mapping;
-		mapping.port = childElement.attribute("port");
-		mapping.deviceFile = childElement.attribute("deviceFile");
-		mapping.periodFile = childElement.attribute("periodFile");
-		mapping.period = childElement.attribute("period").toInt();
-		mapping.defaultType = childElement.attribute("defaultType");
-		mapping.invert = childElement.attribute("invert") == "true";
+		mapping.port = childElement->attribute("port");
+		mapping.deviceFile = childElement->attribute("deviceFile");
+		mapping.periodFile = childElement->attribute("periodFile");
+		mapping.period = childElement->attribute("period").toInt();
+		mapping.defaultType = childElement->attribute("defaultType");
+		mapping.invert = childElement->attribute("invert") == "true";
 
 		mServoMotorMappings.insert(mapping.port, mapping);
 	}
 }
 
-void Configurer::loadPwmCaptures(QDomElement const &root)
+void Configurer::loadPwmCaptures(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("pwmCaptures").isEmpty()) {
+	if (!config.contains("pwmCaptures")) {
 		qDebug() << "config.xml does not have <pwmCaptures> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const pwmCaptures = root.elementsByTagName("pwmCaptures").at(0).toElement();
-	for (QDomNode child = pwmCaptures.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		if (childElement.nodeName() != "capture") {
+	for (CompiledConfig::Element const *childElement : config.children("pwmCaptures")) {
+		if (childElement->name != "capture") {
 			qDebug() << "Malformed <pwmCaptures> tag";
 			throw "config.xml parsing failed";
 		}
 
 		PwmCaptureMapping mapping;
-		mapping.port = childElement.attribute("port");
-		mapping.frequencyFile = childElement.attribute("frequencyFile");
-		mapping.dutyFile = childElement.attribute("dutyFile");
+		mapping.port = childElement->attribute("port");
+		mapping.frequencyFile = childElement->attribute("frequencyFile");
+		mapping.dutyFile = childElement->attribute("dutyFile");
 
 		mPwmCaptureMappings.insert(mapping.port, mapping);
 	}
 }
 
-void Configurer::loadPowerMotors(QDomElement const &root)
+void Configurer::loadPowerMotors(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("powerMotors").isEmpty()) {
+	if (!config.contains("powerMotors")) {
 		qDebug() << "config.xml does not have <powerMotors> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const powerMotors = root.elementsByTagName("powerMotors").at(0).toElement();
-	for (QDomNode child = powerMotors.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		if (childElement.nodeName() != "powerMotor") {
+	for (CompiledConfig::Element const *childElement : config.children("powerMotors")) {
+		if (childElement->name != "powerMotor") {
 			qDebug() << "Malformed <powerMotors> tag";
 			throw "config.xml parsing failed";
 		}
 
 		PowerMotorMapping mapping;
-		mapping.port = childElement.attribute("port");
-		mapping.i2cCommandNumber = childElement.attribute("i2cCommandNumber").toInt(NULL, 0);
-		mapping.invert = childElement.attribute("invert") == "true";
+		mapping.port = childElement->attribute("port");
+		mapping.i2cCommandNumber = childElement->attribute("i2cCommandNumber").toInt(NULL, 0);
+		mapping.invert = childElement->attribute("invert") == "true";
 
 		mPowerMotorMappings.insert(mapping.port, mapping);
 	}
 }
 
-void Configurer::loadAnalogSensors(QDomElement const &root)
+void Configurer::loadAnalogSensors(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("analogSensors").isEmpty()) {
+	if (!config.contains("analogSensors")) {
 		qDebug() << "config.xml does not have <analogSensors> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const analogSensors = root.elementsByTagName("analogSensors").at(0).toElement();
-	for (QDomNode child = analogSensors.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		if (childElement.nodeName() != "analogSensor") {
+	for (CompiledConfig::Element const *childElement : config.children("analogSensors")) {
+		if (childElement->name != "analogSensor") {
 			qDebug() << "Malformed <analogSensors> tag";
 			throw "config.xml parsing failed";
 		}
 
 		AnalogSensorMapping mapping;
-		mapping.port = childElement.attribute("port");
-		mapping.i2cCommandNumber = childElement.attribute("i2cCommandNumber").toInt(NULL, 0);
-		mapping.defaultType = childElement.attribute("defaultType");
+		mapping.port = childElement->attribute("port");
+		mapping.i2cCommandNumber = childElement->attribute("i2cCommandNumber").toInt(NULL, 0);
+		mapping.defaultType = childElement->attribute("defaultType");
 
 		mAnalogSensorMappings.insert(mapping.port, mapping);
 	}
 }
 
-void Configurer::loadEncoders(QDomElement const &root)
+void Configurer::loadEncoders(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("encoders").isEmpty()) {
+	if (!config.contains("encoders")) {
 		qDebug() << "config.xml does not have <encoders> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const encoders = root.elementsByTagName("encoders").at(0).toElement();
-	for (QDomNode child = encoders.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		if (childElement.nodeName() != "encoder") {
+	for (CompiledConfig::Element const *childElement : config.children("encoders")) {
+		if (childElement->name != "encoder") {
 			qDebug() << "Malformed <encoders> tag";
 			throw "config.xml parsing failed";
 		}
 
 		EncoderMapping mapping;
-		mapping.port = childElement.attribute("port");
-		mapping.i2cCommandNumber = childElement.attribute("i2cCommandNumber").toInt(NULL, 0);
-		mapping.defaultType = childElement.attribute("defaultType");
+		mapping.port = childElement->attribute("port");
+		mapping.i2cCommandNumber = childElement->attribute("i2cCommandNumber").toInt(NULL, 0);
+		mapping.defaultType = childElement->attribute("defaultType");
 
 		mEncoderMappings.insert(mapping.port, mapping);
 	}
 }
 
-void Configurer::loadDigitalSensors(QDomElement const &root)
+void Configurer::loadDigitalSensors(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("digitalSensors").isEmpty()) {
+	if (!config.contains("digitalSensors")) {
 		qDebug() << "config.xml does not have <digitalSensors> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const digitalSensors = root.elementsByTagName("digitalSensors").at(0).toElement();
-	for (QDomNode child = digitalSensors.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		if (childElement.nodeName() != "digitalSensor") {
+	for (CompiledConfig::Element const *childElement : config.children("digitalSensors")) {
+		if (childElement->name != "digitalSensor") {
 			continue;
 		}
 
 		DigitalSensorMapping mapping;
-		mapping.port = childElement.attribute("port");
-		mapping.deviceFile = childElement.attribute("deviceFile");
-		mapping.defaultType = childElement.attribute("defaultType");
+		mapping.port = childElement->attribute("port");
+		mapping.deviceFile = childElement->attribute("deviceFile");
+		mapping.defaultType = childElement->attribute("defaultType");
 
 		mDigitalSensorMappings.insert(mapping.port, mapping);
 	}
 }
 
-void Configurer::loadServoMotorTypes(QDomElement const &root)
+void Configurer::loadServoMotorTypes(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("servoMotorTypes").isEmpty()) {
+	if (!config.contains("servoMotorTypes")) {
 		qDebug() << "config.xml does not have <servoMotorTypes> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const servoMotorTypes = root.elementsByTagName("servoMotorTypes").at(0).toElement();
-	for (QDomNode child = servoMotorTypes.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		QString const typeName = childElement.nodeName();
+	for (CompiledConfig::Element const *childElement : config.children("servoMotorTypes")) {
+		QString const typeName = childElement->name;
 
 		ServoMotorType servoMotorType;
-		servoMotorType.min = childElement.attribute("min").toInt();
-		servoMotorType.max = childElement.attribute("max").toInt();
-		servoMotorType.zero = childElement.attribute("zero").toInt();
-		servoMotorType.stop = childElement.attribute("stop").toInt();
-		servoMotorType.type = childElement.attribute("type") != "angular" ? continiousRotation : angular;
+		servoMotorType.min = childElement->attribute("min").toInt();
+		servoMotorType.max = childElement->attribute("max").toInt();
+		servoMotorType.zero = childElement->attribute("zero").toInt();
+		servoMotorType.stop = childElement->attribute("stop").toInt();
+		servoMotorType.type = childElement->attribute("type") != "angular" ? continiousRotation : angular;
 
 		mServoMotorTypes.insert(typeName, servoMotorType);
 	}
 }
 
-void Configurer::loadAnalogSensorTypes(const QDomElement &root)
+void Configurer::loadAnalogSensorTypes(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("analogSensorTypes").isEmpty()) {
+	if (!config.contains("analogSensorTypes")) {
 		qDebug() << "config.xml does not have <analogSensorTypes> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const analogSensorTypes = root.elementsByTagName("analogSensorTypes").at(0).toElement();
-	for (QDomNode child = analogSensorTypes.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		QString const typeName = childElement.nodeName();
+	for (CompiledConfig::Element const *childElement : config.children("analogSensorTypes")) {
+		QString const typeName = childElement->name;
 
 		AnalogSensorType analogSensorType;
-		analogSensorType.rawValue1 = childElement.attribute("rawValue1").toInt();
-		analogSensorType.rawValue2 = childElement.attribute("rawValue2").toInt();
-		analogSensorType.normalizedValue1 = childElement.attribute("normalizedValue1").toInt();
-		analogSensorType.normalizedValue2 = childElement.attribute("normalizedValue2").toInt();
+		analogSensorType.rawValue1 = childElement->attribute("rawValue1").toInt();
+		analogSensorType.rawValue2 = childElement->attribute("rawValue2").toInt();
+		analogSensorType.normalizedValue1 = childElement->attribute("normalizedValue1").toInt();
+		analogSensorType.normalizedValue2 = childElement->attribute("normalizedValue2").toInt();
 
 		mAnalogSensorTypes.insert(typeName, analogSensorType);
 	}
 }
 
-void Configurer::loadDigitalSensorTypes(QDomElement const &root)
+void Configurer::loadDigitalSensorTypes(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("digitalSensorTypes").isEmpty()) {
+	if (!config.contains("digitalSensorTypes")) {
 		qDebug() << "config.xml does not have <digitalSensorTypes> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const digitalSensorTypes = root.elementsByTagName("digitalSensorTypes").at(0).toElement();
-	for (QDomNode child = digitalSensorTypes.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		QString const typeName = childElement.nodeName();
+	for (CompiledConfig::Element const *childElement : config.children("digitalSensorTypes")) {
+		QString const typeName = childElement->name;
 
 		DigitalSensorType digitalSensorType;
-		digitalSensorType.min = childElement.attribute("min").toInt();
-		digitalSensorType.max = childElement.attribute("max").toInt();
+		digitalSensorType.min = childElement->attribute("min").toInt();
+		digitalSensorType.max = childElement->attribute("max").toInt();
 
 		mDigitalSensorTypes.insert(typeName, digitalSensorType);
 	}
 }
 
-void Configurer::loadEncoderTypes(const QDomElement &root)
+void Configurer::loadEncoderTypes(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("encoderTypes").isEmpty()) {
+	if (!config.contains("encoderTypes")) {
 		qDebug() << "config.xml does not have <encoderTypes> tag";
 		throw "config.xml parsing failed";
 	}
 
-	QDomElement const encoderTypes = root.elementsByTagName("encoderTypes").at(0).toElement();
-	for (QDomNode child = encoderTypes.firstChild()
-			; !child.isNull()
-			; child = child.nextSibling())
-	{
-		if (!child.isElement()) {
-			continue;
-		}
-
-		QDomElement const childElement = child.toElement();
-		QString const typeName = childElement.nodeName();
+	for (CompiledConfig::Element const *childElement : config.children("encoderTypes")) {
+		QString const typeName = childElement->name;
 
 		EncoderType encoderType;
-		encoderType.rawToDegrees = childElement.attribute("rawToDegrees").toDouble();
+		encoderType.rawToDegrees = childElement->attribute("rawToDegrees").toDouble();
 		mEncoderTypes.insert(typeName, encoderType);
 	}
 }
 
-void Configurer::loadSound(QDomElement const &root)
+void Configurer::loadSound(CompiledConfig const &config)
 {
-	if (root.elementsByTagName("playWavFile").isEmpty()) {
+	if (!config.contains("playWavFile")) {
 		qDebug() << "config.xml does not have <playWavFile> tag";
 		throw "config.xml parsing failed";
 	}
 
-	mPlayWavFileCommand = root.elementsByTagName("playWavFile").at(0).toElement().attribute("command");
+	mPlayWavFileCommand = config.element("playWavFile").attribute("command");
 
-	if (root.elementsByTagName("playMp3File").isEmpty()) {
+	if (!config.contains("playMp3File")) {
 		qDebug() << "config.xml does not have <playMp3File> tag";
 		throw "config.xml parsing failed";
 	}
 
-	mPlayMp3FileCommand = root.elementsByTagName("playMp3File").at(0).toElement().attribute("command");
+	mPlayMp3FileCommand = config.element("playMp3File").attribute("command");
 
 }
 
-Configurer::OnBoardSensor Configurer::loadSensor3d(QDomElement const &root, QString const &tagName)
+Configurer::OnBoardSensor Configurer::loadSensor3d(CompiledConfig const &config, QString const &tagName)
 {
 	OnBoardSensor result;
 
-	if (isEnabled(root, tagName)) {
+	if (isEnabled(config, tagName)) {
 
-		if (root.elementsByTagName(tagName).count() > 1) {
+		if (config.count(tagName) > 1) {
 			qDebug() << "config.xml has too many <" << tagName << "> tags, there shall be exactly one";
 			throw "config.xml parsing failed";
 		}
 
-		QDomElement const sensor = root.elementsByTagName(tagName).at(0).toElement();
+		CompiledConfig::Element const &sensor = config.element(tagName);
 
 		result.min = sensor.attribute("min").toInt();
 		result.max = sensor.attribute("max").toInt();
@@ -777,41 +846,75 @@ Configurer::OnBoardSensor Configurer::loadSensor3d(QDomElement const &root, QStr
 	return result;
 }
 
-void Configurer::loadI2c(QDomElement const &root)
+void Configurer::loadI2c(CompiledConfig const &config)
 {
-	mI2cPath = root.elementsByTagName("i2c").at(0).toElement().attribute("path");
-	mI2cDeviceId = root.elementsByTagName("i2c").at(0).toElement().attribute("deviceId").toInt(NULL, 0);
+	mI2cPath = config.element("i2c").attribute("path");
+	mI2cDeviceId = config.element("i2c").attribute("deviceId").toInt(NULL, 0);
 }
 
-void Configurer::loadLed(QDomElement const &root)
+void Configurer::loadLed(CompiledConfig const &config)
 {
-	QDomElement led = root.elementsByTagName("led").at(0).toElement();
+	CompiledConfig::Element const &led = config.element("led");
 	mLedRedDeviceFile = led.attribute("red");
 	mLedGreenDeviceFile = led.attribute("green");
 	mLedOn = led.attribute("on").toInt(NULL, 0);
 	mLedOff = led.attribute("off").toInt(NULL, 0);
 }
 
-void Configurer::loadKeys(QDomElement const &root)
+void Configurer::loadKeys(CompiledConfig const &config)
 {
-	QDomElement keys = root.elementsByTagName("keys").at(0).toElement();
+	CompiledConfig::Element const &keys = config.element("keys");
 	mKeysDeviceFile = keys.attribute("deviceFile");
 }
 
-void Configurer::loadGamepadPort(QDomElement const &root)
+void Configurer::loadGamepadPort(CompiledConfig const &config)
 {
-	if (isEnabled(root, "gamepad")) {
-		QDomElement gamepad = root.elementsByTagName("gamepad").at(0).toElement();
+	if (isEnabled(config, "gamepad")) {
+		CompiledConfig::Element const &gamepad = config.element("gamepad");
 		mGamepadPort = gamepad.attribute("port").toInt(NULL, 0);
+		mGamepadTransport = gamepad.attribute("transport", mGamepadTransport);
 		mIsGamepadEnabled = true;
 	}
 }
 
-Configurer::VirtualSensor Configurer::loadVirtualSensor(QDomElement const &root, QString const &tagName)
+void Configurer::loadDeviceBackend(CompiledConfig const &config)
+{
+	if (!config.contains("deviceBackend")) {
+		return;
+	}
+
+	CompiledConfig::Element const &deviceBackend = config.element("deviceBackend");
+	QString const type = deviceBackend.attribute("type", "hardware");
+	if (type != "hardware" && type != "simulator") {
+		qDebug() << "Unknown device backend type" << type << ", using hardware";
+		return;
+	}
+
+	mIsSimulator = type == "simulator";
+	mSimulatorI2cLatency = deviceBackend.attribute("i2cLatency", "0").toInt();
+	mSimulatorDeviceFileLatency = deviceBackend.attribute("deviceFileLatency", "0").toInt();
+	mSimulatorMotorMaxSpeed = deviceBackend.attribute("motorMaxSpeed"
+			, QString::number(mSimulatorMotorMaxSpeed)).toDouble();
+	mSimulatorMotorTimeConstant = deviceBackend.attribute("motorTimeConstant"
+			, QString::number(mSimulatorMotorTimeConstant)).toDouble();
+}
+
+void Configurer::loadDisplay(CompiledConfig const &config)
+{
+	if (!config.contains("display")) {
+		return;
+	}
+
+	CompiledConfig::Element const &display = config.element("display");
+	mDisplayRenderer = display.attribute("renderer", mDisplayRenderer);
+	mFramebufferDevice = display.attribute("framebufferDevice", mFramebufferDevice);
+}
+
+Configurer::VirtualSensor Configurer::loadVirtualSensor(CompiledConfig const &config, QString const &tagName)
 {
 	VirtualSensor result;
-	if (isEnabled(root, tagName)) {
-		QDomElement sensorElement = root.elementsByTagName(tagName).at(0).toElement();
+	if (isEnabled(config, tagName)) {
+		CompiledConfig::Element const &sensorElement = config.element(tagName);
 		result.script = sensorElement.attribute("script");
 		result.inFifo = sensorElement.attribute("inputFile");
 		result.outFifo = sensorElement.attribute("outputFile");
@@ -827,8 +930,153 @@ Configurer::VirtualSensor Configurer::loadVirtualSensor(QDomElement const &root,
 	return result;
 }
 
-bool Configurer::isEnabled(QDomElement const &root, QString const &tagName)
+bool Configurer::isEnabled(CompiledConfig const &config, QString const &tagName)
 {
-	return root.elementsByTagName(tagName).size() > 0
-			&& root.elementsByTagName(tagName).at(0).toElement().attribute("disabled") != "true";
+	return config.count(tagName) > 0
+			&& config.element(tagName).attribute("disabled") != "true";
+}
+
+template<typename Archive>
+void Configurer::serialize(Archive &archive)
+{
+	auto const onBoardSensor = [](Archive &archive, OnBoardSensor &sensor) {
+		archive(sensor.min)(sensor.max)(sensor.deviceFile)(sensor.enabled);
+	};
+
+	auto const virtualSensor = [](Archive &archive, VirtualSensor &sensor) {
+		archive(sensor.script)(sensor.inFifo)(sensor.outFifo)(sensor.toleranceFactor)(sensor.enabled);
+	};
+
+	archive.hash(mServoMotorTypes, [](Archive &archive, ServoMotorType &type) {
+		archive(type.min)(type.max)(type.zero)(type.stop)(type.type);
+	});
+
+	archive.hash(mAnalogSensorTypes, [](Archive &archive, AnalogSensorType &type) {
+		archive(type.rawValue1)(type.rawValue2)(type.normalizedValue1)(type.normalizedValue2);
+	});
+
+	archive.hash(mDigitalSensorTypes, [](Archive &archive, DigitalSensorType &type) {
+		archive(type.min)(type.max);
+	});
+
+	archive.hash(mEncoderTypes, [](Archive &archive, EncoderType &type) {
+		archive(type.rawToDegrees);
+	});
+
+	archive.hash(mServoMotorMappings, [](Archive &archive, ServoMotorMapping &mapping) {
+		archive(mapping.port)(mapping.deviceFile)(mapping.periodFile)(mapping.period)(mapping.defaultType)
+				(mapping.invert);
+	});
+
+	archive.hash(mPwmCaptureMappings, [](Archive &archive, PwmCaptureMapping &mapping) {
+		archive(mapping.port)(mapping.frequencyFile)(mapping.dutyFile);
+	});
+
+	archive.hash(mPowerMotorMappings, [](Archive &archive, PowerMotorMapping &mapping) {
+		archive(mapping.port)(mapping.i2cCommandNumber)(mapping.invert);
+	});
+
+	archive.hash(mAnalogSensorMappings, [](Archive &archive, AnalogSensorMapping &mapping) {
+		archive(mapping.port)(mapping.i2cCommandNumber)(mapping.defaultType);
+	});
+
+	archive.hash(mEncoderMappings, [](Archive &archive, EncoderMapping &mapping) {
+		archive(mapping.port)(mapping.i2cCommandNumber)(mapping.defaultType);
+	});
+
+	archive.hash(mDigitalSensorMappings, [](Archive &archive, DigitalSensorMapping &mapping) {
+		archive(mapping.port)(mapping.deviceFile)(mapping.defaultType);
+	});
+
+	onBoardSensor(archive, mAccelerometer);
+	onBoardSensor(archive, mGyroscope);
+
+	archive(mInitScript)(mPlayWavFileCommand)(mPlayMp3FileCommand)(mI2cPath)(mI2cDeviceId);
+	archive(mLedRedDeviceFile)(mLedGreenDeviceFile)(mKeysDeviceFile)(mLedOn)(mLedOff);
+	archive(mGamepadPort)(mGamepadTransport)(mIsGamepadEnabled);
+
+	virtualSensor(archive, mLineSensor);
+	virtualSensor(archive, mObjectSensor);
+	virtualSensor(archive, mMxNColorSensor);
+	archive(mColorSensorM)(mColorSensorN);
+
+	archive(mIsSimulator)(mSimulatorI2cLatency)(mSimulatorDeviceFileLatency)(mSimulatorMotorMaxSpeed)
+			(mSimulatorMotorTimeConstant);
+
+	archive(mDisplayRenderer)(mFramebufferDevice);
+}
+
+bool Configurer::loadCache(QString const &cacheFile, QFileInfo const &xml)
+{
+	QFile cache(cacheFile);
+	if (!cache.open(QIODevice::ReadOnly) || cache.size() <= 0) {
+		return false;
+	}
+
+	int const size = static_cast<int>(cache.size());
+	uchar * const data = cache.map(0, size);
+	if (data == nullptr) {
+		return false;
+	}
+
+	QByteArray const mapped = QByteArray::fromRawData(reinterpret_cast<char const *>(data), size);
+	QDataStream stream(mapped);
+	stream.setVersion(QDataStream::Qt_4_8);
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	qint64 xmlSize = -1;
+	qint64 xmlLastModified = -1;
+	stream >> magic >> version >> xmlSize >> xmlLastModified;
+
+	bool loaded = false;
+	if (magic == cacheMagic && version == cacheVersion && xmlSize == xml.size()
+			&& xmlLastModified == xml.lastModified().toMSecsSinceEpoch())
+	{
+		// Parameters are read into a separate object, so a truncated cache does not leave this one half-filled.
+		Configurer cached;
+		CacheReader reader(stream);
+		cached.serialize(reader);
+		if (stream.status() == QDataStream::Ok && stream.atEnd()) {
+			*this = cached;
+			loaded = true;
+		}
+	}
+
+	cache.unmap(data);
+	return loaded;
+}
+
+void Configurer::saveCache(QString const &cacheFile, QFileInfo const &xml) const
+{
+	// Size and modification time stay the same if config.xml is edited again within timestamp granularity, so config
+	// that was modified just now is not cached.
+	if (xml.lastModified().msecsTo(QDateTime::currentDateTime()) < racyInterval) {
+		return;
+	}
+
+	QByteArray encoded;
+	QDataStream stream(&encoded, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_4_8);
+	stream << cacheMagic << cacheVersion << xml.size() << xml.lastModified().toMSecsSinceEpoch();
+
+	CacheWriter writer(stream);
+	const_cast<Configurer *>(this)->serialize(writer);
+
+	// Several programs may start at once, so each writes its own temporary file and then atomically replaces cache.
+	QFile temporary(cacheFile + "." + QString::number(QCoreApplication::applicationPid()));
+	if (!temporary.open(QIODevice::WriteOnly | QIODevice::Truncate) || temporary.write(encoded) != encoded.size()) {
+		qDebug() << "Failed to write config cache" << cacheFile;
+		temporary.remove();
+		return;
+	}
+
+	temporary.close();
+
+	QByteArray const source = QFile::encodeName(temporary.fileName());
+	QByteArray const target = QFile::encodeName(cacheFile);
+	if (std::rename(source.constData(), target.constData()) != 0) {
+		qDebug() << "Failed to replace config cache" << cacheFile;
+		temporary.remove();
+	}
 }
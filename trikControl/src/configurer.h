@@ -19,11 +19,15 @@
 #include <QtCore/QStringList>
 #include <QtCore/QHash>
 
-class QDomElement;
+class QFileInfo;
 
 namespace trikControl {
 
-/// Parses config file and holds information about various configuration parameters.
+class CompiledConfig;
+
+/// Parses config file and holds information about various configuration parameters. Resolved parameters are saved
+/// into config.xml.cache next to config.xml and are loaded from there while size and modification time of config.xml
+/// stay the same, so config.xml is not read at all on most starts.
 class Configurer {
 public:
 	/// Constructor
@@ -151,6 +155,8 @@ public:
 
 	int gamepadPort() const;
 
+	QString gamepadTransport() const;
+
 	bool hasLineSensor() const;
 
 	QString lineSensorScript() const;
@@ -183,7 +189,30 @@ public:
 
 	int colorSensorN() const;
 
+	/// Returns true if brick shall work with simulated devices instead of real hardware.
+	bool isSimulator() const;
+
+	/// Returns duration of simulated I2C transaction in microseconds.
+	int simulatorI2cLatency() const;
+
+	/// Returns duration of simulated device file access in microseconds.
+	int simulatorDeviceFileLatency() const;
+
+	/// Returns speed of simulated power motor at full power in encoder ticks per second.
+	double simulatorMotorMaxSpeed() const;
+
+	/// Returns time constant of simulated power motor in seconds.
+	double simulatorMotorTimeConstant() const;
+
+	/// Returns type of display renderer, "widget", "framebuffer" or "memory".
+	QString displayRenderer() const;
+
+	/// Returns framebuffer device file used by "framebuffer" display renderer.
+	QString framebufferDevice() const;
+
 private:
+	Configurer() = default;
+
 	enum ServoType {
 		angular
 		, continiousRotation
@@ -267,26 +296,40 @@ private:
 		bool enabled = false;
 	};
 
-	void loadInit(QDomElement const &root);
-	void loadServoMotors(QDomElement const &root);
-	void loadPwmCaptures(QDomElement const &root);
-	void loadPowerMotors(QDomElement const &root);
-	void loadAnalogSensors(QDomElement const &root);
-	void loadEncoders(QDomElement const &root);
-	void loadDigitalSensors(QDomElement const &root);
-	void loadServoMotorTypes(QDomElement const &root);
-	void loadAnalogSensorTypes(QDomElement const &root);
-	void loadDigitalSensorTypes(QDomElement const &root);
-	void loadEncoderTypes(QDomElement const &root);
-	void loadSound(QDomElement const &root);
-	static OnBoardSensor loadSensor3d(QDomElement const &root, QString const &tagName);
-	void loadI2c(QDomElement const &root);
-	void loadLed(QDomElement const &root);
-	void loadKeys(QDomElement const &root);
-	void loadGamepadPort(QDomElement const &root);
-	VirtualSensor loadVirtualSensor(QDomElement const &root, QString const &tagName);
-
-	static bool isEnabled(QDomElement const &root, QString const &tagName);
+	void loadInit(CompiledConfig const &config);
+	void loadServoMotors(CompiledConfig const &config);
+	void loadPwmCaptures(CompiledConfig const &config);
+	void loadPowerMotors(CompiledConfig const &config);
+	void loadAnalogSensors(CompiledConfig const &config);
+	void loadEncoders(CompiledConfig const &config);
+	void loadDigitalSensors(CompiledConfig const &config);
+	void loadServoMotorTypes(CompiledConfig const &config);
+	void loadAnalogSensorTypes(CompiledConfig const &config);
+	void loadDigitalSensorTypes(CompiledConfig const &config);
+	void loadEncoderTypes(CompiledConfig const &config);
+	void loadSound(CompiledConfig const &config);
+	static OnBoardSensor loadSensor3d(CompiledConfig const &config, QString const &tagName);
+	void loadI2c(CompiledConfig const &config);
+	void loadLed(CompiledConfig const &config);
+	void loadKeys(CompiledConfig const &config);
+	void loadGamepadPort(CompiledConfig const &config);
+	void loadDeviceBackend(CompiledConfig const &config);
+	void loadDisplay(CompiledConfig const &config);
+	VirtualSensor loadVirtualSensor(CompiledConfig const &config, QString const &tagName);
+
+	static bool isEnabled(CompiledConfig const &config, QString const &tagName);
+
+	/// Loads resolved parameters from cache file. Returns false if there is no cache, it is written for another
+	/// version of config.xml or it is corrupted, in which case this object is left unchanged.
+	bool loadCache(QString const &cacheFile, QFileInfo const &xml);
+
+	/// Saves resolved parameters into cache file. Failure to write cache is not an error.
+	void saveCache(QString const &cacheFile, QFileInfo const &xml) const;
+
+	/// Passes every resolved parameter to a given archive, which writes it to cache or reads it from cache. Cache
+	/// version in configurer.cpp shall be increased when a parameter is added here.
+	template<typename Archive>
+	void serialize(Archive &archive);
 
 	QHash<QString, ServoMotorType> mServoMotorTypes;
 	QHash<QString, AnalogSensorType> mAnalogSensorTypes;
@@ -315,6 +358,7 @@ private:
 	int mLedOff = 0;
 
 	int mGamepadPort = 0;
+	QString mGamepadTransport = "tcp";
 	bool mIsGamepadEnabled = false;
 
 	VirtualSensor mLineSensor;
@@ -322,6 +366,15 @@ private:
 	VirtualSensor mMxNColorSensor;
 	int mColorSensorM = 0;
 	int mColorSensorN = 0;
+
+	bool mIsSimulator = false;
+	int mSimulatorI2cLatency = 0;
+	int mSimulatorDeviceFileLatency = 0;
+	double mSimulatorMotorMaxSpeed = 1000;
+	double mSimulatorMotorTimeConstant = 0.1;
+
+	QString mDisplayRenderer = "widget";
+	QString mFramebufferDevice = "/dev/fb0";
 };
 
 }
@@ -21,6 +21,8 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+
 /// Continious rotation servomotor.
 class ContiniousRotationServoMotor : public ServoMotor
 {
@@ -28,6 +30,7 @@ class ContiniousRotationServoMotor : public ServoMotor
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to device files.
 	/// @param min - value of duty_ns corresponding to full reverse of a motor. Used to calculate actual values from
 	///        values in range [-100..100] from client program.
 	/// @param max - value of duty_ns corresponding to full forward of a motor. Used to calculate actual values from
@@ -37,8 +40,8 @@ public:
 	/// @param periodFile - file for setting period of PWM signal supplied to this motor
 	/// @param period - value of period for setting while initialization
 	/// @param invert - true, if power values set by setPower slot shall be negated before sent to motor.
-	ContiniousRotationServoMotor(int min, int max, int zero, int stop, QString const &dutyFile
-			, QString const &periodFile, int period, bool invert);
+	ContiniousRotationServoMotor(DeviceBackendInterface &backend, int min, int max, int zero, int stop
+			, QString const &dutyFile, QString const &periodFile, int period, bool invert);
 
 public slots:
 	/// Sets current motor power to specified value, 0 to stop motor.
@@ -0,0 +1,54 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QString>
+
+namespace trikControl {
+
+class DeviceFileInterface;
+class EventDeviceInterface;
+class I2cBusInterface;
+class VirtualSensorDeviceInterface;
+
+/// Factory of low-level device objects. Every class in trikControl that talks to hardware obtains its device through
+/// this interface, so the whole Brick can run either on a real robot or on top of a simulator.
+/// Ownership over created objects is passed to a caller.
+class DeviceBackendInterface
+{
+public:
+	virtual ~DeviceBackendInterface() {}
+
+	/// Creates I2C bus connected to a device with given id.
+	/// @param devicePath - path to Linux I2C device file.
+	/// @param deviceId - id of I2C device.
+	virtual I2cBusInterface *createI2cBus(QString const &devicePath, int deviceId) = 0;
+
+	/// Creates device file, like sysfs attribute.
+	virtual DeviceFileInterface *createDeviceFile(QString const &fileName) = 0;
+
+	/// Creates source of input events.
+	/// @param fileName - path to evdev device file, like /dev/input/event0.
+	virtual EventDeviceInterface *createEventDevice(QString const &fileName) = 0;
+
+	/// Creates connection to a virtual sensor.
+	/// @param script - file name of a script used to start or stop a sensor.
+	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
+	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
+	virtual VirtualSensorDeviceInterface *createVirtualSensorDevice(QString const &script, QString const &inputFile
+			, QString const &outputFile) = 0;
+};
+
+}
@@ -0,0 +1,41 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+namespace trikControl {
+
+/// Device file like sysfs attribute that is read or written as a whole, for example PWM duty or digital sensor
+/// value. Implemented by real files and by simulator.
+class DeviceFileInterface
+{
+public:
+	virtual ~DeviceFileInterface() {}
+
+	/// Returns name of a file, for debug output.
+	virtual QString fileName() const = 0;
+
+	/// Reads current contents of a file from the beginning.
+	/// @returns empty array if file can not be read.
+	virtual QByteArray read() = 0;
+
+	/// Writes new value to a file.
+	/// @returns false if file can not be written.
+	virtual bool write(QByteArray const &data) = 0;
+};
+
+}
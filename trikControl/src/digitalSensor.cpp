@@ -16,32 +16,35 @@
 
 #include <QtCore/QDebug>
 
+#include "src/deviceBackendInterface.h"
+#include "src/deviceFileInterface.h"
+
 using namespace trikControl;
 
-DigitalSensor::DigitalSensor(int min, int max, QString const &deviceFile)
+DigitalSensor::DigitalSensor(DeviceBackendInterface &backend, int min, int max, QString const &deviceFile)
 	: mMin(min)
 	, mMax(max)
-	, mDeviceFile(deviceFile)
+	, mDeviceFile(backend.createDeviceFile(deviceFile))
 {
 }
 
-int DigitalSensor::read()
+DigitalSensor::~DigitalSensor()
 {
-	if (!mDeviceFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-		qDebug() << "File " << mDeviceFile.fileName() << " failed to open for reading";
-		return 0;
-	}
-
-	mStream.setDevice(&mDeviceFile);
+}
 
+int DigitalSensor::read()
+{
 	if (mMax == mMin) {
 		return mMin;
 	}
 
-	int value = 0;
-	mStream >> value;
+	QByteArray const data = mDeviceFile->read();
+	if (data.isEmpty()) {
+		qDebug() << "File " << mDeviceFile->fileName() << " failed to open for reading";
+		return 0;
+	}
 
-	mDeviceFile.close();
+	int value = data.trimmed().toInt();
 
 	value = qMin(value, mMax);
 	value = qMax(value, mMin);
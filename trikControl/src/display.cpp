@@ -23,14 +23,23 @@
 	#include <QtWidgets/QPushButton>
 #endif
 
+#include <QtCore/QDebug>
+
+#include "src/drawCommandBuffer.h"
+#include "src/framebufferWorker.h"
 #include "src/guiWorker.h"
+#include "src/hardwareFramebuffer.h"
+#include "src/memoryFramebuffer.h"
 
 using namespace trikControl;
 
-Display::Display(QThread &guiThread, const QString &startDirPath)
+Display::Display(QThread &guiThread, const QString &startDirPath, QString const &renderer
+		, QString const &framebufferDevice)
 	: mGuiThread(guiThread)
 	, mStartDirPath(startDirPath)
-	, mGuiWorker(new GuiWorker())
+	, mGuiWorker(createWorker(renderer, framebufferDevice))
+	, mFrame(new DrawCommandBuffer())
+	, mInFrame(false)
 {
 	mGuiWorker->moveToThread(&guiThread);
 	QMetaObject::invokeMethod(mGuiWorker, "init");
@@ -42,18 +51,83 @@ Display::~Display()
 	mGuiThread.wait(1000);
 }
 
+AbstractDisplayWorker *Display::createWorker(QString const &renderer, QString const &framebufferDevice)
+{
+	if (renderer == "framebuffer") {
+		return new FramebufferWorker(new HardwareFramebuffer(framebufferDevice));
+	} else if (renderer == "memory") {
+		return new FramebufferWorker(new MemoryFramebuffer(QSize(240, 320)));
+	} else if (renderer != "widget") {
+		qDebug() << "Unknown display renderer" << renderer << ", using widget";
+	}
+
+	return new GuiWorker();
+}
+
 void Display::showImage(QString const &fileName)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->showImage(fileName);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "showImage", Q_ARG(QString, fileName));
 }
 
+void Display::preloadImage(QString const &fileName)
+{
+	QMetaObject::invokeMethod(mGuiWorker, "preloadImage", Q_ARG(QString, fileName));
+}
+
+void Display::loadAnimation(QStringList const &fileNames)
+{
+	QMetaObject::invokeMethod(mGuiWorker, "loadAnimation", Q_ARG(QStringList, fileNames));
+}
+
+void Display::loadSpriteSheet(QString const &fileName, int frameWidth, int frameHeight)
+{
+	QMetaObject::invokeMethod(mGuiWorker, "loadSpriteSheet", Q_ARG(QString, fileName), Q_ARG(int, frameWidth)
+			, Q_ARG(int, frameHeight));
+}
+
+void Display::setAnimationFps(double fps)
+{
+	QMetaObject::invokeMethod(mGuiWorker, "setAnimationFps", Q_ARG(double, fps));
+}
+
+void Display::playAnimation(bool loop)
+{
+	QMetaObject::invokeMethod(mGuiWorker, "playAnimation", Q_ARG(bool, loop));
+}
+
+void Display::stopAnimation()
+{
+	QMetaObject::invokeMethod(mGuiWorker, "stopAnimation");
+}
+
 void Display::addLabel(QString const &text, int x, int y)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->addLabel(text, x, y);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "addLabel", Q_ARG(QString, text), Q_ARG(int, x), Q_ARG(int, y));
 }
 
 void Display::removeLabels()
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->removeLabels();
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "removeLabels");
 }
 
@@ -69,53 +143,153 @@ void Display::sadSmile()
 
 void Display::setBackground(QString const &color)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->setBackground(color);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "setBackground", Q_ARG(QString, color));
 }
 
 void Display::hide()
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->hide();
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "hide");
 }
 
 void Display::clear()
 {
+	{
+		// Everything recorded in current frame would be cleared anyway.
+		QMutexLocker locker(&mFrameLock);
+		mFrame->clear();
+	}
+
 	QMetaObject::invokeMethod(mGuiWorker, "clear");
 }
 
 void Display::drawLine(int x1, int y1, int x2, int y2)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->drawLine(x1, y1, x2, y2);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "drawLine", Q_ARG(int, x1), Q_ARG(int, y1), Q_ARG(int, x2), Q_ARG(int, y2));
 }
 
 void Display::drawPoint(int x, int y)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->drawPoint(x, y);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "drawPoint", Q_ARG(int, x), Q_ARG(int, y));
 }
 
 void Display::drawRect(int x, int y, int width, int height)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->drawRect(x, y, width, height);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "drawRect", Q_ARG(int, x), Q_ARG(int, y)
 			, Q_ARG(int, width), Q_ARG(int, height));
 }
 
 void Display::drawEllipse(int x, int y, int width, int height)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->drawEllipse(x, y, width, height);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "drawEllipse", Q_ARG(int, x), Q_ARG(int, y)
 			, Q_ARG(int, width), Q_ARG(int, height));
 }
 
 void Display::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->drawArc(x, y, width, height, startAngle, spanAngle);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "drawArc", Q_ARG(int, x), Q_ARG(int, y)
 			, Q_ARG(int, width), Q_ARG(int, height), Q_ARG(int, startAngle), Q_ARG(int, spanAngle));
 }
 
 void Display::setPainterColor(QString const &color)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->setPainterColor(color);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "setPainterColor", Q_ARG(QString, color));
 }
 
 void Display::setPainterWidth(int penWidth)
 {
+	QMutexLocker locker(&mFrameLock);
+	if (mInFrame) {
+		mFrame->setPainterWidth(penWidth);
+		return;
+	}
+
+	locker.unlock();
 	QMetaObject::invokeMethod(mGuiWorker, "setPainterWidth", Q_ARG(int, penWidth));
 }
+
+void Display::drawPolyline(QVector<int> const &coordinates)
+{
+	QMutexLocker locker(&mFrameLock);
+	mFrame->drawPolyline(coordinates);
+	if (!mInFrame) {
+		mGuiWorker->submitFrame(*mFrame);
+	}
+}
+
+void Display::drawPoints(QVector<int> const &coordinates)
+{
+	QMutexLocker locker(&mFrameLock);
+	mFrame->drawPoints(coordinates);
+	if (!mInFrame) {
+		mGuiWorker->submitFrame(*mFrame);
+	}
+}
+
+void Display::beginFrame()
+{
+	QMutexLocker locker(&mFrameLock);
+	mInFrame = true;
+}
+
+void Display::endFrame()
+{
+	QMutexLocker locker(&mFrameLock);
+	mInFrame = false;
+	mGuiWorker->submitFrame(*mFrame);
+}
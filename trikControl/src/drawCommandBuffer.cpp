@@ -0,0 +1,127 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "drawCommandBuffer.h"
+
+using namespace trikControl;
+
+DrawCommandBuffer::DrawCommandBuffer(int capacity)
+{
+	mCommands.reserve(capacity);
+}
+
+void DrawCommandBuffer::setPainterColor(QString const &color)
+{
+	mCommands << painterColor << mStrings.size();
+	mStrings << color;
+}
+
+void DrawCommandBuffer::setPainterWidth(int penWidth)
+{
+	mCommands << painterWidth << penWidth;
+}
+
+void DrawCommandBuffer::drawPoint(int x, int y)
+{
+	mCommands << point << x << y;
+}
+
+void DrawCommandBuffer::drawLine(int x1, int y1, int x2, int y2)
+{
+	mCommands << line << x1 << y1 << x2 << y2;
+}
+
+void DrawCommandBuffer::drawRect(int x, int y, int width, int height)
+{
+	mCommands << rect << x << y << width << height;
+}
+
+void DrawCommandBuffer::drawEllipse(int x, int y, int width, int height)
+{
+	mCommands << ellipse << x << y << width << height;
+}
+
+void DrawCommandBuffer::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
+{
+	mCommands << arc << x << y << width << height << startAngle << spanAngle;
+}
+
+void DrawCommandBuffer::drawPolyline(QVector<int> const &coordinates)
+{
+	addArray(polyline, coordinates);
+}
+
+void DrawCommandBuffer::drawPoints(QVector<int> const &coordinates)
+{
+	addArray(points, coordinates);
+}
+
+void DrawCommandBuffer::showImage(QString const &fileName)
+{
+	mCommands << image << mStrings.size();
+	mStrings << fileName;
+}
+
+void DrawCommandBuffer::addLabel(QString const &text, int x, int y)
+{
+	mCommands << label << mStrings.size() << x << y;
+	mStrings << text;
+}
+
+void DrawCommandBuffer::removeLabels()
+{
+	mCommands << noLabels;
+}
+
+void DrawCommandBuffer::setBackground(QString const &color)
+{
+	mCommands << background << mStrings.size();
+	mStrings << color;
+}
+
+void DrawCommandBuffer::hide()
+{
+	mCommands << hidden;
+}
+
+void DrawCommandBuffer::addArray(Command command, QVector<int> const &coordinates)
+{
+	// Odd trailing value can not form a point and is ignored.
+	int const count = coordinates.size() & ~1;
+	if (count == 0) {
+		return;
+	}
+
+	mCommands << command << count;
+	for (int i = 0; i < count; ++i) {
+		mCommands << coordinates[i];
+	}
+}
+
+bool DrawCommandBuffer::isEmpty() const
+{
+	return mCommands.isEmpty();
+}
+
+void DrawCommandBuffer::clear()
+{
+	mCommands.resize(0);
+	mStrings.clear();
+}
+
+void DrawCommandBuffer::swap(DrawCommandBuffer &other)
+{
+	mCommands.swap(other.mCommands);
+	mStrings.swap(other.mStrings);
+}
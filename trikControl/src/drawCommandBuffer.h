@@ -0,0 +1,205 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+namespace trikControl {
+
+/// Sequence of display commands recorded on a script side and replayed on a display in GUI thread. Besides drawing,
+/// commands that change images, labels, background and visibility are recorded too, so a frame is shown exactly as
+/// if its commands were executed one by one. Commands are packed into a flat vector of ints, so recording
+/// a primitive does not allocate memory once buffer has grown to the size of a typical frame, and buffers are passed
+/// between threads by swapping their contents.
+class DrawCommandBuffer
+{
+public:
+	/// Constructor. Preallocates memory for given number of ints.
+	explicit DrawCommandBuffer(int capacity = 4096);
+
+	/// Records setting of painter color.
+	void setPainterColor(QString const &color);
+
+	/// Records setting of painter width.
+	void setPainterWidth(int penWidth);
+
+	/// Records drawing of a point.
+	void drawPoint(int x, int y);
+
+	/// Records drawing of a line.
+	void drawLine(int x1, int y1, int x2, int y2);
+
+	/// Records drawing of a rect.
+	void drawRect(int x, int y, int width, int height);
+
+	/// Records drawing of an ellipse.
+	void drawEllipse(int x, int y, int width, int height);
+
+	/// Records drawing of an arc.
+	void drawArc(int x, int y, int width, int height, int startAngle, int spanAngle);
+
+	/// Records drawing of lines connecting consecutive points.
+	/// @param coordinates - coordinates of points in the form x0, y0, x1, y1, ...
+	void drawPolyline(QVector<int> const &coordinates);
+
+	/// Records drawing of a set of points.
+	/// @param coordinates - coordinates of points in the form x0, y0, x1, y1, ...
+	void drawPoints(QVector<int> const &coordinates);
+
+	/// Records showing of an image from a file.
+	void showImage(QString const &fileName);
+
+	/// Records adding of a label.
+	void addLabel(QString const &text, int x, int y);
+
+	/// Records removal of all labels.
+	void removeLabels();
+
+	/// Records setting of background color.
+	void setBackground(QString const &color);
+
+	/// Records hiding of display output.
+	void hide();
+
+	/// Returns true if there are no recorded commands.
+	bool isEmpty() const;
+
+	/// Removes all recorded commands, keeping allocated memory.
+	void clear();
+
+	/// Exchanges contents of this buffer with other one without copying.
+	void swap(DrawCommandBuffer &other);
+
+	/// Executes recorded commands in order of recording.
+	/// @param target - object with drawing, painter setting, image, label, background and hiding methods of Display,
+	///        for example display worker.
+	template<typename Target>
+	void replay(Target &target) const;
+
+private:
+	/// Opcodes of commands. Each opcode is followed by its arguments, polyline and points have number of
+	/// coordinates as their first argument, string arguments are indices in mStrings.
+	enum Command {
+		painterColor
+		, painterWidth
+		, point
+		, line
+		, rect
+		, ellipse
+		, arc
+		, polyline
+		, points
+		, image
+		, label
+		, noLabels
+		, background
+		, hidden
+	};
+
+	/// Records command with coordinates array argument.
+	void addArray(Command command, QVector<int> const &coordinates);
+
+	/// Packed commands with their arguments.
+	QVector<int> mCommands;
+
+	/// Colors, file names and texts used by commands.
+	QStringList mStrings;
+};
+
+template<typename Target>
+void DrawCommandBuffer::replay(Target &target) const
+{
+	int const * const data = mCommands.constData();
+	int const size = mCommands.size();
+	int i = 0;
+	while (i < size) {
+		int const * const args = data + i + 1;
+		switch (data[i]) {
+		case painterColor:
+			target.setPainterColor(mStrings[args[0]]);
+			i += 2;
+			break;
+		case painterWidth:
+			target.setPainterWidth(args[0]);
+			i += 2;
+			break;
+		case point:
+			target.drawPoint(args[0], args[1]);
+			i += 3;
+			break;
+		case line:
+			target.drawLine(args[0], args[1], args[2], args[3]);
+			i += 5;
+			break;
+		case rect:
+			target.drawRect(args[0], args[1], args[2], args[3]);
+			i += 5;
+			break;
+		case ellipse:
+			target.drawEllipse(args[0], args[1], args[2], args[3]);
+			i += 5;
+			break;
+		case arc:
+			target.drawArc(args[0], args[1], args[2], args[3], args[4], args[5]);
+			i += 7;
+			break;
+		case polyline: {
+			int const * const coordinates = args + 1;
+			for (int j = 2; j < args[0]; j += 2) {
+				target.drawLine(coordinates[j - 2], coordinates[j - 1], coordinates[j], coordinates[j + 1]);
+			}
+
+			if (args[0] == 2) {
+				target.drawPoint(coordinates[0], coordinates[1]);
+			}
+
+			i += 2 + args[0];
+			break;
+		}
+		case points: {
+			int const * const coordinates = args + 1;
+			for (int j = 0; j < args[0]; j += 2) {
+				target.drawPoint(coordinates[j], coordinates[j + 1]);
+			}
+
+			i += 2 + args[0];
+			break;
+		}
+		case image:
+			target.showImage(mStrings[args[0]]);
+			i += 2;
+			break;
+		case label:
+			target.addLabel(mStrings[args[0]], args[1], args[2]);
+			i += 4;
+			break;
+		case noLabels:
+			target.removeLabels();
+			i += 1;
+			break;
+		case background:
+			target.setBackground(mStrings[args[0]]);
+			i += 2;
+			break;
+		case hidden:
+			target.hide();
+			i += 1;
+			break;
+		}
+	}
+}
+
+}
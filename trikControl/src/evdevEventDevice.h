@@ -0,0 +1,50 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QString>
+
+#include "eventDeviceInterface.h"
+
+namespace trikControl {
+
+/// Real Linux input device (evdev), like /dev/input/event0.
+class EvdevEventDevice : public EventDeviceInterface
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param fileName - path to input device file.
+	explicit EvdevEventDevice(QString const &fileName);
+
+	~EvdevEventDevice() override;
+
+private slots:
+	/// Reads all available events from a device.
+	void readEvents();
+
+private:
+	QScopedPointer<QSocketNotifier> mSocketNotifier;
+	int mDeviceFileDescriptor;
+	QString const mFileName;
+
+	/// True if device reports event times in monotonic clock, otherwise time of reading is used instead.
+	bool mHasMonotonicTimestamps;
+};
+
+}
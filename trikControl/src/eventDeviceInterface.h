@@ -0,0 +1,36 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+
+namespace trikControl {
+
+/// Source of Linux input subsystem (evdev) events, like keys or accelerometer. Implemented by real input device file
+/// and by simulator. Emits events in a thread it lives in, so it shall be moved to a thread of a consumer.
+class EventDeviceInterface : public QObject
+{
+	Q_OBJECT
+
+signals:
+	/// Emitted for every event read from a device.
+	/// @param eventType - event type, like EV_KEY or EV_SYN.
+	/// @param code - event code, like key code or axis.
+	/// @param value - event value.
+	/// @param timestamp - time of the event in milliseconds of monotonic clock, see MonotonicClock.
+	void newEvent(int eventType, int code, int value, qint64 timestamp);
+};
+
+}
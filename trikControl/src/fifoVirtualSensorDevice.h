@@ -0,0 +1,100 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QString>
+#include <QtCore/QProcess>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "virtualSensorDeviceInterface.h"
+
+namespace trikControl {
+
+/// Real virtual sensor: an external process that communicates using input and output FIFOs and uses script that
+/// allows to start, stop or restart it.
+class FifoVirtualSensorDevice : public VirtualSensorDeviceInterface
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param script - file name of a scrit used to start or stop a sensor.
+	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
+	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
+	FifoVirtualSensorDevice(QString const &script, QString const &inputFile, QString const &outputFile);
+
+	~FifoVirtualSensorDevice() override;
+
+	void start() override;
+
+	void stop() override;
+
+	bool isReady() const override;
+
+	void send(QString const &command) override;
+
+private slots:
+	/// Reads available data from output fifo and emits it line by line.
+	void readFile();
+
+private:
+	/// Provides user-friendly name of a sensor used in debug output.
+	QString sensorName() const;
+
+	/// Launches sensor control script with given command as a parameter.
+	/// @returns true if sensor script launched successfully.
+	bool launchSensorScript(QString const &command);
+
+	/// Starts virtual sensor process.
+	void startVirtualSensor();
+
+	/// Opens input and output fifos of a sensor.
+	void openFifos();
+
+	/// Closes fifos and stops sensor.
+	void deinitialize();
+
+	/// Listener for output fifo.
+	QScopedPointer<QSocketNotifier> mSocketNotifier;
+
+	/// File name (with path) of a script that launches or stops sensor.
+	QString mScript;
+
+	/// File descriptor for output fifo.
+	int mOutputFileDescriptor = -1;
+
+	/// Virtual sensor process.
+	QProcess mSensorProcess;
+
+	/// Input fifo.
+	QFile mInputFile;
+
+	/// Output fifo.
+	QFile mOutputFile;
+
+	/// File stream for command fifo. Despite its name it is used to output commands. It is input for virtual sensor.
+	QTextStream mInputStream;
+
+	/// Flag that sensor is ready and waiting for commands.
+	bool mReady = false;
+
+	/// Buffer with current line being read from FIFO.
+	QString mBuffer;
+};
+
+}
@@ -0,0 +1,38 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtGui/QImage>
+
+namespace trikControl {
+
+/// Screen memory to which display output is rendered directly, without Qt widgets. Framebuffer is double buffered:
+/// frames are drawn on back buffer which is then shown by flip().
+class FramebufferInterface
+{
+public:
+	virtual ~FramebufferInterface() {}
+
+	/// Returns image on which next frame shall be drawn. It contains the frame that was shown before the current
+	/// one, so only areas changed in two last frames shall be redrawn. Image is valid until next call of flip().
+	virtual QImage &backBuffer() = 0;
+
+	/// Shows back buffer on a screen. Previous front buffer becomes back buffer.
+	/// @param changedArea - area of back buffer that was redrawn since previous flip. Implementations that copy
+	///        back buffer to a screen copy only this area.
+	virtual void flip(QRect const &changedArea) = 0;
+};
+
+}
@@ -0,0 +1,187 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "framebufferWorker.h"
+
+#include <QtGui/QPainter>
+
+#include "drawCommandBuffer.h"
+
+using namespace trikControl;
+
+/// Distance between screen border and image, close to default layout margin of widget renderer.
+static int const imageMargin = 10;
+
+FramebufferWorker::FramebufferWorker(FramebufferInterface *framebuffer)
+	: mFramebuffer(framebuffer)
+	, mLabels(QFont())
+	, mIsVisible(false)
+	, mIsRenderScheduled(false)
+{
+}
+
+void FramebufferWorker::init()
+{
+	mCanvas.resize(mFramebuffer->backBuffer().size());
+	resetBackground();
+	setImageSize(imageRect().size());
+}
+
+void FramebufferWorker::setImage(QImage const &image)
+{
+	if (!mImage.isNull() || !image.isNull()) {
+		update(imageRect());
+	}
+
+	// Image is stretched to its area, as widget renderer does.
+	mImage = image.isNull()
+			? image
+			: image.scaled(imageRect().size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+void FramebufferWorker::addLabel(QString const &text, int x, int y)
+{
+	update(mLabels.setLabel(text, x, y, mCanvas.currentPenColor()));
+}
+
+void FramebufferWorker::removeLabels()
+{
+	update(mLabels.clear());
+}
+
+void FramebufferWorker::hide()
+{
+	stopAnimation();
+	mIsVisible = false;
+}
+
+void FramebufferWorker::setBackground(QString const &color)
+{
+	mBackground = backgroundColor(color);
+	update(screenRect());
+}
+
+void FramebufferWorker::resetBackground()
+{
+	mBackground = Qt::lightGray;
+}
+
+void FramebufferWorker::setPainterWidth(int penWidth)
+{
+	mCanvas.setPainterWidth(penWidth);
+}
+
+void FramebufferWorker::setPainterColor(QString const &color)
+{
+	mCanvas.setPainterColor(color);
+}
+
+void FramebufferWorker::clear()
+{
+	mCanvas.deleteAllItems();
+	mCanvas.setPainterColor("black");
+	mCanvas.setPainterWidth(1);
+	mLabels.clear();
+	clearImage();
+	mDirtyRect = screenRect();
+	resetBackground();
+	hide();
+}
+
+void FramebufferWorker::drawPoint(int x, int y)
+{
+	update(mCanvas.drawPoint(x, y));
+}
+
+void FramebufferWorker::drawLine(int x1, int y1, int x2, int y2)
+{
+	update(mCanvas.drawLine(x1, y1, x2, y2));
+}
+
+void FramebufferWorker::drawRect(int x, int y, int width, int height)
+{
+	update(mCanvas.drawRect(x, y, width, height));
+}
+
+void FramebufferWorker::drawEllipse(int x, int y, int width, int height)
+{
+	update(mCanvas.drawEllipse(x, y, width, height));
+}
+
+void FramebufferWorker::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
+{
+	update(mCanvas.drawArc(x, y, width, height, startAngle, spanAngle));
+}
+
+void FramebufferWorker::drawFrame(DrawCommandBuffer const &frame)
+{
+	frame.replay(*this);
+}
+
+void FramebufferWorker::update(QRect const &rect)
+{
+	if (!mIsVisible) {
+		// Screen could be used by someone else while output was hidden.
+		mIsVisible = true;
+		mDirtyRect = screenRect();
+		mPreviousDirtyRect = screenRect();
+	} else {
+		mDirtyRect = mDirtyRect.united(rect);
+	}
+
+	if (!mIsRenderScheduled) {
+		mIsRenderScheduled = true;
+		QMetaObject::invokeMethod(this, "render", Qt::QueuedConnection);
+	}
+}
+
+QRect FramebufferWorker::screenRect() const
+{
+	return mCanvas.image().rect();
+}
+
+QRect FramebufferWorker::imageRect() const
+{
+	return screenRect().adjusted(imageMargin, imageMargin, -imageMargin, -imageMargin);
+}
+
+void FramebufferWorker::render()
+{
+	mIsRenderScheduled = false;
+	if (!mIsVisible) {
+		return;
+	}
+
+	// Back buffer holds the frame shown before the current one, so it lacks changes of the last two frames.
+	QRect const area = mDirtyRect.united(mPreviousDirtyRect).intersected(screenRect());
+	if (area.isEmpty()) {
+		return;
+	}
+
+	QPainter painter(&mFramebuffer->backBuffer());
+	painter.setClipRect(area);
+	painter.fillRect(area, mBackground);
+
+	painter.drawImage(area.topLeft(), mCanvas.image(), area);
+	if (!mImage.isNull() && imageRect().intersects(area)) {
+		painter.drawImage(imageRect().topLeft(), mImage);
+	}
+
+	mLabels.paint(painter, area);
+	painter.end();
+
+	mFramebuffer->flip(area);
+	mPreviousDirtyRect = mDirtyRect;
+	mDirtyRect = QRect();
+}
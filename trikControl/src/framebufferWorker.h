@@ -0,0 +1,103 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QScopedPointer>
+#include <QtGui/QColor>
+#include <QtGui/QImage>
+
+#include "abstractDisplayWorker.h"
+#include "canvas.h"
+#include "framebufferInterface.h"
+#include "labelLayer.h"
+
+namespace trikControl {
+
+/// Works in GUI thread and renders display output directly into a framebuffer, bypassing Qt widgets. Every change
+/// schedules rendering of a frame, all changes made before control returns to event loop are shown by one flip,
+/// and only changed area of a screen is redrawn. When hidden, worker stops rendering and leaves last frame on
+/// a screen.
+class FramebufferWorker : public AbstractDisplayWorker
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param framebuffer - framebuffer to render to. Takes ownership.
+	explicit FramebufferWorker(FramebufferInterface *framebuffer);
+
+public slots:
+	void init() override;
+	void addLabel(QString const &text, int x, int y) override;
+	void removeLabels() override;
+	void hide() override;
+	void setBackground(QString const &color) override;
+	void setPainterWidth(int penWidth) override;
+	void setPainterColor(QString const &color) override;
+	void clear() override;
+	void drawPoint(int x, int y) override;
+	void drawLine(int x1, int y1, int x2, int y2) override;
+	void drawRect(int x, int y, int width, int height) override;
+	void drawEllipse(int x, int y, int width, int height) override;
+	void drawArc(int x, int y, int width, int height, int startAngle, int spanAngle) override;
+
+private slots:
+	/// Composes changed area of a frame from background, image, primitives and labels, and flips framebuffer.
+	void render();
+
+private:
+	void drawFrame(DrawCommandBuffer const &frame) override;
+
+	void setImage(QImage const &image) override;
+
+	/// Makes output visible, marks given area as changed and requests rendering of a frame when control returns
+	/// to event loop.
+	void update(QRect const &rect);
+
+	QRect screenRect() const;
+
+	/// Returns area occupied by image.
+	QRect imageRect() const;
+
+	void resetBackground();
+
+	/// Has ownership.
+	QScopedPointer<FramebufferInterface> mFramebuffer;
+
+	/// All primitives drawn by a script.
+	Canvas mCanvas;
+
+	QColor mBackground;
+
+	/// Currently shown image, stretched to image area and drawn over primitives.
+	QImage mImage;
+
+	/// All labels.
+	LabelLayer mLabels;
+
+	/// False if output is hidden and shall not be rendered.
+	bool mIsVisible;
+
+	/// Area changed since last rendered frame.
+	QRect mDirtyRect;
+
+	/// Area changed in last rendered frame.
+	QRect mPreviousDirtyRect;
+
+	/// True if rendering of a frame is already requested.
+	bool mIsRenderScheduled;
+};
+
+}
@@ -16,13 +16,21 @@
 
 #include <QtCore/QStringList>
 
+#include "gamepadState.h"
 #include "tcpConnector.h"
+#include "udpConnector.h"
 
 using namespace trikControl;
 
-Gamepad::Gamepad(int port)
-	: mListener(new TcpConnector(port))
+Gamepad::Gamepad(int port, QString const &transport)
+	: mState(new GamepadState())
 {
+	if (transport == "udp") {
+		mListener.reset(new UdpConnector(port));
+	} else {
+		mListener.reset(new TcpConnector(port));
+	}
+
 	connect(mListener.data(), SIGNAL(dataReady(QString)), this, SLOT(parse(QString)));
 	connect(&mNetworkThread, SIGNAL(started()), mListener.data(), SLOT(startServer()));
 	mListener->moveToThread(&mNetworkThread);
@@ -35,52 +43,76 @@ Gamepad::~Gamepad()
 
 void Gamepad::reset()
 {
-	mButtonWasPressed.clear();
-	mPads.clear();
+	mState->reset();
 }
 
 bool Gamepad::buttonWasPressed(int buttonNumber)
 {
-	return mButtonWasPressed.remove(buttonNumber);
+	return mState->takeButtonPress(buttonNumber);
 }
 
 bool Gamepad::isPadPressed(int pad)
 {
-	return mPads.contains(pad) && mPads.value(pad).isPressed;
+	return mState->pad(pad).isPressed;
 }
 
 int Gamepad::padX(int pad)
 {
-	return (!mPads.contains(pad) || !mPads.value(pad).isPressed) ? -1 : mPads.value(pad).x;
+	return mState->pad(pad).x;
 }
 
 int Gamepad::padY(int pad)
 {
-	return (!mPads.contains(pad) || !mPads.value(pad).isPressed) ? -1 : mPads.value(pad).y;
+	return mState->pad(pad).y;
+}
+
+QVector<int> Gamepad::padState(int pad)
+{
+	GamepadState::Pad const state = mState->pad(pad);
+	return QVector<int>() << state.x << state.y << (state.isPressed ? 1 : 0);
 }
 
 void Gamepad::parse(QString const &message)
 {
 	QStringList const cmd = message.split(" ", QString::SkipEmptyParts);
+	if (cmd.isEmpty()) {
+		qDebug() << "Empty command";
+		return;
+	}
+
+	// Commands come from network, possibly from any host, so number of arguments is checked before use.
 	QString const commandName = cmd.at(0).trimmed();
 	if (commandName == "pad") {
+		if (cmd.size() < 3 || (cmd.at(2).trimmed() != "up" && cmd.size() < 4)) {
+			qDebug() << "Malformed command" << message;
+			return;
+		}
+
 		int const padId = cmd.at(1).trimmed().toInt();
 		if (cmd.at(2).trimmed() == "up") {
-			mPads[padId].isPressed = false;
+			mState->releasePad(padId);
 			emit padUp(padId);
 		} else {
 			int const x = cmd.at(2).trimmed().toInt();
 			int const y = cmd.at(3).trimmed().toInt();
-			mPads[padId].isPressed = true;
-			mPads[padId].x = x;
-			mPads[padId].y = y;
+			mState->setPad(padId, x, y);
 			emit pad(padId, x, y);
 		}
 	} else if (commandName == "btn") {
+		if (cmd.size() < 2) {
+			qDebug() << "Malformed command" << message;
+			return;
+		}
+
 		int const buttonCode = cmd.at(1).trimmed().toInt();
-		mButtonWasPressed.insert(buttonCode);
+		mState->pressButton(buttonCode);
 		emit button(buttonCode, 1);
 	} else if (commandName == "wheel") {
+		if (cmd.size() < 2) {
+			qDebug() << "Malformed command" << message;
+			return;
+		}
+
 		int const perc = cmd.at(1).trimmed().toInt();
 		emit wheel(perc);
 	} else {
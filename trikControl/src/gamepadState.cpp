@@ -0,0 +1,118 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "gamepadState.h"
+
+using namespace trikControl;
+
+GamepadState::GamepadState()
+{
+	for (PadSlot &slot : mPads) {
+		slot.sequence.store(0);
+		slot.x.store(-1);
+		slot.y.store(-1);
+		slot.isPressed.store(false);
+	}
+
+	for (std::atomic<bool> &button : mButtonWasPressed) {
+		button.store(false);
+	}
+}
+
+void GamepadState::setPad(int pad, int x, int y)
+{
+	writePad(pad, x, y, true);
+}
+
+void GamepadState::releasePad(int pad)
+{
+	writePad(pad, -1, -1, false);
+}
+
+GamepadState::Pad GamepadState::pad(int pad) const
+{
+	if (!inRange(pad, maxPad)) {
+		return Pad{-1, -1, false};
+	}
+
+	PadSlot const &slot = mPads[pad - 1];
+	for (;;) {
+		unsigned const sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence & 1) {
+			continue;
+		}
+
+		Pad const result = Pad{
+				slot.x.load(std::memory_order_relaxed)
+				, slot.y.load(std::memory_order_relaxed)
+				, slot.isPressed.load(std::memory_order_relaxed)
+				};
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+			return result;
+		}
+	}
+}
+
+void GamepadState::pressButton(int button)
+{
+	if (inRange(button, maxButton)) {
+		mButtonWasPressed[button - 1].store(true, std::memory_order_relaxed);
+	}
+}
+
+bool GamepadState::takeButtonPress(int button)
+{
+	return inRange(button, maxButton) && mButtonWasPressed[button - 1].exchange(false, std::memory_order_relaxed);
+}
+
+void GamepadState::reset()
+{
+	for (int pad = 1; pad <= maxPad; ++pad) {
+		releasePad(pad);
+	}
+
+	for (std::atomic<bool> &button : mButtonWasPressed) {
+		button.store(false, std::memory_order_relaxed);
+	}
+}
+
+void GamepadState::writePad(int pad, int x, int y, bool isPressed)
+{
+	if (!inRange(pad, maxPad)) {
+		return;
+	}
+
+	PadSlot &slot = mPads[pad - 1];
+
+	// Make sequence odd. Compare-exchange guards against reset() from script thread racing with network updates.
+	unsigned sequence = 0;
+	do {
+		sequence = slot.sequence.load(std::memory_order_relaxed) & ~1u;
+	} while (!slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire));
+
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.x.store(x, std::memory_order_relaxed);
+	slot.y.store(y, std::memory_order_relaxed);
+	slot.isPressed.store(isPressed, std::memory_order_relaxed);
+
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool GamepadState::inRange(int number, int max)
+{
+	return number >= 1 && number <= max;
+}
@@ -0,0 +1,80 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <atomic>
+
+namespace trikControl {
+
+/// State of gamepad pads and buttons, written by network handling code and read by scripts from other threads.
+/// Pads and buttons are stored in fixed-size arrays of atomic fields, so no locks and no hash lookups are needed.
+/// Every pad has its own sequence counter (seqlock): writer makes it odd while updating a pad, reader retries if the
+/// counter was odd or changed during reading, so x, y and pressed state are always read from one update.
+/// Readers never block writers and do not wait for anything except a concurrent update of the same pad.
+class GamepadState
+{
+public:
+	/// Maximal pad number, pads are numbered from 1.
+	static int const maxPad = 4;
+
+	/// Maximal button number, buttons are numbered from 1.
+	static int const maxButton = 16;
+
+	/// Snapshot of a state of one pad.
+	struct Pad {
+		int x;
+		int y;
+		bool isPressed;
+	};
+
+	GamepadState();
+
+	/// Records that given pad is pressed at given position. Ignored for pads out of range.
+	void setPad(int pad, int x, int y);
+
+	/// Records that given pad is released. Ignored for pads out of range.
+	void releasePad(int pad);
+
+	/// Returns consistent snapshot of a pad state. Pads out of range are reported as not pressed.
+	Pad pad(int pad) const;
+
+	/// Records that given button was pressed. Ignored for buttons out of range.
+	void pressButton(int button);
+
+	/// Returns true if given button was pressed since last call and clears "pressed" state of that button.
+	bool takeButtonPress(int button);
+
+	/// Releases all pads and clears "pressed" state of all buttons.
+	void reset();
+
+private:
+	struct PadSlot {
+		std::atomic<unsigned> sequence;
+		std::atomic<int> x;
+		std::atomic<int> y;
+		std::atomic<bool> isPressed;
+	};
+
+	/// Writes new state of a pad. Concurrent writers of the same pad are serialized by sequence counter.
+	void writePad(int pad, int x, int y, bool isPressed);
+
+	/// Returns true if given pad or button number is in range from 1 to max.
+	static bool inRange(int number, int max);
+
+	PadSlot mPads[maxPad];
+	std::atomic<bool> mButtonWasPressed[maxButton];
+};
+
+}
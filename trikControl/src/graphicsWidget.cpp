@@ -12,235 +12,124 @@
  * See the License for the specific language governing permissions and
  * limitations under the License. */
 
+#include <QtGui/QPaintEvent>
 #include <QtGui/QPainter>
-#include <QtGui/QPen>
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+	#include <QtGui/QStyle>
+#else
+	#include <QtWidgets/QStyle>
+#endif
 
 #include "graphicsWidget.h"
 
 using namespace trikControl;
 
 GraphicsWidget::GraphicsWidget()
-	: mCurrentPenColor(Qt::black)
-	, mCurrentPenWidth(0)
+	: mLabels(font())
 {
+	mCanvas.resize(size());
 }
 
 void GraphicsWidget::paintEvent(QPaintEvent *paintEvent)
 {
-	Q_UNUSED(paintEvent)
-
+	QRect const area = paintEvent->rect();
 	QPainter painter(this);
-
-	for (int i = 0; i < mLines.length(); i++)
-	{
-		painter.setPen(QPen(mLines.at(i).color, mLines.at(i).penWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
-		painter.drawLine(mLines.at(i).coord1.x(), mLines.at(i).coord1.y()
-				, mLines.at(i).coord2.x(), mLines.at(i).coord2.y());
+	painter.drawImage(area, mCanvas.image(), area);
+	if (!mScaledImage.isNull() && imageRect().intersects(area)) {
+		painter.drawImage(imageRect().topLeft(), mScaledImage);
 	}
 
-	for (int i = 0; i < mPoints.length(); i++)
-	{
-		painter.setPen(QPen(mPoints.at(i).color, mPoints.at(i).penWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
-		painter.drawPoint(mPoints.at(i).coord.x(), mPoints.at(i).coord.y());
-	}
-
-	for (int i = 0; i < mRects.length(); i++)
-	{
-		painter.setPen(QPen(mRects.at(i).color, mRects.at(i).penWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
-		painter.drawRect(mRects.at(i).rect.x(), mRects.at(i).rect.y()
-				, mRects.at(i).rect.width(), mRects.at(i).rect.height());
-	}
+	mLabels.paint(painter, area);
+}
 
-	for (int i = 0; i < mEllipses.length(); i++)
-	{
-		painter.setPen(QPen(mEllipses.at(i).color, mEllipses.at(i).penWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
-		painter.drawEllipse(mEllipses.at(i).ellipse.x(), mEllipses.at(i).ellipse.y()
-				, mEllipses.at(i).ellipse.width(), mEllipses.at(i).ellipse.height());
-	}
+void GraphicsWidget::resizeEvent(QResizeEvent *resizeEvent)
+{
+	Q_UNUSED(resizeEvent)
 
-	for (int i = 0; i < mArcs.length(); i++)
-	{
-		painter.setPen(QPen(mArcs.at(i).color, mArcs.at(i).penWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
-		painter.drawArc(mArcs.at(i).arc.x(), mArcs.at(i).arc.y()
-				, mArcs.at(i).arc.width(), mArcs.at(i).arc.height()
-				, mArcs.at(i).startAngle, mArcs.at(i).spanAngle);
-	}
+	mCanvas.resize(size());
+	scaleImage();
+	update();
 }
 
 void GraphicsWidget::deleteAllItems()
 {
-	mPoints.clear();
-	mLines.clear();
-	mRects.clear();
-	mEllipses.clear();
-	mArcs.clear();
+	mCanvas.deleteAllItems();
+	update();
 }
 
 void GraphicsWidget::setPainterColor(QString const &color)
 {
-	if (color == tr("white")) {
-		mCurrentPenColor = Qt::white;
-	} else if (color == tr("red")) {
-		mCurrentPenColor = Qt::red;
-	} else if (color == tr("darkRed")) {
-		mCurrentPenColor = Qt::darkRed;
-	} else if (color == tr("green")) {
-		mCurrentPenColor = Qt::green;
-	} else if (color == tr("darkGreen")) {
-		mCurrentPenColor = Qt::darkGreen;
-	} else if (color == tr("blue")) {
-		mCurrentPenColor = Qt::blue;
-	} else if (color == tr("darkBlue")) {
-		mCurrentPenColor = Qt::darkBlue;
-	} else if (color == tr("cyan")) {
-		mCurrentPenColor = Qt::cyan;
-	} else if (color == tr("darkCyan")) {
-		mCurrentPenColor = Qt::darkCyan;
-	} else if (color == tr("magenta")) {
-		mCurrentPenColor = Qt::magenta;
-	} else if (color == tr("darkMagenta")) {
-		mCurrentPenColor = Qt::darkMagenta;
-	} else if (color == tr("yellow")) {
-		mCurrentPenColor = Qt::yellow;
-	} else if (color == tr("darkYellow")) {
-		mCurrentPenColor = Qt::darkYellow;
-	} else if (color == tr("gray")) {
-		mCurrentPenColor = Qt::gray;
-	} else if (color == tr("darkGray")) {
-		mCurrentPenColor = Qt::darkGray;
-	} else if (color == tr("lightGray")) {
-		mCurrentPenColor = Qt::lightGray;
-	} else {
-		mCurrentPenColor = Qt::black;
-	}
+	mCanvas.setPainterColor(color);
 }
 
 void GraphicsWidget::setPainterWidth(int penWidth)
 {
-	mCurrentPenWidth = penWidth;
+	mCanvas.setPainterWidth(penWidth);
 }
 
 void GraphicsWidget::drawPoint(int x, int y)
 {
-	PointCoordinates const coordinates(x, y, mCurrentPenColor, mCurrentPenWidth);
-
-	if (!containsPoint(coordinates)) {
-		mPoints.insert(mPoints.length(), coordinates);
-	}
-}
-
-bool GraphicsWidget::containsPoint(PointCoordinates const &coordinates)
-{
-	for (int i = 0; i < mPoints.length(); ++i) {
-		if (mPoints.at(i).coord.x() == coordinates.coord.x()
-			&& mPoints.at(i).coord.y() == coordinates.coord.y())
-		{
-			return true;
-		}
-	}
-
-	return false;
+	update(mCanvas.drawPoint(x, y));
 }
 
 void GraphicsWidget::drawLine(int x1, int y1, int x2, int y2)
 {
-	LineCoordinates const coordinates(x1, y1, x2, y2, mCurrentPenColor, mCurrentPenWidth);
-
-	if (!containsLine(coordinates)) {
-		mLines.insert(mLines.length(), coordinates);
-	}
+	update(mCanvas.drawLine(x1, y1, x2, y2));
 }
 
-bool GraphicsWidget::containsLine(LineCoordinates const &coordinates)
+void GraphicsWidget::drawRect(int x, int y, int width, int height)
 {
-	for (int i = 0; i < mLines.length(); ++i) {
-		if (mLines.at(i).coord1.x() == coordinates.coord1.x()
-			&& mLines.at(i).coord1.y() == coordinates.coord1.y()
-			&& mLines.at(i).coord2.x() == coordinates.coord2.x()
-			&& mLines.at(i).coord2.y() == coordinates.coord2.y())
-		{
-			return true;
-		}
-	}
-
-	return false;
+	update(mCanvas.drawRect(x, y, width, height));
 }
 
-void GraphicsWidget::drawRect(int x, int y, int width, int height)
+void GraphicsWidget::drawEllipse(int x, int y, int width, int height)
 {
-	RectCoordinates const coordinates(x, y, width, height, mCurrentPenColor, mCurrentPenWidth);
-
-	if (!containsRect(coordinates)) {
-		mRects.insert(mRects.length(), coordinates);
-	}
+	update(mCanvas.drawEllipse(x, y, width, height));
 }
 
-bool GraphicsWidget::containsRect(RectCoordinates const &coordinates)
+void GraphicsWidget::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
 {
-	for (int i = 0; i < mRects.length(); ++i) {
-		if (mRects.at(i).rect.x() == coordinates.rect.x()
-			&& mRects.at(i).rect.y() == coordinates.rect.y()
-			&& mRects.at(i).rect.width() == coordinates.rect.width()
-			&& mRects.at(i).rect.height() == coordinates.rect.height())
-		{
-			return true;
-		}
-	}
-
-	return false;
+	update(mCanvas.drawArc(x, y, width, height, startAngle, spanAngle));
 }
 
-void GraphicsWidget::drawEllipse(int x, int y, int width, int height)
+QColor GraphicsWidget::currentPenColor() const
 {
-	EllipseCoordinates const coordinates(x, y, width, height, mCurrentPenColor, mCurrentPenWidth);
-
-	if (!containsEllipse(coordinates)) {
-		mEllipses.insert(mEllipses.length(), coordinates);
-	}
+	return mCanvas.currentPenColor();
 }
 
-bool GraphicsWidget::containsEllipse(EllipseCoordinates const &coordinates)
+void GraphicsWidget::setImage(QImage const &image)
 {
-	for (int i = 0; i < mEllipses.length(); i++) {
-		if (mEllipses.at(i).ellipse.x() == coordinates.ellipse.x()
-			&& mEllipses.at(i).ellipse.y() == coordinates.ellipse.y()
-			&& mEllipses.at(i).ellipse.width() == coordinates.ellipse.width()
-			&& mEllipses.at(i).ellipse.height() == coordinates.ellipse.height())
-		{
-			return true;
-		}
+	if (!mImage.isNull() || !image.isNull()) {
+		update(imageRect());
 	}
 
-	return false;
+	mImage = image;
+	scaleImage();
 }
 
-void GraphicsWidget::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
+QRect GraphicsWidget::imageRect() const
 {
-	ArcCoordinates const coordinates(x, y, width, height, startAngle, spanAngle, mCurrentPenColor, mCurrentPenWidth);
-
-	if (!containsArc(coordinates)) {
-		mArcs.insert(mArcs.length(), coordinates);
-	}
+	QStyle const * const widgetStyle = style();
+	return rect().adjusted(widgetStyle->pixelMetric(QStyle::PM_LayoutLeftMargin)
+			, widgetStyle->pixelMetric(QStyle::PM_LayoutTopMargin)
+			, -widgetStyle->pixelMetric(QStyle::PM_LayoutRightMargin)
+			, -widgetStyle->pixelMetric(QStyle::PM_LayoutBottomMargin));
 }
 
-bool GraphicsWidget::containsArc(ArcCoordinates const &coordinates)
+void GraphicsWidget::scaleImage()
 {
-	for (int i = 0; i < mArcs.length(); ++i) {
-		if (mArcs.at(i).arc.x() == coordinates.arc.x()
-			&& mArcs.at(i).arc.y() == coordinates.arc.y()
-			&& mArcs.at(i).arc.width() == coordinates.arc.width()
-			&& mArcs.at(i).arc.height() == coordinates.arc.height()
-			&& mArcs.at(i).startAngle == coordinates.startAngle
-			&& mArcs.at(i).spanAngle == coordinates.spanAngle)
-		{
-			return true;
-		}
-	}
+	mScaledImage = mImage.isNull()
+			? QImage()
+			: mImage.scaled(imageRect().size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
 
-	return false;
+void GraphicsWidget::addLabel(QString const &text, int x, int y)
+{
+	update(mLabels.setLabel(text, x, y, mCanvas.currentPenColor()));
 }
 
-QColor GraphicsWidget::currentPenColor() const
+void GraphicsWidget::removeLabels()
 {
-	return mCurrentPenColor;
+	update(mLabels.clear());
 }
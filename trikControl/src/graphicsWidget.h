@@ -14,10 +14,11 @@
 
 #pragma once
 
-#include <QtCore/QList>
-#include <QtCore/QPoint>
-#include <QtCore/QRect>
 #include <QtGui/QColor>
+#include <QtGui/QImage>
+
+#include "canvas.h"
+#include "labelLayer.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
 	#include <QtGui/QWidget>
@@ -27,7 +28,8 @@
 
 namespace trikControl {
 
-/// Class of graphic widget.
+/// Class of graphic widget. Shows primitives, an image over them and text labels over everything. Primitives are kept
+/// in a canvas that rasterizes them once, when they are added, and only affected area of a widget is repainted.
 class GraphicsWidget : public QWidget
 {
 public:
@@ -80,127 +82,44 @@ public:
 	/// Returns current pen color.
 	QColor currentPenColor() const;
 
+	/// Sets image shown over primitives and stretched to the widget without default layout margins, the way QLabel with
+	/// scaled contents in a layout showed it. Null image removes image.
+	void setImage(QImage const &image);
+
+	/// Add a label to the specific position of the widget, drawn with current pen color. If there already is a label
+	/// in these coordinates, its contents will be updated.
+	/// @param text - label text.
+	/// @param x - label x coordinate.
+	/// @param y - label y coordinate.
+	void addLabel(QString const &text, int x, int y);
+
+	/// Remove all labels.
+	void removeLabels();
+
 private:
-	/// Information about point.
-	struct PointCoordinates
-	{
-		PointCoordinates(int x, int y, QColor color, int penWidth)
-				: coord(QPoint(x, y)), color(color), penWidth(penWidth)
-		{
-		}
-
-		QPoint coord;
-		QColor color;
-		int penWidth;
-	};
-
-	/// Information about rectangle.
-	struct RectCoordinates
-	{
-		RectCoordinates(int x, int y, int width, int height, QColor color, int penWidth)
-			: rect(QRect(x, y, width, height)), color(color), penWidth(penWidth)
-		{
-		}
-
-		QRect rect;
-		QColor color;
-		int penWidth;
-	};
-
-	/// Information about line.
-	struct LineCoordinates
-	{
-		LineCoordinates(int x1, int y1, int x2, int y2, QColor color, int penWidth)
-			: coord1(QPoint(x1, y1)), coord2(QPoint(x2, y2)), color(color), penWidth(penWidth)
-		{
-		}
-
-		QPoint coord1;
-		QPoint coord2;
-		QColor color;
-		int penWidth;
-	};
-
-	/// Struct of ellipse coordinates.
-	struct EllipseCoordinates
-	{
-		EllipseCoordinates(int x, int y, int width, int height, QColor color, int penWidth)
-			: ellipse(QRect(x, y, width, height)), color(color), penWidth(penWidth)
-		{
-		}
-
-		QRect ellipse;
-		QColor color;
-		int penWidth;
-	};
-
-	/// Struct of arc coordinates.
-	struct ArcCoordinates
-	{
-		ArcCoordinates(int x, int y, int width, int height, int startAngle, int spanAngle, QColor color, int penWidth)
-			: arc(QRect(x, y, width, height))
-			, startAngle(startAngle)
-			, spanAngle(spanAngle)
-			, color(color)
-			, penWidth(penWidth)
-		{
-		}
-
-		QRect arc;
-		int startAngle;
-		int spanAngle;
-		QColor color;
-		int penWidth;
-	};
-
-	/// Draw all elements.
-	virtual void paintEvent(QPaintEvent *paintEvent);
-
-	/// Check list contains point.
-	/// @param coordinates - point that we are looking for.
-	/// @return - true if list contains this point.
-	bool containsPoint(PointCoordinates const &coordinates);
-
-	/// Check that list contains given line.
-	/// @param coordinates - line that we are looking for.
-	/// @return - true if list contains this line.
-	bool containsLine(LineCoordinates const &coordinates);
-
-	/// Check that list contains given rect.
-	/// @param coordinates - rect that we are looking for.
-	/// @return - true if list contains this rect.
-	bool containsRect(RectCoordinates const &coordinates);
-
-	/// Check that list contains given ellipse.
-	/// @param coordinates - ellipse that we are looking for.
-	/// @return - true if list contains this ellipse.
-	bool containsEllipse(EllipseCoordinates const &coordinates);
-
-	/// Check that list contains given arc.
-	/// @param coordinates - arc that we are looking for.
-	/// @return - true if list contains this arc.
-	bool containsArc(ArcCoordinates const &coordinates);
-
-	/// List of all lines.
-	QList<LineCoordinates> mLines;
-
-	/// List of all points.
-	QList<PointCoordinates> mPoints;
-
-	/// List of all rectangles.
-	QList<RectCoordinates> mRects;
-
-	/// List of all ellipses.
-	QList<EllipseCoordinates> mEllipses;
-
-	/// List of all arcs.
-	QList<ArcCoordinates> mArcs;
-
-	/// Current pen color.
-	QColor mCurrentPenColor;
-
-	/// Current pen width.
-	int mCurrentPenWidth;
+	/// Paints invalidated area of the widget from image, canvas and labels.
+	void paintEvent(QPaintEvent *paintEvent) override;
+
+	/// Resizes canvas to a new widget size.
+	void resizeEvent(QResizeEvent *resizeEvent) override;
+
+	/// Returns area occupied by image.
+	QRect imageRect() const;
+
+	/// Stretches image to the current image area.
+	void scaleImage();
+
+	/// Image shown over primitives, as it was set.
+	QImage mImage;
+
+	/// Image stretched to the image area.
+	QImage mScaledImage;
+
+	/// All primitives drawn on the widget.
+	Canvas mCanvas;
+
+	/// All labels.
+	LabelLayer mLabels;
 };
 
 }
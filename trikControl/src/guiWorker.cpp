@@ -16,10 +16,13 @@
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
 	#include <QtGui/QStackedLayout>
+	#include <QtGui/QApplication>
+	#include <QtGui/QDesktopWidget>
 #else
 	#include <QtWidgets/QStackedLayout>
 	#include <QtWidgets/QPushButton>
 	#include <QtWidgets/QApplication>
+	#include <QtWidgets/QDesktopWidget>
 	#include <QtWidgets/QDialog>
 #endif
 
@@ -27,6 +30,8 @@
 #include <QtCore/QThread>
 #include <QtGui/QPixmap>
 
+#include "drawCommandBuffer.h"
+
 using namespace trikControl;
 
 GuiWorker::GuiWorker()
@@ -36,107 +41,38 @@ GuiWorker::GuiWorker()
 
 void GuiWorker::init()
 {
-	mImageLabel.reset(new QLabel());
 	mImageWidget.reset(new GraphicsWidget());
-	mFontMetrics.reset(new QFontMetrics(mImageWidget->font()));
-
-	QHBoxLayout * const layout = new QHBoxLayout();
-	mImageLabel->setScaledContents(true);
-	layout->addWidget(mImageLabel.data());
-	mImageWidget->setLayout(layout);
 	mImageWidget->setWindowState(Qt::WindowFullScreen);
 	mImageWidget->setWindowFlags(mImageWidget->windowFlags() | Qt::WindowStaysOnTopHint);
 	resetBackground();
+
+	// Widget is full screen, but it gets its size only when shown.
+	setImageSize(QApplication::desktop()->screenGeometry(mImageWidget.data()).size() - QSize(20, 20));
 }
 
-void GuiWorker::showImage(QString const &fileName)
+void GuiWorker::setImage(QImage const &image)
 {
-	if (!mImagesCache.contains(fileName)) {
-		QPixmap pixmap(fileName);
-		pixmap = pixmap.scaled(mImageWidget->size() - QSize(20, 20), Qt::KeepAspectRatio);
-		mImagesCache.insert(fileName, pixmap);
+	mImageWidget->setImage(image);
+	if (!image.isNull()) {
+		mImageWidget->show();
 	}
-
-	mImageLabel->setPixmap(mImagesCache.value(fileName));
-	mImageWidget->show();
 }
 
 void GuiWorker::addLabel(QString const &text, int x, int y)
 {
-	QLabel *label = findLabel(x, y);
-	label = label ? label : new QLabel(mImageWidget.data());
-	label->setText(text);
-	label->setStyleSheet(QString("color: %1").arg(mImageWidget->currentPenColor().name()));
-
-	// There is no layout for the label, so its size cannot be set automatically. We set
-	// it with QFontMetrics.
-	label->setGeometry(x, y, mFontMetrics->width(text), mFontMetrics->height());
-
-	label->show();
-	if (!mLabels.contains(x ^ y, label)) {
-		mLabels.insertMulti(x ^ y, label);
-	}
-
+	mImageWidget->addLabel(text, x, y);
 	mImageWidget->show();
 }
 
 void GuiWorker::removeLabels()
 {
-	foreach (QLabel * const label, mLabels.values()) {
-		label->close();
-		delete label;
-	}
-
-	mLabels.clear();
-}
-
-void GuiWorker::deleteWorker()
-{
-	deleteLater();
+	mImageWidget->removeLabels();
 }
 
 void GuiWorker::setBackground(QString const &color)
 {
 	QPalette palette = mImageWidget->palette();
-
-	if (color == tr("white")) {
-		palette.setColor(QPalette::Window, Qt::white);
-	} else if (color == tr("black")) {
-		palette.setColor(QPalette::Window, Qt::black);
-	} else if (color == tr("red")) {
-		palette.setColor(QPalette::Window, Qt::red);
-	} else if (color == tr("darkRed")) {
-		palette.setColor(QPalette::Window, Qt::darkRed);
-	} else if (color == tr("green")) {
-		palette.setColor(QPalette::Window, Qt::green);
-	} else if (color == tr("darkGreen")) {
-		palette.setColor(QPalette::Window, Qt::darkGreen);
-	} else if (color == tr("blue")) {
-		palette.setColor(QPalette::Window, Qt::blue);
-	} else if (color == tr("darkBlue")) {
-		palette.setColor(QPalette::Window, Qt::darkBlue);
-	} else if (color == tr("cyan")) {
-		palette.setColor(QPalette::Window, Qt::cyan);
-	} else if (color == tr("darkCyan")) {
-		palette.setColor(QPalette::Window, Qt::darkCyan);
-	} else if (color == tr("magenta")) {
-		palette.setColor(QPalette::Window, Qt::magenta);
-	} else if (color == tr("darkMagenta")) {
-		palette.setColor(QPalette::Window, Qt::darkMagenta);
-	} else if (color == tr("yellow")) {
-		palette.setColor(QPalette::Window, Qt::yellow);
-	} else if (color == tr("darkYellow")) {
-		palette.setColor(QPalette::Window, Qt::darkYellow);
-	} else if (color == tr("gray")) {
-		palette.setColor(QPalette::Window, Qt::gray);
-	} else if (color == tr("darkGray")) {
-		palette.setColor(QPalette::Window, Qt::darkGray);
-	} else if (color == tr("lightGray")) {
-		palette.setColor(QPalette::Window, Qt::lightGray);
-	} else {
-		palette.setColor(QPalette::Window, QColor(color));
-	}
-
+	palette.setColor(QPalette::Window, backgroundColor(color));
 	mImageWidget->setPalette(palette);
 	mImageWidget->show();
 }
@@ -165,57 +101,48 @@ void GuiWorker::clear()
 	mImageWidget->setPainterWidth(1);
 	mImageWidget->hide();
 	removeLabels();
-	mImageLabel->setPixmap(QPixmap());
+	clearImage();
 	resetBackground();
 }
 
 void GuiWorker::hide()
 {
+	stopAnimation();
 	mImageWidget->hide();
 }
 
-QLabel *GuiWorker::findLabel(int x, int y) const
-{
-	foreach (QLabel * const label, mLabels.values(x ^ y)) {
-		if (label->x() == x && label->y() == y) {
-			return label;
-		}
-	}
-
-	return NULL;
-}
-
 void GuiWorker::drawPoint(int x, int y)
 {
 	mImageWidget->drawPoint(x, y);
-	mImageWidget->update();
 	mImageWidget->show();
 }
 
 void GuiWorker::drawLine(int x1, int y1, int x2, int y2)
 {
 	mImageWidget->drawLine(x1, y1, x2, y2);
-	mImageWidget->update();
 	mImageWidget->show();
 }
 
 void GuiWorker::drawRect(int x, int y, int width, int height)
 {
 	mImageWidget->drawRect(x, y, width, height);
-	mImageWidget->update();
 	mImageWidget->show();
 }
 
 void GuiWorker::drawEllipse(int x, int y, int width, int height)
 {
 	mImageWidget->drawEllipse(x, y, width, height);
-	mImageWidget->update();
 	mImageWidget->show();
 }
 
 void GuiWorker::drawArc(int x, int y, int width, int height, int startAngle, int spanAngle)
 {
 	mImageWidget->drawArc(x, y, width, height, startAngle, spanAngle);
-	mImageWidget->update();
 	mImageWidget->show();
 }
+
+void GuiWorker::drawFrame(DrawCommandBuffer const &frame)
+{
+	// Frame may contain image, label and visibility commands, so it is replayed through the worker itself.
+	frame.replay(*this);
+}
@@ -0,0 +1,36 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include "deviceBackendInterface.h"
+
+namespace trikControl {
+
+/// Backend that works with real robot hardware: Linux I2C device, sysfs files, evdev input devices and FIFO-based
+/// virtual sensors.
+class HardwareDeviceBackend : public DeviceBackendInterface
+{
+public:
+	I2cBusInterface *createI2cBus(QString const &devicePath, int deviceId) override;
+
+	DeviceFileInterface *createDeviceFile(QString const &fileName) override;
+
+	EventDeviceInterface *createEventDevice(QString const &fileName) override;
+
+	VirtualSensorDeviceInterface *createVirtualSensorDevice(QString const &script, QString const &inputFile
+			, QString const &outputFile) override;
+};
+
+}
@@ -0,0 +1,73 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QString>
+#include <QtGui/QImage>
+
+#include "framebufferInterface.h"
+
+namespace trikControl {
+
+/// Linux framebuffer device mapped into memory. If virtual screen of a device is at least two screens high, frames
+/// are drawn directly into screen memory and flipped by panning the display, without waiting for vertical sync.
+/// Otherwise frames are drawn off-screen and only changed area is copied to screen memory on flip. Pixel layouts
+/// of Qt RGB16, RGB888 and RGB32 formats are supported, and also their variants with red and blue channels swapped,
+/// which are always drawn off-screen and converted when copied.
+class HardwareFramebuffer : public FramebufferInterface
+{
+public:
+	/// Constructor.
+	/// @param devicePath - path to framebuffer device file, for example "/dev/fb0".
+	explicit HardwareFramebuffer(QString const &devicePath);
+
+	~HardwareFramebuffer() override;
+
+	QImage &backBuffer() override;
+
+	void flip(QRect const &changedArea) override;
+
+private:
+	/// Opens and maps framebuffer device, returns false if something went wrong.
+	bool open(QString const &devicePath);
+
+	/// Unmaps and closes framebuffer device.
+	void close();
+
+	int mDeviceFileDescriptor;
+
+	/// Mapped screen memory.
+	uchar *mMemory;
+
+	/// Size of mapped screen memory in bytes.
+	int mMemorySize;
+
+	/// Screen pages wrapped into images that share screen memory.
+	QImage mPages[2];
+
+	/// Number of pages in screen memory, 1 if page flipping is not supported.
+	int mPageCount;
+
+	/// Index of a page that is not shown now.
+	int mBackPage;
+
+	/// Back buffer used when there is only one page, pixels need conversion or framebuffer device could not be opened.
+	QImage mOffscreen;
+
+	/// True if screen has red and blue channels swapped relative to mOffscreen format.
+	bool mSwapRedBlue;
+};
+
+}
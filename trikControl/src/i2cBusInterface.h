@@ -0,0 +1,37 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+
+namespace trikControl {
+
+/// Low-level access to I2C bus, implemented by real hardware and by simulator. Does no locking by itself,
+/// I2cCommunicator serializes calls.
+class I2cBusInterface
+{
+public:
+	virtual ~I2cBusInterface() {}
+
+	/// Sends data to a device. First byte of data is a command (register) number.
+	/// @returns negative value on error.
+	virtual int send(QByteArray const &data) = 0;
+
+	/// Reads data from a device. First byte of data is a command (register) number, size of data selects
+	/// transaction type: one byte for a word read, more for a 4-byte block read.
+	virtual int read(QByteArray const &data) = 0;
+};
+
+}
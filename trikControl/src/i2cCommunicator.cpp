@@ -0,0 +1,58 @@
+/* Copyright 2013 Yurii Litvinov
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/i2cCommunicator.h"
+
+#include <trikKernel/metricsRegistry.h>
+#include <trikKernel/scopedTimer.h>
+
+#include "src/i2cBusInterface.h"
+
+using namespace trikControl;
+
+I2cCommunicator::I2cCommunicator(I2cBusInterface *bus)
+	: mBus(bus)
+{
+}
+
+I2cCommunicator::~I2cCommunicator()
+{
+}
+
+void I2cCommunicator::send(QByteArray const &data)
+{
+	static trikKernel::Counter &sends = trikKernel::MetricsRegistry::counter("i2c.sends");
+	static trikKernel::Counter &errors = trikKernel::MetricsRegistry::counter("i2c.errors");
+	static trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("i2c.sendLatencyUs");
+
+	trikKernel::ScopedTimer const timer(latency);
+	sends.increment();
+
+	QMutexLocker lock(&mLock);
+	if (mBus->send(data) < 0) {
+		errors.increment();
+	}
+}
+
+int I2cCommunicator::read(QByteArray const &data)
+{
+	static trikKernel::Counter &reads = trikKernel::MetricsRegistry::counter("i2c.reads");
+	static trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("i2c.readLatencyUs");
+
+	trikKernel::ScopedTimer const timer(latency);
+	reads.increment();
+
+	QMutexLocker lock(&mLock);
+	return mBus->read(data);
+}
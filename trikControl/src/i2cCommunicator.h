@@ -14,38 +14,32 @@
 
 #pragma once
 
-#include <QtCore/QString>
 #include <QtCore/QByteArray>
 #include <QtCore/QMutex>
+#include <QtCore/QScopedPointer>
 
 namespace trikControl {
 
-/// Provides direct interaction with I2C device.
+class I2cBusInterface;
+
+/// Provides thread-safe interaction with I2C device. Actual transfers are done by I2C bus provided by device backend.
 class I2cCommunicator
 {
 public:
 	/// Constructor.
-	/// @param devicePath - path to Linux I2C device file.
-	/// @param deviceId - id of I2C device.
-	I2cCommunicator(QString const &devicePath, int deviceId);
+	/// @param bus - I2C bus connected to a device. Takes ownership.
+	explicit I2cCommunicator(I2cBusInterface *bus);
 
 	~I2cCommunicator();
 
 	/// Send data to current device, if it is connected.
 	void send(QByteArray const &data);
 
+	/// Reads data from current device. First byte of data is a command number, size of data selects transaction type.
 	int read(QByteArray const &data);
 
 private:
-	/// Establish connection with current device.
-	void connect();
-
-	/// Disconnect from a device.
-	void disconnect();
-
-	QString const mDevicePath;
-	int const mDeviceId;
-	int mDeviceFileDescriptor;
+	QScopedPointer<I2cBusInterface> mBus;
 	QMutex mLock;
 };
 
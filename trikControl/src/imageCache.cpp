@@ -0,0 +1,132 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "imageCache.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRunnable>
+
+using namespace trikControl;
+
+/// Decodes and scales one image in decoder thread pool and passes it back to cache.
+class ImageCache::DecodeTask : public QRunnable
+{
+public:
+	DecodeTask(ImageCache &cache, QString const &fileName, qint64 modificationTime, QSize const &targetSize)
+		: mCache(cache)
+		, mFileName(fileName)
+		, mModificationTime(modificationTime)
+		, mTargetSize(targetSize)
+	{
+	}
+
+	void run() override
+	{
+		QImage image(mFileName);
+		if (!image.isNull() && mTargetSize.isValid()) {
+			image = image.scaled(mTargetSize, Qt::KeepAspectRatio);
+		}
+
+		// Premultiplied format is the fastest to draw.
+		image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+		QMetaObject::invokeMethod(&mCache, "onDecoded", Qt::QueuedConnection
+				, Q_ARG(QString, mFileName), Q_ARG(qint64, mModificationTime)
+				, Q_ARG(QSize, mTargetSize), Q_ARG(QImage, image));
+	}
+
+private:
+	ImageCache &mCache;
+	QString const mFileName;
+	qint64 const mModificationTime;
+	QSize const mTargetSize;
+};
+
+ImageCache::ImageCache(int capacity, QObject *parent)
+	: QObject(parent)
+	, mCache(capacity)
+{
+	// One decoding thread keeps order of preloaded images and does not steal CPU from scripts.
+	mDecoderPool.setMaxThreadCount(1);
+}
+
+ImageCache::~ImageCache()
+{
+	mDecoderPool.waitForDone();
+}
+
+void ImageCache::setTargetSize(QSize const &size)
+{
+	if (size != mTargetSize) {
+		mTargetSize = size;
+		mCache.clear();
+	}
+}
+
+QImage ImageCache::image(QString const &fileName)
+{
+	return lookup(fileName);
+}
+
+void ImageCache::preload(QString const &fileName)
+{
+	lookup(fileName);
+}
+
+QImage ImageCache::lookup(QString const &fileName)
+{
+	qint64 const fileTime = modificationTime(fileName);
+	Entry const * const entry = mCache.object(fileName);
+	if (entry && entry->modificationTime == fileTime) {
+		return entry->image;
+	}
+
+	if (!mDecoding.contains(fileName)) {
+		mDecoding.insert(fileName);
+		DecodeTask * const task = new DecodeTask(*this, fileName, fileTime, mTargetSize);
+		task->setAutoDelete(true);
+		mDecoderPool.start(task);
+	}
+
+	return QImage();
+}
+
+void ImageCache::onDecoded(QString const &fileName, qint64 modificationTime, QSize const &targetSize
+		, QImage const &image)
+{
+	mDecoding.remove(fileName);
+	if (targetSize != mTargetSize) {
+		// Target size was changed while image was decoded, result is useless.
+		lookup(fileName);
+		return;
+	}
+
+	// Failed decoding is not cached, otherwise null image would be taken for an image that is still decoding. Image
+	// that is larger than capacity is not cached either, but still can be shown once.
+	if (image.isNull()) {
+		qDebug() << "Failed to decode image" << fileName;
+	} else if (!mCache.insert(fileName, new Entry{image, modificationTime}, image.byteCount())) {
+		qDebug() << "Image" << fileName << "is too large for image cache";
+	}
+
+	emit imageLoaded(fileName, image);
+}
+
+qint64 ImageCache::modificationTime(QString const &fileName)
+{
+	QFileInfo const info(fileName);
+	return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
@@ -0,0 +1,90 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+#include <QtCore/QThreadPool>
+#include <QtGui/QImage>
+
+namespace trikControl {
+
+/// Cache of images decoded and scaled to fit the screen. Images are decoded in background threads, so GUI thread
+/// never waits for decoding. Cache is bounded by total size of images in bytes and evicts least recently used images
+/// first. Images are identified by file name and modification time of a file, so changed file is decoded again.
+/// Shall be used only from the thread it lives in.
+class ImageCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param capacity - maximal total size of cached images in bytes.
+	/// @param parent - parent of this object in Qt object hierarchy.
+	ImageCache(int capacity, QObject *parent = nullptr);
+
+	~ImageCache() override;
+
+	/// Sets size to which images shall be scaled, keeping aspect ratio. Drops all cached images.
+	void setTargetSize(QSize const &size);
+
+	/// Returns decoded image or null image if it is not decoded yet. In the latter case decoding is started and
+	/// imageLoaded() will be emitted when image is ready. Image that can not be decoded is not cached, so every request
+	/// for it starts decoding again and leads to imageLoaded() with null image.
+	QImage image(QString const &fileName);
+
+	/// Starts decoding of an image in background if it is not cached yet.
+	void preload(QString const &fileName);
+
+signals:
+	/// Emitted when decoding of an image is finished, with null image if it failed.
+	void imageLoaded(QString const &fileName, QImage const &image);
+
+private slots:
+	/// Puts decoded image into cache. Called from decoding thread by queued connection.
+	void onDecoded(QString const &fileName, qint64 modificationTime, QSize const &targetSize, QImage const &image);
+
+private:
+	class DecodeTask;
+
+	/// Decoded image with modification time of its file.
+	struct Entry
+	{
+		QImage image;
+		qint64 modificationTime;
+	};
+
+	/// Returns modification time of a file in milliseconds since epoch, or -1 if there is no such file.
+	static qint64 modificationTime(QString const &fileName);
+
+	/// Returns cached image if it is up to date with a file, otherwise starts decoding and returns null image.
+	QImage lookup(QString const &fileName);
+
+	/// Images by file names.
+	QCache<QString, Entry> mCache;
+
+	/// Files that are being decoded now.
+	QSet<QString> mDecoding;
+
+	QSize mTargetSize;
+
+	/// Threads used for decoding.
+	QThreadPool mDecoderPool;
+};
+
+}
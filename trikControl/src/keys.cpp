@@ -16,12 +16,19 @@
 
 #include "src/keysWorker.h"
 
+Q_DECLARE_METATYPE(QVector<int>)
+
 using namespace trikControl;
 
-Keys::Keys(const QString &keysPath)
-	: mKeysWorker(new KeysWorker(keysPath))
+Keys::Keys(DeviceBackendInterface &backend, QString const &keysPath)
+	: mKeysWorker(new KeysWorker(backend, keysPath))
 {
+	qRegisterMetaType<QVector<int>>("QVector<int>");
+
 	connect(mKeysWorker.data(), SIGNAL(buttonPressed(int,int)), this, SIGNAL(buttonPressed(int,int)));
+	connect(mKeysWorker.data(), SIGNAL(released(int,int)), this, SIGNAL(released(int,int)));
+	connect(mKeysWorker.data(), SIGNAL(longPressed(int)), this, SIGNAL(longPressed(int)));
+	connect(mKeysWorker.data(), SIGNAL(chordPressed(QVector<int>)), this, SIGNAL(chordPressed(QVector<int>)));
 	mKeysWorker->moveToThread(&mWorkerThread);
 	mWorkerThread.start();
 }
@@ -41,3 +48,13 @@ bool Keys::wasPressed(int code)
 {
 	return mKeysWorker->wasPressed(code);
 }
+
+bool Keys::isPressed(int code)
+{
+	return mKeysWorker->isPressed(code);
+}
+
+int Keys::pressDuration(int code)
+{
+	return mKeysWorker->pressDuration(code);
+}
@@ -14,32 +14,55 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <QtCore/QObject>
-#include <QtCore/QSocketNotifier>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QSet>
-#include <QtCore/QReadWriteLock>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include "atomicBitset.h"
 
 namespace trikControl {
 
-/// Watches for keys on a brick, intended to work in separate thread.
+class DeviceBackendInterface;
+class EventDeviceInterface;
+
+/// Watches for keys on a brick, intended to work in separate thread. State of keys is kept in atomic bitsets and
+/// arrays indexed by key code, so it can be queried from other threads without locks. Press durations, long presses
+/// and chords are computed from timestamps of input events, so they do not depend on delays in event delivery.
 class KeysWorker : public QObject
 {
 	Q_OBJECT
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to input device.
 	/// @param keysPath - path to device file that controls brick keys.
-	KeysWorker(QString const &keysPath);
+	KeysWorker(DeviceBackendInterface &backend, QString const &keysPath);
+
+	~KeysWorker() override;
 
 	/// Clear data about previous key pressures.
 	void reset();
 
 public slots:
+	/// Returns true, if button with given code was pressed, and clears "pressed" state for that button.
 	bool wasPressed(int code);
 
+	/// Returns true if button with given code is pressed now.
+	bool isPressed(int code);
+
+	/// Returns time in milliseconds for which button with given code is held, or 0 if it is not pressed.
+	int pressDuration(int code);
+
 private slots:
-	void readKeysEvent();
+	/// Handles event from keys input device.
+	void onNewEvent(int eventType, int code, int value, qint64 timestamp);
+
+	/// Emits longPressed() for buttons held long enough and schedules next check.
+	void checkLongPresses();
 
 signals:
 	/// Triggered when button state changed (pressed or released).
@@ -47,13 +70,52 @@ signals:
 	/// @param value - key state.
 	void buttonPressed(int code, int value);
 
+	/// Triggered when button is released.
+	/// @param code - key code.
+	/// @param duration - time in milliseconds for which button was held.
+	void released(int code, int duration);
+
+	/// Triggered once per press when button is held for longer than long press threshold.
+	/// @param code - key code.
+	void longPressed(int code);
+
+	/// Triggered when a button is pressed while other buttons pressed shortly before are still held.
+	/// @param codes - sorted codes of all buttons in a chord.
+	void chordPressed(QVector<int> const &codes);
+
 private:
-	QScopedPointer<QSocketNotifier> mSocketNotifier;
-	int mKeysFileDescriptor;
-	int mButtonCode;
-	int mButtonValue;
-	QSet<int> mWasPressed;
-	QReadWriteLock mLock;
+	/// Maximal key code, KEY_MAX from linux/input.h.
+	static int const maxKeyCode = 0x2ff;
+
+	/// Key event received since last EV_SYN.
+	struct KeyEvent {
+		int code;
+		int value;
+		qint64 timestamp;
+	};
+
+	/// Updates state of a key and emits corresponding signals.
+	void applyKeyEvent(KeyEvent const &event);
+
+	QScopedPointer<EventDeviceInterface> mEventDevice;
+
+	/// Key events received since last EV_SYN.
+	QVector<KeyEvent> mPendingKeys;
+
+	/// Keys that were pressed since last query.
+	AtomicBitset<maxKeyCode + 1> mWasPressed;
+
+	/// Keys that are pressed now.
+	AtomicBitset<maxKeyCode + 1> mIsPressed;
+
+	/// Timestamps of the last press of each key.
+	std::atomic<qint64> mPressTimes[maxKeyCode + 1];
+
+	/// Pressed keys for which longPressed() was not emitted yet. Used only in worker thread.
+	QSet<int> mAwaitingLongPress;
+
+	/// Fires when the earliest of mAwaitingLongPress keys becomes long pressed.
+	QTimer mLongPressTimer;
 };
 
 }
@@ -0,0 +1,78 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "labelLayer.h"
+
+#include <QtCore/qmath.h>
+#include <QtGui/QTransform>
+
+using namespace trikControl;
+
+LabelLayer::LabelLayer(QFont const &font)
+	: mFont(font)
+{
+}
+
+QRect LabelLayer::setLabel(QString const &text, int x, int y, QColor const &color)
+{
+	Label &label = mLabels[key(x, y)];
+	if (label.text == text && label.color == color && !label.rect.isNull()) {
+		return QRect();
+	}
+
+	QRect const oldRect = label.rect;
+
+	label.color = color;
+	if (label.text != text || label.rect.isNull()) {
+		label.text = text;
+		label.staticText.setText(text);
+		label.staticText.setTextFormat(Qt::PlainText);
+		label.staticText.prepare(QTransform(), mFont);
+		QSizeF const size = label.staticText.size();
+		label.rect = QRect(x, y, qCeil(size.width()), qCeil(size.height()));
+	}
+
+	return oldRect.united(label.rect);
+}
+
+QRect LabelLayer::clear()
+{
+	QRect result;
+	for (Label const &label : mLabels) {
+		result = result.united(label.rect);
+	}
+
+	mLabels.clear();
+	return result;
+}
+
+void LabelLayer::paint(QPainter &painter, QRect const &area) const
+{
+	if (mLabels.isEmpty()) {
+		return;
+	}
+
+	painter.setFont(mFont);
+	for (Label const &label : mLabels) {
+		if (label.rect.intersects(area)) {
+			painter.setPen(label.color);
+			painter.drawStaticText(label.rect.topLeft(), label.staticText);
+		}
+	}
+}
+
+quint64 LabelLayer::key(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
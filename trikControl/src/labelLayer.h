@@ -0,0 +1,67 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QRect>
+#include <QtCore/QString>
+#include <QtGui/QColor>
+#include <QtGui/QFont>
+#include <QtGui/QPainter>
+#include <QtGui/QStaticText>
+
+namespace trikControl {
+
+/// Text labels of a display, painted over other display contents. Layout of label text is computed once, when label
+/// text changes, so repainting a label is just drawing of prepared glyphs. Methods that change labels return area
+/// that shall be repainted.
+class LabelLayer
+{
+public:
+	/// Constructor.
+	/// @param font - font of all labels.
+	explicit LabelLayer(QFont const &font);
+
+	/// Sets text and color of a label with given top left corner, adding a label if there is no such label yet.
+	QRect setLabel(QString const &text, int x, int y, QColor const &color);
+
+	/// Removes all labels.
+	QRect clear();
+
+	/// Paints labels that intersect given area.
+	void paint(QPainter &painter, QRect const &area) const;
+
+private:
+	/// Label with prepared text layout.
+	struct Label
+	{
+		QString text;
+		QStaticText staticText;
+		QColor color;
+
+		/// Area covered by the label.
+		QRect rect;
+	};
+
+	/// Returns key of a label with given coordinates.
+	static quint64 key(int x, int y);
+
+	QFont const mFont;
+
+	/// Labels by their coordinates.
+	QHash<quint64, Label> mLabels;
+};
+
+}
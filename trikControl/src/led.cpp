@@ -14,31 +14,23 @@
 
 #include "led.h"
 
-#include <QtCore/QDebug>
+#include "src/deviceBackendInterface.h"
+#include "src/deviceFileInterface.h"
 
 using namespace trikControl;
 
-Led::Led(QString const &redDeviceFile, QString const &greenDeviceFile, int on, int off)
-	: mRedDeviceFile(redDeviceFile)
-	, mGreenDeviceFile(greenDeviceFile)
+Led::Led(DeviceBackendInterface &backend, QString const &redDeviceFile, QString const &greenDeviceFile
+		, int on, int off)
+	: mRedDeviceFile(backend.createDeviceFile(redDeviceFile))
+	, mGreenDeviceFile(backend.createDeviceFile(greenDeviceFile))
 	, mOn(on)
 	, mOff(off)
 {
-	if (!mRedDeviceFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open red led control file " << mRedDeviceFile.fileName();
-	}
-
-	if (!mGreenDeviceFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open green led control file " << mGreenDeviceFile.fileName();
-	}
 }
 
 Led::~Led()
 {
 	red();
-
-	mRedDeviceFile.close();
-	mGreenDeviceFile.close();
 }
 
 void Led::red()
@@ -47,8 +39,7 @@ void Led::red()
 
 	QString const command = QString::number(mOn);
 
-	mRedDeviceFile.write(command.toLatin1());
-	mRedDeviceFile.flush();
+	mRedDeviceFile->write(command.toLatin1());
 }
 
 void Led::green()
@@ -57,28 +48,21 @@ void Led::green()
 
 	QString const command = QString::number(mOn);
 
-	mGreenDeviceFile.write(command.toLatin1());
-	mGreenDeviceFile.flush();
+	mGreenDeviceFile->write(command.toLatin1());
 }
 
 void Led::orange()
 {
 	QString const command = QString::number(mOn);
 
-	mRedDeviceFile.write(command.toLatin1());
-	mRedDeviceFile.flush();
-
-	mGreenDeviceFile.write(command.toLatin1());
-	mGreenDeviceFile.flush();
+	mRedDeviceFile->write(command.toLatin1());
+	mGreenDeviceFile->write(command.toLatin1());
 }
 
 void Led::off()
 {
 	QString const command = QString::number(mOff);
 
-	mRedDeviceFile.write(command.toLatin1());
-	mRedDeviceFile.flush();
-
-	mGreenDeviceFile.write(command.toLatin1());
-	mGreenDeviceFile.flush();
+	mRedDeviceFile->write(command.toLatin1());
+	mGreenDeviceFile->write(command.toLatin1());
 }
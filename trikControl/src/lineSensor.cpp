@@ -20,9 +20,9 @@
 
 using namespace trikControl;
 
-LineSensor::LineSensor(QString const &script, QString const &inputFile, QString const &outputFile
-		, double toleranceFactor)
-	: mLineSensorWorker(new LineSensorWorker(script, inputFile, outputFile, toleranceFactor))
+LineSensor::LineSensor(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+		, QString const &outputFile, double toleranceFactor)
+	: mLineSensorWorker(new LineSensorWorker(backend, script, inputFile, outputFile, toleranceFactor))
 {
 	mLineSensorWorker->moveToThread(&mWorkerThread);
 	mWorkerThread.start();
@@ -18,9 +18,9 @@
 
 using namespace trikControl;
 
-LineSensorWorker::LineSensorWorker(QString const &script, QString const &inputFile, QString const &outputFile
-		, double toleranceFactor)
-	: AbstractVirtualSensorWorker(script, inputFile, outputFile)
+LineSensorWorker::LineSensorWorker(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+		, QString const &outputFile, double toleranceFactor)
+	: AbstractVirtualSensorWorker(backend, script, inputFile, outputFile)
 	, mToleranceFactor(toleranceFactor)
 {
 }
@@ -23,6 +23,8 @@
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+
 /// Worker object that processes line sensor output and updates stored reading. Meant to be executed in separate
 /// thread.
 class LineSensorWorker : public AbstractVirtualSensorWorker
@@ -31,13 +33,14 @@ class LineSensorWorker : public AbstractVirtualSensorWorker
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides connection to a sensor.
 	/// @param script - file name of a scrit used to start or stop a sensor.
 	/// @param inputFile - sensor input fifo. Note that we will write data here, not read it.
 	/// @param outputFile - sensor output fifo. Note that we will read sensor data from here.
 	/// @param toleranceFactor - a value on which hueTolerance, saturationTolerance and valueTolerance is multiplied
 	///        after "detect" command. Higher values allow to count more points on an image as tracked object.
-	LineSensorWorker(QString const &script, QString const &inputFile, QString const &outputFile
-			, double toleranceFactor);
+	LineSensorWorker(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+			, QString const &outputFile, double toleranceFactor);
 
 	~LineSensorWorker() override;
 
@@ -0,0 +1,95 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/evdevEventDevice.h"
+
+#include <QtCore/QDebug>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+#include "src/monotonicClock.h"
+
+using namespace trikControl;
+
+/// Maximal number of events read from a device with one system call.
+static int const eventsPerRead = 64;
+
+EvdevEventDevice::EvdevEventDevice(QString const &fileName)
+	: mDeviceFileDescriptor(-1)
+	, mFileName(fileName)
+	, mHasMonotonicTimestamps(false)
+{
+	mDeviceFileDescriptor = open(fileName.toStdString().c_str(), O_RDONLY | O_NONBLOCK);
+	if (mDeviceFileDescriptor == -1) {
+		qDebug() << "Cannot open input file " << fileName;
+		return;
+	}
+
+#ifdef EVIOCSCLOCKID
+	int clock = CLOCK_MONOTONIC;
+	mHasMonotonicTimestamps = ioctl(mDeviceFileDescriptor, EVIOCSCLOCKID, &clock) == 0;
+#endif
+
+	mSocketNotifier.reset(new QSocketNotifier(mDeviceFileDescriptor, QSocketNotifier::Read, this));
+
+	connect(mSocketNotifier.data(), SIGNAL(activated(int)), this, SLOT(readEvents()));
+	mSocketNotifier->setEnabled(true);
+}
+
+EvdevEventDevice::~EvdevEventDevice()
+{
+	if (mDeviceFileDescriptor != -1) {
+		close(mDeviceFileDescriptor);
+	}
+}
+
+void EvdevEventDevice::readEvents()
+{
+	struct input_event events[eventsPerRead];
+
+	mSocketNotifier->setEnabled(false);
+
+	// Drain all pending events, reading as many of them as fit into a buffer with each system call.
+	for (;;) {
+		ssize_t const size = ::read(mDeviceFileDescriptor, reinterpret_cast<char *>(events), sizeof(events));
+		if (size <= 0) {
+			break;
+		}
+
+		int const count = static_cast<int>(size / sizeof(struct input_event));
+		qint64 const readTime = MonotonicClock::msecs();
+		for (int i = 0; i < count; ++i) {
+			qint64 const timestamp = mHasMonotonicTimestamps
+					? static_cast<qint64>(events[i].time.tv_sec) * 1000 + events[i].time.tv_usec / 1000
+					: readTime;
+
+			emit newEvent(events[i].type, events[i].code, events[i].value, timestamp);
+		}
+
+		if (size % sizeof(struct input_event) != 0) {
+			qDebug() << mFileName << ": incomplete data read";
+			break;
+		}
+
+		if (count < eventsPerRead) {
+			break;
+		}
+	}
+
+	mSocketNotifier->setEnabled(true);
+}
@@ -12,18 +12,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License. */
 
-#include "src/abstractVirtualSensorWorker.h"
+#include "src/fifoVirtualSensorDevice.h"
 
 #include <QtCore/QDebug>
 #include <QtCore/QFileInfo>
 
+#include <trikKernel/metricsRegistry.h>
+
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
 
 using namespace trikControl;
 
-AbstractVirtualSensorWorker::AbstractVirtualSensorWorker(QString const &script, QString const &inputFile
+FifoVirtualSensorDevice::FifoVirtualSensorDevice(QString const &script, QString const &inputFile
 		, QString const &outputFile)
 	: mScript(script)
 	, mSensorProcess(this)
@@ -32,19 +34,35 @@ AbstractVirtualSensorWorker::AbstractVirtualSensorWorker(QString const &script,
 {
 }
 
-AbstractVirtualSensorWorker::~AbstractVirtualSensorWorker()
+FifoVirtualSensorDevice::~FifoVirtualSensorDevice()
 {
 	stop();
 }
 
-void AbstractVirtualSensorWorker::stop()
+void FifoVirtualSensorDevice::stop()
 {
 	if (mReady) {
 		deinitialize();
 	}
 }
 
-void AbstractVirtualSensorWorker::init()
+bool FifoVirtualSensorDevice::isReady() const
+{
+	return mReady;
+}
+
+void FifoVirtualSensorDevice::send(QString const &command)
+{
+	mInputStream << command + "\n";
+	mInputStream.flush();
+}
+
+QString FifoVirtualSensorDevice::sensorName() const
+{
+	return QFileInfo(mScript).baseName();
+}
+
+void FifoVirtualSensorDevice::start()
 {
 	if (mReady && mInputFile.exists() && mOutputFile.exists()) {
 		// Sensor is up and ready.
@@ -58,17 +76,24 @@ void AbstractVirtualSensorWorker::init()
 	}
 }
 
-void AbstractVirtualSensorWorker::readFile()
+void FifoVirtualSensorDevice::readFile()
 {
+	static trikKernel::Counter &lineCount = trikKernel::MetricsRegistry::counter("virtualSensor.fifoLines");
+	static trikKernel::Histogram &readSize = trikKernel::MetricsRegistry::histogram("virtualSensor.fifoReadBytes");
+
 	char data[4000] = {0};
 
 	mSocketNotifier->setEnabled(false);
 
-	if (::read(mOutputFileDescriptor, data, 4000) < 0) {
+	int const bytesRead = ::read(mOutputFileDescriptor, data, sizeof(data) - 1);
+	if (bytesRead < 0) {
 		qDebug() << mOutputFile.fileName() << ": fifo read failed: " << errno;
+		mSocketNotifier->setEnabled(true);
 		return;
 	}
 
+	readSize.record(bytesRead);
+
 	mBuffer += data;
 
 	if (mBuffer.contains("\n")) {
@@ -76,16 +101,17 @@ void AbstractVirtualSensorWorker::readFile()
 
 		mBuffer = lines.last();
 		lines.removeLast();
+		lineCount.increment(lines.size());
 
-		for (QString const line : lines) {
-			onNewData(line);
+		for (QString const &line : lines) {
+			emit newData(line);
 		}
 	}
 
 	mSocketNotifier->setEnabled(true);
 }
 
-bool AbstractVirtualSensorWorker::launchSensorScript(QString const &command)
+bool FifoVirtualSensorDevice::launchSensorScript(QString const &command)
 {
 	qDebug() << "Sending" << command << "command to" << sensorName() << "sensor";
 
@@ -125,7 +151,7 @@ bool AbstractVirtualSensorWorker::launchSensorScript(QString const &command)
 	return true;
 }
 
-void AbstractVirtualSensorWorker::startVirtualSensor()
+void FifoVirtualSensorDevice::startVirtualSensor()
 {
 	if (launchSensorScript("start")) {
 		qDebug() << sensorName() << "sensor started, waiting for it to initialize...";
@@ -133,7 +159,7 @@ void AbstractVirtualSensorWorker::startVirtualSensor()
 	}
 }
 
-void AbstractVirtualSensorWorker::openFifos()
+void FifoVirtualSensorDevice::openFifos()
 {
 	if (mInputFile.isOpen()) {
 		mInputFile.close();
@@ -166,17 +192,9 @@ void AbstractVirtualSensorWorker::openFifos()
 	mReady = true;
 
 	qDebug() << sensorName() << "initialization completed";
-
-	sync();
-}
-
-void AbstractVirtualSensorWorker::sendCommand(QString const &command)
-{
-	mCommandQueue << command;
-	sync();
 }
 
-void AbstractVirtualSensorWorker::deinitialize()
+void FifoVirtualSensorDevice::deinitialize()
 {
 	if (mSocketNotifier) {
 		disconnect(mSocketNotifier.data(), SIGNAL(activated(int)), this, SLOT(readFile()));
@@ -196,15 +214,3 @@ void AbstractVirtualSensorWorker::deinitialize()
 
 	mReady = false;
 }
-
-void AbstractVirtualSensorWorker::sync()
-{
-	if (mReady) {
-		for (QString const &command : mCommandQueue) {
-			mInputStream << command + "\n";
-			mInputStream.flush();
-		}
-
-		mCommandQueue.clear();
-	}
-}
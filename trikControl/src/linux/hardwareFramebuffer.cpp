@@ -0,0 +1,199 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/hardwareFramebuffer.h"
+
+#include <QtCore/QDebug>
+#include <QtGui/QPainter>
+
+#include <fcntl.h>
+#include <linux/fb.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace trikControl;
+
+namespace {
+
+/// Layout of pixels in screen memory that corresponds to Qt image format.
+struct PixelLayout
+{
+	__u32 bitsPerPixel;
+	QImage::Format format;
+	fb_bitfield red;
+	fb_bitfield green;
+	fb_bitfield blue;
+};
+
+}
+
+/// Layouts in which screen memory can be wrapped into an image directly.
+static PixelLayout const pixelLayouts[] = {
+	{16, QImage::Format_RGB16, {11, 5, 0}, {5, 6, 0}, {0, 5, 0}}
+	, {24, QImage::Format_RGB888, {0, 8, 0}, {8, 8, 0}, {16, 8, 0}}
+	, {32, QImage::Format_RGB32, {16, 8, 0}, {8, 8, 0}, {0, 8, 0}}
+};
+
+static bool operator ==(fb_bitfield const &left, fb_bitfield const &right)
+{
+	return left.offset == right.offset && left.length == right.length && left.msb_right == right.msb_right;
+}
+
+HardwareFramebuffer::HardwareFramebuffer(QString const &devicePath)
+	: mDeviceFileDescriptor(-1)
+	, mMemory(nullptr)
+	, mMemorySize(0)
+	, mPageCount(0)
+	, mBackPage(0)
+	, mSwapRedBlue(false)
+{
+	if (!open(devicePath)) {
+		close();
+		qDebug() << "Failed to open framebuffer" << devicePath << ", display output will be lost";
+		mOffscreen = QImage(240, 320, QImage::Format_RGB16);
+	}
+}
+
+HardwareFramebuffer::~HardwareFramebuffer()
+{
+	close();
+}
+
+bool HardwareFramebuffer::open(QString const &devicePath)
+{
+	mDeviceFileDescriptor = ::open(devicePath.toStdString().c_str(), O_RDWR);
+	if (mDeviceFileDescriptor < 0) {
+		return false;
+	}
+
+	fb_fix_screeninfo fixInfo;
+	fb_var_screeninfo varInfo;
+	if (ioctl(mDeviceFileDescriptor, FBIOGET_FSCREENINFO, &fixInfo) < 0
+			|| ioctl(mDeviceFileDescriptor, FBIOGET_VSCREENINFO, &varInfo) < 0)
+	{
+		return false;
+	}
+
+	QImage::Format format = QImage::Format_Invalid;
+	for (PixelLayout const &layout : pixelLayouts) {
+		if (layout.bitsPerPixel != varInfo.bits_per_pixel || !(layout.green == varInfo.green)) {
+			continue;
+		}
+
+		if (layout.red == varInfo.red && layout.blue == varInfo.blue) {
+			format = layout.format;
+		} else if (layout.red == varInfo.blue && layout.blue == varInfo.red) {
+			// BGR565, BGR888 or BGR32 screen, frames are drawn in RGB and converted on flip.
+			format = layout.format;
+			mSwapRedBlue = true;
+		}
+	}
+
+	if (format == QImage::Format_Invalid) {
+		qDebug() << "Unsupported framebuffer pixel layout:" << varInfo.bits_per_pixel << "bits per pixel, red"
+				<< varInfo.red.offset << varInfo.red.length << ", green" << varInfo.green.offset
+				<< varInfo.green.length << ", blue" << varInfo.blue.offset << varInfo.blue.length;
+		return false;
+	}
+
+	mMemorySize = fixInfo.smem_len;
+	void * const memory = mmap(nullptr, mMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED, mDeviceFileDescriptor, 0);
+	if (memory == MAP_FAILED) {
+		return false;
+	}
+
+	mMemory = static_cast<uchar *>(memory);
+
+	int const width = varInfo.xres;
+	int const height = varInfo.yres;
+	int const pageSize = fixInfo.line_length * height;
+	mPageCount = !mSwapRedBlue && varInfo.yres_virtual >= 2 * varInfo.yres && mMemorySize >= 2 * pageSize
+			&& fixInfo.ypanstep != 0 ? 2 : 1;
+
+	for (int i = 0; i < mPageCount; ++i) {
+		mPages[i] = QImage(mMemory + i * pageSize, width, height, fixInfo.line_length, format);
+	}
+
+	if (mPageCount == 1) {
+		mOffscreen = QImage(width, height, format);
+	} else {
+		mBackPage = varInfo.yoffset == 0 ? 1 : 0;
+	}
+
+	return true;
+}
+
+void HardwareFramebuffer::close()
+{
+	mPages[0] = QImage();
+	mPages[1] = QImage();
+	mPageCount = 0;
+	mSwapRedBlue = false;
+
+	if (mMemory) {
+		munmap(mMemory, mMemorySize);
+		mMemory = nullptr;
+	}
+
+	if (mDeviceFileDescriptor >= 0) {
+		::close(mDeviceFileDescriptor);
+		mDeviceFileDescriptor = -1;
+	}
+}
+
+QImage &HardwareFramebuffer::backBuffer()
+{
+	return mPageCount == 2 ? mPages[mBackPage] : mOffscreen;
+}
+
+void HardwareFramebuffer::flip(QRect const &changedArea)
+{
+	if (mPageCount == 1) {
+		// Off-screen buffer keeps all frames, so the rest of the screen is already up to date.
+		QRect const area = changedArea.intersected(mOffscreen.rect());
+		if (area.isEmpty()) {
+			return;
+		}
+
+		QPainter painter(&mPages[0]);
+		painter.setCompositionMode(QPainter::CompositionMode_Source);
+		if (mSwapRedBlue) {
+			painter.drawImage(area.topLeft(), mOffscreen.copy(area).rgbSwapped());
+		} else {
+			painter.drawImage(area.topLeft(), mOffscreen, area);
+		}
+
+		return;
+	}
+
+	if (mPageCount != 2) {
+		return;
+	}
+
+	fb_var_screeninfo varInfo;
+	if (ioctl(mDeviceFileDescriptor, FBIOGET_VSCREENINFO, &varInfo) < 0) {
+		return;
+	}
+
+	// Panning is requested without FB_ACTIVATE_VBL, so it does not wait for vertical sync.
+	varInfo.xoffset = 0;
+	varInfo.yoffset = mBackPage * varInfo.yres;
+	if (ioctl(mDeviceFileDescriptor, FBIOPAN_DISPLAY, &varInfo) < 0) {
+		qDebug() << "Framebuffer page flip failed";
+		return;
+	}
+
+	mBackPage = 1 - mBackPage;
+}
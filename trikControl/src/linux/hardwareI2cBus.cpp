@@ -12,7 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License. */
 
-#include "src/i2cCommunicator.h"
+#include "src/hardwareI2cBus.h"
 
 #include <QtCore/QDebug>
 
@@ -79,19 +79,19 @@ static inline __s32 i2c_smbus_write_byte_data(int file, __u8 command, __u8 value
 	return i2c_smbus_access(file,I2C_SMBUS_WRITE,command, I2C_SMBUS_BYTE_DATA, &data);
 }
 
-I2cCommunicator::I2cCommunicator(QString const &devicePath, int deviceId)
+HardwareI2cBus::HardwareI2cBus(QString const &devicePath, int deviceId)
 	: mDevicePath(devicePath)
 	, mDeviceId(deviceId)
 {
 	connect();
 }
 
-I2cCommunicator::~I2cCommunicator()
+HardwareI2cBus::~HardwareI2cBus()
 {
 	disconnect();
 }
 
-void I2cCommunicator::connect()
+void HardwareI2cBus::connect()
 {
 	mDeviceFileDescriptor = open(mDevicePath.toStdString().c_str(), O_RDWR);
 	if (mDeviceFileDescriptor < 0) {
@@ -105,20 +105,18 @@ void I2cCommunicator::connect()
 	}
 }
 
-void I2cCommunicator::send(QByteArray const &data)
+int HardwareI2cBus::send(QByteArray const &data)
 {
-	QMutexLocker lock(&mLock);
 	if (data.size() == 2) {
-		i2c_smbus_write_byte_data(mDeviceFileDescriptor, data[0], data[1]);
+		return i2c_smbus_write_byte_data(mDeviceFileDescriptor, data[0], data[1]);
 	} else {
-		i2c_smbus_write_word_data(mDeviceFileDescriptor, data[0], data[1] | (data[2] << 8));
+		return i2c_smbus_write_word_data(mDeviceFileDescriptor, data[0], data[1] | (data[2] << 8));
 	}
 }
 
 /// todo: rewrite it
-int I2cCommunicator::read(QByteArray const &data)
+int HardwareI2cBus::read(QByteArray const &data)
 {
-	QMutexLocker lock(&mLock);
 	if (data.size() == 1)
 	{
 		return i2c_smbus_read_word_data(mDeviceFileDescriptor, data[0]);
@@ -131,8 +129,7 @@ int I2cCommunicator::read(QByteArray const &data)
 	}
 }
 
-void I2cCommunicator::disconnect()
+void HardwareI2cBus::disconnect()
 {
-	QMutexLocker lock(&mLock);
 	close(mDeviceFileDescriptor);
 }
@@ -15,69 +15,140 @@
 #include "src/keysWorker.h"
 
 #include <QtCore/QDebug>
-#include <unistd.h>
-#include <fcntl.h>
 #include <linux/input.h>
 
+#include "src/deviceBackendInterface.h"
+#include "src/eventDeviceInterface.h"
+#include "src/monotonicClock.h"
+
 using namespace trikControl;
 
-KeysWorker::KeysWorker(QString const &keysPath)
+/// Time in milliseconds for which a button shall be held to be considered long pressed.
+static qint64 const longPressTime = 800;
+
+/// Buttons pressed within this time in milliseconds from each other and held together form a chord.
+static qint64 const chordTime = 300;
+
+KeysWorker::KeysWorker(DeviceBackendInterface &backend, QString const &keysPath)
+	: mEventDevice(backend.createEventDevice(keysPath))
 {
-	mKeysFileDescriptor = open(keysPath.toStdString().c_str(), O_SYNC, O_RDONLY);
-	if (mKeysFileDescriptor == -1) {
-		qDebug() << "cannot open keys input file";
-		return;
+	for (std::atomic<qint64> &pressTime : mPressTimes) {
+		pressTime.store(0, std::memory_order_relaxed);
 	}
 
-	mSocketNotifier.reset(new QSocketNotifier(mKeysFileDescriptor, QSocketNotifier::Read, this));
+	// Device and timer shall be children to be moved into worker thread together with worker.
+	mEventDevice->setParent(this);
+	mLongPressTimer.setParent(this);
+	mLongPressTimer.setSingleShot(true);
 
-	connect(mSocketNotifier.data(), SIGNAL(activated(int)), this, SLOT(readKeysEvent()));
-	mSocketNotifier->setEnabled(true);
+	connect(mEventDevice.data(), SIGNAL(newEvent(int,int,int,qint64)), this, SLOT(onNewEvent(int,int,int,qint64)));
+	connect(&mLongPressTimer, SIGNAL(timeout()), this, SLOT(checkLongPresses()));
+}
+
+KeysWorker::~KeysWorker()
+{
 }
 
 void KeysWorker::reset()
 {
-	mWasPressed.clear();
+	mWasPressed.reset();
 }
 
 bool KeysWorker::wasPressed(int code)
 {
-	mLock.lockForRead();
-	bool result = mWasPressed.contains(code);
-	mLock.unlock();
-
-	if (result) {
-		mLock.lockForWrite();
-		mWasPressed.remove(code);
-		mLock.unlock();
-	}
-
-	return result;
+	return mWasPressed.testAndClear(code);
 }
 
-void KeysWorker::readKeysEvent()
+bool KeysWorker::isPressed(int code)
 {
-	struct input_event event;
+	return mIsPressed.test(code);
+}
 
-	if (read(mKeysFileDescriptor, reinterpret_cast<char*>(&event), sizeof(event)) != sizeof(event)) {
-		qDebug() << "keys: incomplete data read";
-		return;
+int KeysWorker::pressDuration(int code)
+{
+	if (!mIsPressed.test(code)) {
+		return 0;
 	}
 
-	switch (event.type)
+	qint64 const duration = MonotonicClock::msecs() - mPressTimes[code].load(std::memory_order_relaxed);
+	return static_cast<int>(qMax<qint64>(duration, 0));
+}
+
+void KeysWorker::onNewEvent(int eventType, int code, int value, qint64 timestamp)
+{
+	switch (eventType)
 	{
 	case EV_KEY:
-		mButtonCode = static_cast<int>(event.code);
-		mButtonValue = static_cast<int>(event.value);
+		mPendingKeys << KeyEvent{code, value, timestamp};
 		break;
 	case EV_SYN:
-		if (mButtonValue) {
-			mLock.lockForWrite();
-			mWasPressed.insert(mButtonCode);
-			mLock.unlock();
+		// All key events of a packet are applied at once, and only real key changes are reported.
+		for (KeyEvent const &event : mPendingKeys) {
+			applyKeyEvent(event);
 		}
 
-		emit buttonPressed(mButtonCode, mButtonValue);
+		mPendingKeys.resize(0);
+		checkLongPresses();
 		break;
 	}
 }
+
+void KeysWorker::checkLongPresses()
+{
+	qint64 const now = MonotonicClock::msecs();
+	qint64 nextCheck = -1;
+	for (int const code : mAwaitingLongPress.toList()) {
+		qint64 const deadline = mPressTimes[code].load(std::memory_order_relaxed) + longPressTime;
+		if (deadline <= now) {
+			mAwaitingLongPress.remove(code);
+			emit longPressed(code);
+		} else if (nextCheck == -1 || deadline < nextCheck) {
+			nextCheck = deadline;
+		}
+	}
+
+	if (nextCheck == -1) {
+		mLongPressTimer.stop();
+	} else {
+		mLongPressTimer.start(static_cast<int>(nextCheck - now));
+	}
+}
+
+void KeysWorker::applyKeyEvent(KeyEvent const &event)
+{
+	if (event.code < 0 || event.code > maxKeyCode) {
+		return;
+	}
+
+	if (event.value == 1) {
+		mPressTimes[event.code].store(event.timestamp, std::memory_order_relaxed);
+		mIsPressed.set(event.code);
+		mWasPressed.set(event.code);
+		mAwaitingLongPress.insert(event.code);
+
+		QVector<int> chord;
+		for (int code = 0; code <= maxKeyCode; ++code) {
+			if (!mIsPressed.test(code)) {
+				continue;
+			}
+
+			if (event.timestamp - mPressTimes[code].load(std::memory_order_relaxed) <= chordTime) {
+				chord << code;
+			}
+		}
+
+		if (chord.size() > 1) {
+			emit chordPressed(chord);
+		}
+	} else if (event.value == 0) {
+		mIsPressed.clear(event.code);
+		mAwaitingLongPress.remove(event.code);
+		qint64 const duration = event.timestamp - mPressTimes[event.code].load(std::memory_order_relaxed);
+		emit released(event.code, static_cast<int>(qMax<qint64>(duration, 0)));
+	} else {
+		// Autorepeat, button is still held.
+		mWasPressed.set(event.code);
+	}
+
+	emit buttonPressed(event.code, event.value);
+}
@@ -16,79 +16,53 @@
 
 #include <QtCore/QDebug>
 
-#include <cmath>
-#include <unistd.h>
-#include <fcntl.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <sys/ioctl.h>
-#include <errno.h>
-#include <linux/ioctl.h>
 #include <linux/input.h>
 
+#include "src/deviceBackendInterface.h"
+#include "src/eventDeviceInterface.h"
+
 using namespace trikControl;
 
-Sensor3dWorker::Sensor3dWorker(int min, int max, const QString &controlFile)
-	: mDeviceFileDescriptor(0)
+Sensor3dWorker::Sensor3dWorker(DeviceBackendInterface &backend, int min, int max, QString const &controlFile)
+	: mEventDevice(backend.createEventDevice(controlFile))
 	, mMax(max)
 	, mMin(min)
 {
 	mReading << 0 << 0 << 0;
 
-	mDeviceFileDescriptor = open(controlFile.toStdString().c_str(), O_SYNC | O_NONBLOCK, O_RDONLY);
-	if (mDeviceFileDescriptor == -1) {
-		qDebug() << "Cannot open input file " << controlFile;
-		return;
-	}
-
-	mSocketNotifier.reset(
-			new QSocketNotifier(mDeviceFileDescriptor, QSocketNotifier::Read, this)
-			);
-
-	connect(mSocketNotifier.data(), SIGNAL(activated(int)), this, SLOT(readFile()));
-	mSocketNotifier->setEnabled(true);
+	// Device shall be a child to be moved into worker thread together with worker.
+	mEventDevice->setParent(this);
+	connect(mEventDevice.data(), SIGNAL(newEvent(int,int,int,qint64)), this, SLOT(onNewEvent(int,int,int)));
 }
 
-void Sensor3dWorker::readFile()
+Sensor3dWorker::~Sensor3dWorker()
 {
-	struct input_event event;
-	int size = 0;
-
-	mSocketNotifier->setEnabled(false);
+}
 
-	while ((size = ::read(mDeviceFileDescriptor, reinterpret_cast<char *>(&event), sizeof(event)))
-			== static_cast<int>(sizeof(event)))
-	{
-		switch (event.type) {
-			case EV_ABS:
-				switch (event.code) {
-				case ABS_X:
-					mLock.lockForWrite();
-					mReading[0] = event.value;
-					mLock.unlock();
-					break;
-				case ABS_Y:
-					mLock.lockForWrite();
-					mReading[1] = event.value;
-					mLock.unlock();
-					break;
-				case ABS_Z:
-					mLock.lockForWrite();
-					mReading[2] = event.value;
-					mLock.unlock();
-					break;
-				}
-				break;
-			case EV_SYN:
-				break;
-		}
+void Sensor3dWorker::onNewEvent(int eventType, int code, int value)
+{
+	if (eventType != EV_ABS) {
+		return;
 	}
 
-	if (0 <= size && size < static_cast<int>(sizeof(event))) {
-		qDebug() << "incomplete data read";
+	int axis = -1;
+	switch (code) {
+	case ABS_X:
+		axis = 0;
+		break;
+	case ABS_Y:
+		axis = 1;
+		break;
+	case ABS_Z:
+		axis = 2;
+		break;
+	default:
+		return;
 	}
 
-	mSocketNotifier->setEnabled(true);
+	mLock.lockForWrite();
+	mReading[axis] = value;
+	mLock.unlock();
 }
 
 QVector<int> Sensor3dWorker::read()
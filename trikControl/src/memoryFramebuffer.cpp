@@ -0,0 +1,48 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "memoryFramebuffer.h"
+
+using namespace trikControl;
+
+MemoryFramebuffer::MemoryFramebuffer(QSize const &size)
+	: mFrontBuffer(size, QImage::Format_RGB16)
+	, mBackBuffer(size, QImage::Format_RGB16)
+	, mFlipCount(0)
+{
+	mFrontBuffer.fill(Qt::black);
+}
+
+QImage &MemoryFramebuffer::backBuffer()
+{
+	return mBackBuffer;
+}
+
+void MemoryFramebuffer::flip(QRect const &changedArea)
+{
+	Q_UNUSED(changedArea);
+
+	mFrontBuffer.swap(mBackBuffer);
+	++mFlipCount;
+}
+
+QImage const &MemoryFramebuffer::frontBuffer() const
+{
+	return mFrontBuffer;
+}
+
+int MemoryFramebuffer::flipCount() const
+{
+	return mFlipCount;
+}
@@ -0,0 +1,48 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QSize>
+#include <QtGui/QImage>
+
+#include "framebufferInterface.h"
+
+namespace trikControl {
+
+/// Framebuffer that keeps both buffers in memory, used instead of real screen when display is tested or benchmarked.
+class MemoryFramebuffer : public FramebufferInterface
+{
+public:
+	/// Constructor.
+	/// @param size - size of a screen in pixels.
+	explicit MemoryFramebuffer(QSize const &size);
+
+	QImage &backBuffer() override;
+
+	void flip(QRect const &changedArea) override;
+
+	/// Returns image that is currently "shown" on a screen.
+	QImage const &frontBuffer() const;
+
+	/// Returns number of flips since creation.
+	int flipCount() const;
+
+private:
+	QImage mFrontBuffer;
+	QImage mBackBuffer;
+	int mFlipCount;
+};
+
+}
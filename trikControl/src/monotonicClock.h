@@ -0,0 +1,30 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+namespace trikControl {
+
+/// Monotonic clock shared by input devices and their consumers.
+class MonotonicClock
+{
+public:
+	/// Returns current time in milliseconds of CLOCK_MONOTONIC, the clock that evdev devices switched by
+	/// EVIOCSCLOCKID use for event timestamps.
+	static qint64 msecs();
+};
+
+}
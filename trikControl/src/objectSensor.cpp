@@ -20,9 +20,9 @@
 
 using namespace trikControl;
 
-ObjectSensor::ObjectSensor(QString const &script, QString const &inputFile, QString const &outputFile
-		, double toleranceFactor)
-	: mObjectSensorWorker(new ObjectSensorWorker(script, inputFile, outputFile, toleranceFactor))
+ObjectSensor::ObjectSensor(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+		, QString const &outputFile, double toleranceFactor)
+	: mObjectSensorWorker(new ObjectSensorWorker(backend, script, inputFile, outputFile, toleranceFactor))
 {
 	mObjectSensorWorker->moveToThread(&mWorkerThread);
 	mWorkerThread.start();
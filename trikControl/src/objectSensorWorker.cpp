@@ -18,9 +18,9 @@
 
 using namespace trikControl;
 
-ObjectSensorWorker::ObjectSensorWorker(QString const &script, QString const &inputFile, QString const &outputFile
-		, double toleranceFactor)
-	: AbstractVirtualSensorWorker(script, inputFile, outputFile)
+ObjectSensorWorker::ObjectSensorWorker(DeviceBackendInterface &backend, QString const &script, QString const &inputFile
+		, QString const &outputFile, double toleranceFactor)
+	: AbstractVirtualSensorWorker(backend, script, inputFile, outputFile)
 	, mToleranceFactor(toleranceFactor)
 {
 }
@@ -0,0 +1,156 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QRect>
+#include <QtCore/QVector>
+
+namespace trikControl {
+
+/// Ordered collection of display primitives of one type with constant time lookup by geometry. There can be only one
+/// primitive with given geometry; adding a primitive with the same geometry and another pen replaces old one and
+/// moves it to the end. Every primitive carries a sequence number given by its owner, increasing with each insertion,
+/// so primitives of several stores can be painted in one order of insertion by merging stores by sequence numbers.
+/// Primitive shall have "color" and "penWidth" fields, nested "Key" type for which qHash() is defined and
+/// "Key key() const" method that returns its geometry.
+template<typename Primitive>
+class PrimitiveStore
+{
+public:
+	/// Sequence number returned when there are no more primitives in a store.
+	static quint64 const noSequence = ~0ULL;
+
+	/// Result of inserting a primitive.
+	enum InsertResult {
+		/// Primitive with this geometry was not in a store and was added.
+		added
+
+		/// Primitive with this geometry and another pen was replaced.
+		, replaced
+
+		/// Primitive with this geometry and the same pen is already in a store, nothing changed.
+		, unchanged
+	};
+
+	/// Adds a primitive to a store.
+	/// @param primitive - primitive to add.
+	/// @param sequence - sequence number of a primitive, greater than sequence numbers of all primitives in a store.
+	/// @param area - area affected by painting of a primitive.
+	/// @param previous - if not null and primitive was replaced, receives old primitive.
+	InsertResult insert(Primitive const &primitive, quint64 sequence, QRect const &area
+			, Primitive *previous = nullptr)
+	{
+		typename Primitive::Key const key = primitive.key();
+		InsertResult result = added;
+
+		int const existing = mIndex.value(key, -1);
+		if (existing != -1) {
+			Entry &entry = mEntries[existing];
+			if (entry.primitive.color == primitive.color && entry.primitive.penWidth == primitive.penWidth) {
+				return unchanged;
+			}
+
+			if (previous) {
+				*previous = entry.primitive;
+			}
+
+			entry.removed = true;
+			++mRemovedCount;
+			result = replaced;
+		}
+
+		mIndex.insert(key, mEntries.size());
+		mEntries.append(Entry{primitive, sequence, area, false});
+
+		if (mRemovedCount > mEntries.size() / 2) {
+			compact();
+		}
+
+		return result;
+	}
+
+	/// Removes all primitives, keeping allocated memory.
+	void clear()
+	{
+		mEntries.resize(0);
+		mIndex.clear();
+		mRemovedCount = 0;
+	}
+
+	/// Returns number of primitives in a store.
+	int size() const
+	{
+		return mEntries.size() - mRemovedCount;
+	}
+
+	/// Skips replaced primitives and primitives that do not affect given area, starting from given position.
+	/// @param position - position in a store, moved to the next primitive to paint.
+	/// @param area - area that is painted.
+	/// @returns sequence number of a primitive at new position, or noSequence if there are no more primitives.
+	quint64 sequenceAt(int &position, QRect const &area) const
+	{
+		for (; position < mEntries.size(); ++position) {
+			Entry const &entry = mEntries[position];
+			if (!entry.removed && entry.area.intersects(area)) {
+				return entry.sequence;
+			}
+		}
+
+		return noSequence;
+	}
+
+	/// Returns primitive at given position, found by sequenceAt().
+	Primitive const &at(int position) const
+	{
+		return mEntries[position].primitive;
+	}
+
+private:
+	struct Entry {
+		Primitive primitive;
+		quint64 sequence;
+		QRect area;
+		bool removed;
+	};
+
+	/// Drops replaced primitives and rebuilds index.
+	void compact()
+	{
+		QVector<Entry> entries;
+		entries.reserve(size());
+		mIndex.clear();
+		for (Entry const &entry : mEntries) {
+			if (!entry.removed) {
+				mIndex.insert(entry.primitive.key(), entries.size());
+				entries.append(entry);
+			}
+		}
+
+		mEntries.swap(entries);
+		mRemovedCount = 0;
+	}
+
+	/// All primitives in order of insertion, including replaced ones that are not yet dropped.
+	QVector<Entry> mEntries;
+
+	/// Maps geometry to index of a primitive in mEntries.
+	QHash<typename Primitive::Key, int> mIndex;
+
+	/// Number of replaced primitives in mEntries.
+	int mRemovedCount = 0;
+};
+
+}
@@ -18,31 +18,24 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QTextStream>
 
+#include "src/deviceBackendInterface.h"
+#include "src/deviceFileInterface.h"
+
 using namespace trikControl;
 
-PwmCapture::PwmCapture(QString const &frequencyFile, QString const &dutyFile)
-	: mFrequencyFile(frequencyFile)
-	, mDutyFile(dutyFile)
+PwmCapture::PwmCapture(DeviceBackendInterface &backend, QString const &frequencyFile, QString const &dutyFile)
+	: mFrequencyFile(backend.createDeviceFile(frequencyFile))
+	, mDutyFile(backend.createDeviceFile(dutyFile))
 {
-	if (!mFrequencyFile.open(QIODevice::ReadOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open period capture file " << mFrequencyFile.fileName();
-	}
-
-	if (!mDutyFile.open(QIODevice::ReadOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open duty capture file " << mDutyFile.fileName();
-	}
 }
 
 PwmCapture::~PwmCapture()
 {
-	mFrequencyFile.close();
-	mDutyFile.close();
 }
 
 QVector<int> PwmCapture::frequency()
 {
-	mFrequencyFile.reset();
-	QByteArray dataText = mFrequencyFile.readAll();
+	QByteArray dataText = mFrequencyFile->read();
 	QTextStream stream(dataText);
 	QVector<int> data(3);
 	char c = '\0';
@@ -52,8 +45,7 @@ QVector<int> PwmCapture::frequency()
 
 int PwmCapture::duty()
 {
-	mDutyFile.reset();
-	QByteArray dataText = mDutyFile.readAll();
+	QByteArray dataText = mDutyFile->read();
 	QTextStream stream(dataText);
 	int data = 0;
 	char c = '\0';
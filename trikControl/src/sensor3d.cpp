@@ -18,8 +18,8 @@
 
 using namespace trikControl;
 
-Sensor3d::Sensor3d(int min, int max, const QString &controlFile)
-	: mSensor3dWorker(new Sensor3dWorker(min, max, controlFile))
+Sensor3d::Sensor3d(DeviceBackendInterface &backend, int min, int max, QString const &controlFile)
+	: mSensor3dWorker(new Sensor3dWorker(backend, min, max, controlFile))
 {
 	mSensor3dWorker->moveToThread(&mWorkerThread);
 	mWorkerThread.start();
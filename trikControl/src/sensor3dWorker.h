@@ -15,13 +15,15 @@
  * limitations under the License. */
 
 #include <QtCore/QObject>
-#include <QtCore/QSocketNotifier>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QVector>
 #include <QtCore/QReadWriteLock>
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+class EventDeviceInterface;
+
 /// Handles events from sensor, intended to work in separate thread
 class Sensor3dWorker : public QObject
 {
@@ -29,23 +31,25 @@ class Sensor3dWorker : public QObject
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to input device.
 	/// @param min - minimal actual (physical) value returned by sensor. Used to normalize returned values.
 	/// @param max - maximal actual (physical) value returned by sensor. Used to normalize returned values.
 	/// @param deviceFile - device file for this sensor.
-	Sensor3dWorker(int min, int max, QString const &deviceFile);
+	Sensor3dWorker(DeviceBackendInterface &backend, int min, int max, QString const &deviceFile);
+
+	~Sensor3dWorker() override;
 
 public slots:
 	/// Returns current raw reading of a sensor in a form of vector with 3 coordinates.
 	QVector<int> read();
 
 private slots:
-	/// Updates current reading when new value is ready.
-	void readFile();
+	/// Updates current reading when new event comes from a device.
+	void onNewEvent(int eventType, int code, int value);
 
 private:
-	QScopedPointer<QSocketNotifier> mSocketNotifier;
+	QScopedPointer<EventDeviceInterface> mEventDevice;
 	QVector<int> mReading;
-	int mDeviceFileDescriptor;
 	int mMax;
 	int mMin;
 	QReadWriteLock mLock;
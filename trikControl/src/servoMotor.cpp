@@ -16,12 +16,15 @@
 
 #include <QtCore/QDebug>
 
+#include "src/deviceBackendInterface.h"
+#include "src/deviceFileInterface.h"
+
 using namespace trikControl;
 
-ServoMotor::ServoMotor(int min, int max, int zero, int stop, QString const &dutyFile, QString const &periodFile
-		, int period, bool invert)
-	: mDutyFile(dutyFile)
-	, mPeriodFile(periodFile)
+ServoMotor::ServoMotor(DeviceBackendInterface &backend, int min, int max, int zero, int stop, QString const &dutyFile
+		, QString const &periodFile, int period, bool invert)
+	: mDutyFile(backend.createDeviceFile(dutyFile))
+	, mPeriodFile(backend.createDeviceFile(periodFile))
 	, mPeriod(period)
 	, mCurrentDutyPercent(0)
 	, mMin(min)
@@ -31,15 +34,15 @@ ServoMotor::ServoMotor(int min, int max, int zero, int stop, QString const &duty
 	, mInvert(invert)
 	, mCurrentPower(0)
 {
-	if (!mPeriodFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open motor period file " << mPeriodFile.fileName();
-		return;
-	}
-
 	QString const command = QString::number(mPeriod);
 
-	mPeriodFile.write(command.toLatin1());
-	mPeriodFile.close();
+	if (!mPeriodFile->write(command.toLatin1())) {
+		qDebug() << "Can't write motor period file " << mPeriodFile->fileName();
+	}
+}
+
+ServoMotor::~ServoMotor()
+{
 }
 
 int ServoMotor::power() const
@@ -59,14 +62,11 @@ int ServoMotor::duty() const
 
 void ServoMotor::powerOff()
 {
-	if (!mDutyFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open motor duty file " << mDutyFile.fileName();
+	if (!mDutyFile->write(QString::number(mStop).toLatin1())) {
+		qDebug() << "Can't write motor duty file " << mDutyFile->fileName();
 		return;
 	}
 
-	mDutyFile.write(QString::number(mStop).toLatin1());
-	mDutyFile.close();
-
 	mCurrentPower = 0;
 }
 
@@ -82,13 +82,9 @@ void ServoMotor::setCurrentDuty(int duty)
 
 void ServoMotor::writeMotorCommand(QString const &command)
 {
-	if (!mDutyFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
-		qDebug() << "Can't open motor control file " << mDutyFile.fileName();
-		return;
+	if (!mDutyFile->write(command.toLatin1())) {
+		qDebug() << "Can't write motor control file " << mDutyFile->fileName();
 	}
-
-	mDutyFile.write(command.toLatin1());
-	mDutyFile.close();
 }
 
 int ServoMotor::min() const
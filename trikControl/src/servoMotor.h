@@ -16,12 +16,15 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
-#include <QtCore/QFile>
+#include <QtCore/QScopedPointer>
 
 #include "motor.h"
 
 namespace trikControl {
 
+class DeviceBackendInterface;
+class DeviceFileInterface;
+
 /// TRIK servomotor.
 class ServoMotor : public Motor
 {
@@ -29,6 +32,7 @@ class ServoMotor : public Motor
 
 public:
 	/// Constructor.
+	/// @param backend - device backend that provides access to device files.
 	/// @param min - minimal value of duty_ns whose meaning and range depends on motor type.
 	/// @param max - maximal value of duty_ns whose meaning and range depends on motor type.
 	/// @param zero - neutral value of duty_ns.
@@ -37,8 +41,10 @@ public:
 	/// @param period - value of period for setting while initialization.
 	/// @param invert - true, if power values set by setPower slot shall be negated before sent to motor.
 	/// @param isContiniousRotationServo - true, if this servo is continious rotation, false if it is angular.
-	ServoMotor(int min, int max, int zero, int stop, QString const &dutyFile, QString const &periodFile, int period
-			, bool invert);
+	ServoMotor(DeviceBackendInterface &backend, int min, int max, int zero, int stop, QString const &dutyFile
+			, QString const &periodFile, int period, bool invert);
+
+	~ServoMotor() override;
 
 public slots:
 	/// Returns currently set power of continuous rotation servo or angle of angular servo.
@@ -64,8 +70,8 @@ protected:
 	bool invert() const;
 
 private:
-	QFile mDutyFile;
-	QFile mPeriodFile;
+	QScopedPointer<DeviceFileInterface> mDutyFile;
+	QScopedPointer<DeviceFileInterface> mPeriodFile;
 	int const mPeriod;
 	int mCurrentDutyPercent;
 	int mMin;
@@ -0,0 +1,89 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/simulatedDeviceBackend.h"
+
+#include <QtCore/QStringList>
+
+#include "src/configurer.h"
+#include "src/simulatedDeviceFile.h"
+#include "src/simulatedEventDevice.h"
+#include "src/simulatedI2cBus.h"
+#include "src/simulatedVirtualSensorDevice.h"
+
+using namespace trikControl;
+
+SimulatedDeviceBackend::SimulatedDeviceBackend(Configurer const &configurer)
+	: mConfigurer(configurer)
+{
+}
+
+I2cBusInterface *SimulatedDeviceBackend::createI2cBus(QString const &devicePath, int deviceId)
+{
+	Q_UNUSED(devicePath)
+	Q_UNUSED(deviceId)
+
+	SimulatedI2cBus * const bus = new SimulatedI2cBus(mConfigurer.simulatorI2cLatency()
+			, mConfigurer.simulatorMotorMaxSpeed()
+			, mConfigurer.simulatorMotorTimeConstant()
+			);
+
+	QStringList motorPorts = mConfigurer.powerMotorPorts();
+	QStringList encoderPorts = mConfigurer.encoderPorts();
+	motorPorts.sort();
+	encoderPorts.sort();
+
+	for (int i = 0; i < motorPorts.size(); ++i) {
+		int const encoderCommandNumber = i < encoderPorts.size()
+				? mConfigurer.encoderI2cCommandNumber(encoderPorts[i])
+				: -1;
+
+		bus->addMotor(mConfigurer.powerMotorI2cCommandNumber(motorPorts[i]), encoderCommandNumber);
+	}
+
+	return bus;
+}
+
+DeviceFileInterface *SimulatedDeviceBackend::createDeviceFile(QString const &fileName)
+{
+	return new SimulatedDeviceFile(fileName, mConfigurer.simulatorDeviceFileLatency());
+}
+
+EventDeviceInterface *SimulatedDeviceBackend::createEventDevice(QString const &fileName)
+{
+	SimulatedEventDevice * const device = new SimulatedEventDevice(fileName);
+	mEventDevices.insert(fileName, device);
+	return device;
+}
+
+VirtualSensorDeviceInterface *SimulatedDeviceBackend::createVirtualSensorDevice(QString const &script
+		, QString const &inputFile, QString const &outputFile)
+{
+	Q_UNUSED(inputFile)
+	Q_UNUSED(outputFile)
+
+	SimulatedVirtualSensorDevice * const device = new SimulatedVirtualSensorDevice(script);
+	mVirtualSensorDevices.insert(script, device);
+	return device;
+}
+
+SimulatedEventDevice *SimulatedDeviceBackend::eventDevice(QString const &fileName) const
+{
+	return mEventDevices.value(fileName).data();
+}
+
+SimulatedVirtualSensorDevice *SimulatedDeviceBackend::virtualSensorDevice(QString const &script) const
+{
+	return mVirtualSensorDevices.value(script).data();
+}
@@ -0,0 +1,64 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+
+#include "deviceBackendInterface.h"
+
+namespace trikControl {
+
+class Configurer;
+class SimulatedEventDevice;
+class SimulatedVirtualSensorDevice;
+
+/// Backend that simulates robot hardware in-process, so the whole Brick can run on a desktop. Latencies and motor
+/// parameters are taken from "deviceBackend" section of config. Power motors and encoders are paired in order of
+/// their ports (M1 with B1 and so on), so encoders report positions of simulated motor shafts.
+class SimulatedDeviceBackend : public DeviceBackendInterface
+{
+public:
+	/// Constructor.
+	/// @param configurer - configuration of a brick, shall outlive backend.
+	explicit SimulatedDeviceBackend(Configurer const &configurer);
+
+	I2cBusInterface *createI2cBus(QString const &devicePath, int deviceId) override;
+
+	DeviceFileInterface *createDeviceFile(QString const &fileName) override;
+
+	EventDeviceInterface *createEventDevice(QString const &fileName) override;
+
+	VirtualSensorDeviceInterface *createVirtualSensorDevice(QString const &script, QString const &inputFile
+			, QString const &outputFile) override;
+
+	/// Returns previously created event device with given file name to inject events into it, or NULL if there is
+	/// no such device.
+	SimulatedEventDevice *eventDevice(QString const &fileName) const;
+
+	/// Returns previously created virtual sensor with given script, or NULL if there is no such sensor.
+	SimulatedVirtualSensorDevice *virtualSensorDevice(QString const &script) const;
+
+private:
+	Configurer const &mConfigurer;
+
+	/// Created event devices by file name. Devices are owned by their consumers.
+	QHash<QString, QPointer<SimulatedEventDevice>> mEventDevices;
+
+	/// Created virtual sensors by script file name. Sensors are owned by their workers.
+	QHash<QString, QPointer<SimulatedVirtualSensorDevice>> mVirtualSensorDevices;
+};
+
+}
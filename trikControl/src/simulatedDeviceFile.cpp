@@ -0,0 +1,49 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/simulatedDeviceFile.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace trikControl;
+
+SimulatedDeviceFile::SimulatedDeviceFile(QString const &fileName, int latency, QByteArray const &initialContents)
+	: mFileName(fileName)
+	, mLatency(latency)
+	, mContents(initialContents)
+{
+}
+
+QString SimulatedDeviceFile::fileName() const
+{
+	return mFileName;
+}
+
+QByteArray SimulatedDeviceFile::read()
+{
+	std::this_thread::sleep_for(std::chrono::microseconds(mLatency));
+
+	QMutexLocker locker(&mLock);
+	return mContents;
+}
+
+bool SimulatedDeviceFile::write(QByteArray const &data)
+{
+	std::this_thread::sleep_for(std::chrono::microseconds(mLatency));
+
+	QMutexLocker locker(&mLock);
+	mContents = data;
+	return true;
+}
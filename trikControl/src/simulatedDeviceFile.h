@@ -0,0 +1,47 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QMutex>
+
+#include "deviceFileInterface.h"
+
+namespace trikControl {
+
+/// Simulated device file that keeps its contents in memory. Reads return last written value, each access takes
+/// configured time.
+class SimulatedDeviceFile : public DeviceFileInterface
+{
+public:
+	/// Constructor.
+	/// @param fileName - name of a file on a real robot, used only for debug output.
+	/// @param latency - duration of one access in microseconds.
+	/// @param initialContents - value returned by reads before first write.
+	SimulatedDeviceFile(QString const &fileName, int latency, QByteArray const &initialContents = "0");
+
+	QString fileName() const override;
+
+	QByteArray read() override;
+
+	bool write(QByteArray const &data) override;
+
+private:
+	QString const mFileName;
+	int const mLatency;
+	QByteArray mContents;
+	QMutex mLock;
+};
+
+}
@@ -0,0 +1,34 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/simulatedEventDevice.h"
+
+#include "src/monotonicClock.h"
+
+using namespace trikControl;
+
+SimulatedEventDevice::SimulatedEventDevice(QString const &fileName)
+	: mFileName(fileName)
+{
+}
+
+QString SimulatedEventDevice::fileName() const
+{
+	return mFileName;
+}
+
+void SimulatedEventDevice::inject(int eventType, int code, int value)
+{
+	emit newEvent(eventType, code, value, MonotonicClock::msecs());
+}
@@ -0,0 +1,42 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include "eventDeviceInterface.h"
+
+namespace trikControl {
+
+/// Simulated input device. Events are injected by a simulation driver and delivered to consumers in their threads.
+class SimulatedEventDevice : public EventDeviceInterface
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param fileName - name of a device file on a real robot, used to find device in simulated backend.
+	explicit SimulatedEventDevice(QString const &fileName);
+
+	/// Returns name of a device file on a real robot.
+	QString fileName() const;
+
+public slots:
+	/// Emits an event as if it was read from a device. Can be called from any thread.
+	void inject(int eventType, int code, int value);
+
+private:
+	QString const mFileName;
+};
+
+}
@@ -0,0 +1,97 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/simulatedI2cBus.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace trikControl;
+
+/// Battery register and a value corresponding to fully charged 12V battery.
+static int const batteryCommandNumber = 0x26;
+static int const batteryValue = 905;
+
+SimulatedI2cBus::SimulatedI2cBus(int latency, double motorMaxSpeed, double motorTimeConstant)
+	: mLatency(latency)
+	, mMotorMaxSpeed(motorMaxSpeed)
+	, mMotorTimeConstant(motorTimeConstant)
+{
+	mClock.start();
+	mRegisters.insert(batteryCommandNumber, batteryValue);
+}
+
+void SimulatedI2cBus::addMotor(int motorCommandNumber, int encoderCommandNumber)
+{
+	QSharedPointer<SimulatedMotorModel> const motor(new SimulatedMotorModel(mMotorMaxSpeed, mMotorTimeConstant));
+	mMotors.insert(motorCommandNumber, motor);
+	if (encoderCommandNumber >= 0) {
+		mEncoders.insert(encoderCommandNumber, motor);
+		mEncoderOffsets.insert(encoderCommandNumber, 0);
+	}
+}
+
+int SimulatedI2cBus::send(QByteArray const &data)
+{
+	simulateLatency();
+
+	if (data.size() < 2) {
+		return -1;
+	}
+
+	int const command = static_cast<unsigned char>(data[0]);
+	if (mMotors.contains(command)) {
+		mMotors[command]->setPower(static_cast<signed char>(data[1]), now());
+	} else if (mEncoders.contains(command)) {
+		// Any write to encoder register resets it.
+		mEncoderOffsets[command] = mEncoders[command]->position(now());
+	} else {
+		int value = static_cast<unsigned char>(data[1]);
+		if (data.size() > 2) {
+			value |= static_cast<unsigned char>(data[2]) << 8;
+		}
+
+		mRegisters.insert(command, value);
+	}
+
+	return 0;
+}
+
+int SimulatedI2cBus::read(QByteArray const &data)
+{
+	simulateLatency();
+
+	if (data.isEmpty()) {
+		return -1;
+	}
+
+	int const command = static_cast<unsigned char>(data[0]);
+	if (mEncoders.contains(command)) {
+		return static_cast<int>(mEncoders[command]->position(now()) - mEncoderOffsets[command]);
+	}
+
+	return mRegisters.value(command, 0);
+}
+
+void SimulatedI2cBus::simulateLatency() const
+{
+	if (mLatency > 0) {
+		std::this_thread::sleep_for(std::chrono::microseconds(mLatency));
+	}
+}
+
+qint64 SimulatedI2cBus::now() const
+{
+	return mClock.nsecsElapsed() / 1000;
+}
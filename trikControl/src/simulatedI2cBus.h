@@ -0,0 +1,74 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+
+#include "i2cBusInterface.h"
+#include "simulatedMotorModel.h"
+
+namespace trikControl {
+
+/// Simulated MSP430 coprocessor on I2C bus. Power motors drive motor models, encoders report positions of motors
+/// they are connected to, other registers return constant values. Each transaction takes configured time, so it
+/// behaves like a real bus for a caller.
+class SimulatedI2cBus : public I2cBusInterface
+{
+public:
+	/// Constructor.
+	/// @param latency - duration of one bus transaction in microseconds.
+	/// @param motorMaxSpeed - speed of a motor at full power in encoder ticks per second.
+	/// @param motorTimeConstant - time constant of motors in seconds.
+	SimulatedI2cBus(int latency, double motorMaxSpeed, double motorTimeConstant);
+
+	/// Adds a motor with an encoder on its shaft.
+	/// @param motorCommandNumber - I2C command number of a power motor.
+	/// @param encoderCommandNumber - I2C command number of an encoder, or -1 if motor has no encoder.
+	void addMotor(int motorCommandNumber, int encoderCommandNumber);
+
+	int send(QByteArray const &data) override;
+
+	int read(QByteArray const &data) override;
+
+private:
+	/// Blocks caller for a duration of a transaction.
+	void simulateLatency() const;
+
+	/// Returns simulation time in microseconds.
+	qint64 now() const;
+
+	int const mLatency;
+	double const mMotorMaxSpeed;
+	double const mMotorTimeConstant;
+
+	/// Clock of a simulation, started on construction.
+	QElapsedTimer mClock;
+
+	/// Maps motor command number to motor model.
+	QHash<int, QSharedPointer<SimulatedMotorModel>> mMotors;
+
+	/// Maps encoder command number to a model of a motor it is connected to.
+	QHash<int, QSharedPointer<SimulatedMotorModel>> mEncoders;
+
+	/// Motor positions at the moment of last encoder reset, by encoder command number.
+	QHash<int, double> mEncoderOffsets;
+
+	/// Values of registers that are not motors or encoders, by command number.
+	QHash<int, int> mRegisters;
+};
+
+}
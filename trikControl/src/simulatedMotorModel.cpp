@@ -0,0 +1,56 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/simulatedMotorModel.h"
+
+#include <cmath>
+
+using namespace trikControl;
+
+SimulatedMotorModel::SimulatedMotorModel(double maxSpeed, double timeConstant)
+	: mMaxSpeed(maxSpeed)
+	, mTimeConstant(timeConstant)
+{
+}
+
+void SimulatedMotorModel::setPower(int power, qint64 time)
+{
+	mStartPosition = position(time);
+	mStartSpeed = speed(time);
+	mStartTime = time;
+	mTargetSpeed = mMaxSpeed * qBound(-100, power, 100) / 100.0;
+}
+
+double SimulatedMotorModel::position(qint64 time) const
+{
+	double const elapsed = (time - mStartTime) / 1000000.0;
+
+	// Integral of speed(t) = target + (start - target) * exp(-t / T) from 0 to elapsed.
+	return mStartPosition + mTargetSpeed * elapsed
+			+ (mStartSpeed - mTargetSpeed) * mTimeConstant * (1.0 - decay(time));
+}
+
+double SimulatedMotorModel::speed(qint64 time) const
+{
+	return mTargetSpeed + (mStartSpeed - mTargetSpeed) * decay(time);
+}
+
+double SimulatedMotorModel::decay(qint64 time) const
+{
+	if (mTimeConstant <= 0) {
+		return 0;
+	}
+
+	return std::exp(-(time - mStartTime) / 1000000.0 / mTimeConstant);
+}
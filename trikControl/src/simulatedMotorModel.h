@@ -0,0 +1,64 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+namespace trikControl {
+
+/// Deterministic model of a power motor with an encoder on its shaft. Motor speed follows applied power as a first
+/// order system: it exponentially approaches power * maxSpeed / 100 with given time constant. Position is computed
+/// in closed form from the moment of the last power change, so the result depends only on a sequence of commands and
+/// their timestamps, not on how often the model is queried.
+class SimulatedMotorModel
+{
+public:
+	/// Constructor.
+	/// @param maxSpeed - speed at full power in encoder ticks per second.
+	/// @param timeConstant - time constant of a motor in seconds, 0 means that speed changes instantly.
+	SimulatedMotorModel(double maxSpeed, double timeConstant);
+
+	/// Applies new power to a motor.
+	/// @param power - power from -100 to 100.
+	/// @param time - current time in microseconds.
+	void setPower(int power, qint64 time);
+
+	/// Returns motor shaft position in encoder ticks at given time.
+	/// @param time - time in microseconds, not earlier than the last setPower() call.
+	double position(qint64 time) const;
+
+	/// Returns motor speed in encoder ticks per second at given time.
+	/// @param time - time in microseconds, not earlier than the last setPower() call.
+	double speed(qint64 time) const;
+
+private:
+	/// Returns exp(-dt / timeConstant) for a time passed since the last power change.
+	double decay(qint64 time) const;
+
+	double const mMaxSpeed;
+	double const mTimeConstant;
+
+	/// Time of the last power change in microseconds.
+	qint64 mStartTime = 0;
+
+	/// Position and speed at the moment of the last power change.
+	double mStartPosition = 0;
+	double mStartSpeed = 0;
+
+	/// Speed that motor approaches with current power.
+	double mTargetSpeed = 0;
+};
+
+}
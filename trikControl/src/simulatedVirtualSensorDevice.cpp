@@ -0,0 +1,59 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/simulatedVirtualSensorDevice.h"
+
+using namespace trikControl;
+
+SimulatedVirtualSensorDevice::SimulatedVirtualSensorDevice(QString const &script)
+	: mScript(script)
+{
+}
+
+QString SimulatedVirtualSensorDevice::script() const
+{
+	return mScript;
+}
+
+void SimulatedVirtualSensorDevice::start()
+{
+	mReady = true;
+}
+
+void SimulatedVirtualSensorDevice::stop()
+{
+	mReady = false;
+}
+
+bool SimulatedVirtualSensorDevice::isReady() const
+{
+	return mReady;
+}
+
+void SimulatedVirtualSensorDevice::send(QString const &command)
+{
+	QMutexLocker locker(&mLock);
+	mSentCommands << command;
+}
+
+QStringList SimulatedVirtualSensorDevice::sentCommands()
+{
+	QMutexLocker locker(&mLock);
+	return mSentCommands;
+}
+
+void SimulatedVirtualSensorDevice::injectLine(QString const &dataLine)
+{
+	emit newData(dataLine);
+}
@@ -0,0 +1,60 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QMutex>
+#include <QtCore/QStringList>
+
+#include "virtualSensorDeviceInterface.h"
+
+namespace trikControl {
+
+/// Simulated virtual sensor. It is ready immediately after start, remembers commands sent to it and reports data
+/// lines injected by a simulation driver.
+class SimulatedVirtualSensorDevice : public VirtualSensorDeviceInterface
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param script - script file name of a sensor on a real robot, used to find device in simulated backend.
+	explicit SimulatedVirtualSensorDevice(QString const &script);
+
+	/// Returns script file name of a sensor on a real robot.
+	QString script() const;
+
+	void start() override;
+
+	void stop() override;
+
+	bool isReady() const override;
+
+	void send(QString const &command) override;
+
+	/// Returns commands sent to a sensor since its creation. Can be called from any thread.
+	QStringList sentCommands();
+
+public slots:
+	/// Reports a line of sensor output as if it was read from a sensor. Can be called from any thread.
+	void injectLine(QString const &dataLine);
+
+private:
+	QString const mScript;
+	bool mReady = false;
+	QStringList mSentCommands;
+	QMutex mLock;
+};
+
+}
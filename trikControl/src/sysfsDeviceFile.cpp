@@ -0,0 +1,73 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/sysfsDeviceFile.h"
+
+#include <QtCore/QDebug>
+
+using namespace trikControl;
+
+SysfsDeviceFile::SysfsDeviceFile(QString const &fileName)
+	: mFile(fileName)
+{
+}
+
+SysfsDeviceFile::~SysfsDeviceFile()
+{
+	mFile.close();
+}
+
+QString SysfsDeviceFile::fileName() const
+{
+	return mFile.fileName();
+}
+
+QByteArray SysfsDeviceFile::read()
+{
+	QMutexLocker locker(&mLock);
+	if (!open(QIODevice::ReadOnly | QIODevice::Unbuffered | QIODevice::Text)) {
+		return QByteArray();
+	}
+
+	mFile.reset();
+	return mFile.readAll();
+}
+
+bool SysfsDeviceFile::write(QByteArray const &data)
+{
+	QMutexLocker locker(&mLock);
+	if (!open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered | QIODevice::Text)) {
+		return false;
+	}
+
+	mFile.reset();
+	bool const result = mFile.write(data) == data.size();
+	mFile.flush();
+	return result;
+}
+
+bool SysfsDeviceFile::open(QIODevice::OpenMode mode)
+{
+	if (mFile.isOpen() && mFile.openMode() == mode) {
+		return true;
+	}
+
+	mFile.close();
+	if (!mFile.open(mode)) {
+		qDebug() << "Can't open device file" << mFile.fileName();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,50 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+
+#include "deviceFileInterface.h"
+
+namespace trikControl {
+
+/// Real device file, for example sysfs attribute. File is opened on first access and kept open, every read rewinds
+/// it to the beginning, which is enough for sysfs to provide fresh value. The same file may be accessed from several
+/// threads (for example, by a script and by telemetry), so rewinding and reading or writing are done under a lock.
+class SysfsDeviceFile : public DeviceFileInterface
+{
+public:
+	/// Constructor.
+	/// @param fileName - path to device file.
+	explicit SysfsDeviceFile(QString const &fileName);
+
+	~SysfsDeviceFile() override;
+
+	QString fileName() const override;
+
+	QByteArray read() override;
+
+	bool write(QByteArray const &data) override;
+
+private:
+	/// Opens file in given mode, reopening it if it was opened in another mode.
+	bool open(QIODevice::OpenMode mode);
+
+	QFile mFile;
+	QMutex mLock;
+};
+
+}
@@ -15,9 +15,16 @@
 #include "src/tcpConnector.h"
 
 #include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+#include <QtCore/QHash>
+
+#include <trikKernel/metricsRegistry.h>
 
 using namespace trikControl;
 
+/// Maximal length of a command, longer incomplete lines are considered garbage and discarded.
+static int const maxLineLength = 1024;
+
 TcpConnector::TcpConnector(int port)
 	: mPort(port)
 {
@@ -40,6 +47,7 @@ void TcpConnector::startServer()
 void TcpConnector::connection()
 {
 	mTcpSocket.reset(mTcpServer->nextPendingConnection());
+	mBuffer.clear();
 	mTcpSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
 	qDebug() << "Set new connection";
 	connect(mTcpSocket.data(), SIGNAL(disconnected()), this, SLOT(tcpDisconnected()));
@@ -57,12 +65,60 @@ void TcpConnector::networkRead()
 		return;
 	}
 
-	QString line;
-	while (mTcpSocket->bytesAvailable() > 0) {
-		char data[100];
-		mTcpSocket->readLine(data, 100);
-		line += data;
+	mBuffer.append(mTcpSocket->readAll());
+
+	QList<QByteArray> lines;
+	int lineStart = 0;
+	int lineEnd = mBuffer.indexOf('\n');
+	while (lineEnd != -1) {
+		QByteArray const line = mBuffer.mid(lineStart, lineEnd - lineStart).simplified();
+		if (!line.isEmpty()) {
+			lines << line;
+		}
+
+		lineStart = lineEnd + 1;
+		lineEnd = mBuffer.indexOf('\n', lineStart);
+	}
+
+	mBuffer.remove(0, lineStart);
+	if (mBuffer.size() > maxLineLength) {
+		qDebug() << "Too long gamepad command, discarding";
+		mBuffer.clear();
+	}
+
+	coalesce(lines);
+
+	for (QByteArray const &line : lines) {
+		emit dataReady(QString::fromUtf8(line));
+	}
+}
+
+void TcpConnector::coalesce(QList<QByteArray> &lines)
+{
+	static trikKernel::Counter &coalesced = trikKernel::MetricsRegistry::counter("gamepad.coalescedCommands");
+
+	// Maps pad number to index of its latest position update, pad release ends a sequence of updates.
+	QHash<int, int> lastUpdates;
+	int outdated = 0;
+	for (int i = 0; i < lines.size(); ++i) {
+		QList<QByteArray> const command = lines[i].split(' ');
+		if (command.size() < 3 || command[0] != "pad") {
+			continue;
+		}
+
+		int const pad = command[1].toInt();
+		if (command[2] == "up") {
+			lastUpdates.remove(pad);
+		} else {
+			if (lastUpdates.contains(pad)) {
+				lines[lastUpdates[pad]].clear();
+				++outdated;
+			}
+
+			lastUpdates[pad] = i;
+		}
 	}
 
-	emit dataReady(line);
+	lines.removeAll(QByteArray());
+	coalesced.increment(outdated);
 }
@@ -14,15 +14,20 @@
 
 #pragma once
 
-#include <QtCore/QObject>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QTcpServer>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+
+#include "abstractConnector.h"
 
 namespace trikControl {
 
-/// TCP server.
-class TcpConnector : public QObject
+/// TCP server. Commands are text lines terminated by newline. Partially received line is kept until the rest of it
+/// arrives, and every complete line is emitted as a separate command. If several position updates for the same pad
+/// arrive in one read, only the latest one is emitted, since the older ones are already outdated.
+class TcpConnector : public AbstractConnector
 {
 	Q_OBJECT
 
@@ -31,13 +36,9 @@ public:
 	/// @param port - TCP port of a server.
 	TcpConnector(int port);
 
-signals:
-	/// Emitted when there is incoming TCP message.
-	void dataReady(QString const &message);
-
 public slots:
 	/// Starts a server and begins listening port for incoming connections.
-	void startServer();
+	void startServer() override;
 
 private slots:
 	void tcpDisconnected();
@@ -45,9 +46,15 @@ private slots:
 	void networkRead();
 
 private:
+	/// Removes position updates of a pad that are followed by newer updates of the same pad, keeping releases.
+	static void coalesce(QList<QByteArray> &lines);
+
 	int mPort;
 	QScopedPointer<QTcpServer> mTcpServer;
 	QScopedPointer<QTcpSocket> mTcpSocket;
+
+	/// Received data that does not form a complete line yet.
+	QByteArray mBuffer;
 };
 
 }
@@ -0,0 +1,93 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/udpConnector.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QStringList>
+
+#include <trikKernel/metricsRegistry.h>
+
+using namespace trikControl;
+
+/// If sequence number goes back by more than this value, client is considered restarted and its datagrams are
+/// accepted again.
+static qint32 const restartThreshold = 1000;
+
+UdpConnector::UdpConnector(int port)
+	: mPort(port)
+	, mSenderPort(0)
+	, mLastSequence(0)
+{
+}
+
+void UdpConnector::startServer()
+{
+	mUdpSocket.reset(new QUdpSocket());
+
+	if (!mUdpSocket->bind(QHostAddress::Any, mPort)) {
+		qDebug() << "Unable to start the server:" << mUdpSocket->errorString();
+		return;
+	}
+
+	qDebug() << "UdpServer started";
+	connect(mUdpSocket.data(), SIGNAL(readyRead()), this, SLOT(networkRead()));
+}
+
+void UdpConnector::networkRead()
+{
+	static trikKernel::Counter &stale = trikKernel::MetricsRegistry::counter("gamepad.staleDatagrams");
+
+	while (mUdpSocket->hasPendingDatagrams()) {
+		QByteArray datagram(static_cast<int>(mUdpSocket->pendingDatagramSize()), '\0');
+		QHostAddress sender;
+		quint16 senderPort = 0;
+		mUdpSocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
+
+		int const separatorPosition = datagram.indexOf(' ');
+		bool sequenceOk = false;
+		quint32 const sequence = datagram.left(separatorPosition).toUInt(&sequenceOk);
+		if (separatorPosition == -1 || !sequenceOk) {
+			qDebug() << "Malformed gamepad datagram";
+			continue;
+		}
+
+		if (!isFresh(sender, senderPort, sequence)) {
+			stale.increment();
+			continue;
+		}
+
+		mSender = sender;
+		mSenderPort = senderPort;
+		mLastSequence = sequence;
+
+		QString const commands = QString::fromUtf8(datagram.constData() + separatorPosition + 1
+				, datagram.size() - separatorPosition - 1);
+
+		for (QString const &command : commands.split('\n', QString::SkipEmptyParts)) {
+			emit dataReady(command);
+		}
+	}
+}
+
+bool UdpConnector::isFresh(QHostAddress const &sender, quint16 senderPort, quint32 sequence) const
+{
+	if (sender != mSender || senderPort != mSenderPort) {
+		return true;
+	}
+
+	// Serial number arithmetic, so wrap around of sequence numbers is handled correctly.
+	qint32 const difference = static_cast<qint32>(sequence - mLastSequence);
+	return difference > 0 || difference < -restartThreshold;
+}
@@ -0,0 +1,60 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QScopedPointer>
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QUdpSocket>
+
+#include "abstractConnector.h"
+
+namespace trikControl {
+
+/// UDP server for gamepad. Every datagram starts with a sequence number followed by a space and one or more
+/// commands separated by newlines, for example "42 pad 1 10 20". Pad commands carry absolute positions, so a lost
+/// datagram is just superseded by the next one. Datagrams with a sequence number not greater than the last accepted
+/// one from the same sender arrived late and are dropped, so the robot never goes back to an older stick position.
+class UdpConnector : public AbstractConnector
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param port - UDP port of a server.
+	explicit UdpConnector(int port);
+
+public slots:
+	void startServer() override;
+
+private slots:
+	/// Reads and parses all pending datagrams.
+	void networkRead();
+
+private:
+	/// Returns true if datagram with given sequence number from given sender is newer than accepted ones.
+	bool isFresh(QHostAddress const &sender, quint16 senderPort, quint32 sequence) const;
+
+	int mPort;
+	QScopedPointer<QUdpSocket> mUdpSocket;
+
+	/// Address and port of a client whose datagram was accepted last.
+	QHostAddress mSender;
+	quint16 mSenderPort;
+
+	/// Sequence number of the last accepted datagram.
+	quint32 mLastSequence;
+};
+
+}
@@ -0,0 +1,46 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+namespace trikControl {
+
+/// Connection to a virtual sensor --- an external process that accepts text commands and reports its readings as
+/// text lines. Implemented by FIFO-based real sensors and by simulator. Shall live in a thread of a sensor worker.
+class VirtualSensorDeviceInterface : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Launches sensor if needed and connects to it.
+	virtual void start() = 0;
+
+	/// Disconnects from a sensor and stops it.
+	virtual void stop() = 0;
+
+	/// Returns true if sensor is ready to accept commands.
+	virtual bool isReady() const = 0;
+
+	/// Sends a command to a sensor. Shall be called only when a sensor is ready.
+	virtual void send(QString const &command) = 0;
+
+signals:
+	/// Emitted for every complete line of sensor output.
+	void newData(QString const &dataLine);
+};
+
+}
@@ -0,0 +1,75 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "src/fifoVirtualSensorDevice.h"
+
+using namespace trikControl;
+
+FifoVirtualSensorDevice::FifoVirtualSensorDevice(QString const &script, QString const &inputFile
+		, QString const &outputFile)
+{
+	Q_UNUSED(script)
+	Q_UNUSED(inputFile)
+	Q_UNUSED(outputFile)
+}
+
+FifoVirtualSensorDevice::~FifoVirtualSensorDevice()
+{
+}
+
+void FifoVirtualSensorDevice::start()
+{
+}
+
+void FifoVirtualSensorDevice::stop()
+{
+}
+
+bool FifoVirtualSensorDevice::isReady() const
+{
+	return false;
+}
+
+void FifoVirtualSensorDevice::send(QString const &command)
+{
+	Q_UNUSED(command)
+}
+
+void FifoVirtualSensorDevice::readFile()
+{
+}
+
+QString FifoVirtualSensorDevice::sensorName() const
+{
+	return QString();
+}
+
+bool FifoVirtualSensorDevice::launchSensorScript(QString const &command)
+{
+	Q_UNUSED(command)
+
+	return true;
+}
+
+void FifoVirtualSensorDevice::startVirtualSensor()
+{
+}
+
+void FifoVirtualSensorDevice::openFifos()
+{
+}
+
+void FifoVirtualSensorDevice::deinitialize()
+{
+}
@@ -0,0 +1,55 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/// @file Stub for framebuffer to make it compilable under Windows. Renders to memory only.
+
+#include "src/hardwareFramebuffer.h"
+
+using namespace trikControl;
+
+HardwareFramebuffer::HardwareFramebuffer(QString const &devicePath)
+	: mDeviceFileDescriptor(-1)
+	, mMemory(nullptr)
+	, mMemorySize(0)
+	, mPageCount(0)
+	, mBackPage(0)
+	, mSwapRedBlue(false)
+	, mOffscreen(240, 320, QImage::Format_RGB16)
+{
+	Q_UNUSED(devicePath);
+}
+
+HardwareFramebuffer::~HardwareFramebuffer()
+{
+}
+
+bool HardwareFramebuffer::open(QString const &devicePath)
+{
+	Q_UNUSED(devicePath);
+	return false;
+}
+
+void HardwareFramebuffer::close()
+{
+}
+
+QImage &HardwareFramebuffer::backBuffer()
+{
+	return mOffscreen;
+}
+
+void HardwareFramebuffer::flip(QRect const &changedArea)
+{
+	Q_UNUSED(changedArea);
+}
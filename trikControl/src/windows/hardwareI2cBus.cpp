@@ -14,34 +14,36 @@
 
 /// @file Stub for I2C communication to make it compilable under Windows. Shall not work here, of course.
 
-#include "src/i2cCommunicator.h"
+#include "src/hardwareI2cBus.h"
 
 using namespace trikControl;
 
-I2cCommunicator::I2cCommunicator(QString const &devicePath, int deviceId)
+HardwareI2cBus::HardwareI2cBus(QString const &devicePath, int deviceId)
 	: mDevicePath(devicePath)
 	, mDeviceId(deviceId)
+	, mDeviceFileDescriptor(-1)
 {
 }
 
-I2cCommunicator::~I2cCommunicator()
+HardwareI2cBus::~HardwareI2cBus()
 {
 }
 
-void I2cCommunicator::connect()
+void HardwareI2cBus::connect()
 {
 }
 
-void I2cCommunicator::send(QByteArray const &data)
+int HardwareI2cBus::send(QByteArray const &data)
 {
 	Q_UNUSED(data);
+	return 0;
 }
 
-void I2cCommunicator::disconnect()
+void HardwareI2cBus::disconnect()
 {
 }
 
-int I2cCommunicator::read(QByteArray const &data)
+int HardwareI2cBus::read(QByteArray const &data)
 {
 	Q_UNUSED(data);
 	return 0;
@@ -16,13 +16,20 @@
 
 #include <QtCore/QDebug>
 
+#include "src/eventDeviceInterface.h"
+
 using namespace trikControl;
 
-KeysWorker::KeysWorker(QString const &keysPath)
+KeysWorker::KeysWorker(DeviceBackendInterface &backend, QString const &keysPath)
 {
+	Q_UNUSED(backend)
 	Q_UNUSED(keysPath)
 }
 
+KeysWorker::~KeysWorker()
+{
+}
+
 void KeysWorker::reset()
 {
 }
@@ -34,6 +41,33 @@ bool KeysWorker::wasPressed(int code)
 	return false;
 }
 
-void KeysWorker::readKeysEvent()
+bool KeysWorker::isPressed(int code)
+{
+	Q_UNUSED(code)
+
+	return false;
+}
+
+int KeysWorker::pressDuration(int code)
+{
+	Q_UNUSED(code)
+
+	return 0;
+}
+
+void KeysWorker::onNewEvent(int eventType, int code, int value, qint64 timestamp)
+{
+	Q_UNUSED(eventType)
+	Q_UNUSED(code)
+	Q_UNUSED(value)
+	Q_UNUSED(timestamp)
+}
+
+void KeysWorker::checkLongPresses()
+{
+}
+
+void KeysWorker::applyKeyEvent(KeyEvent const &event)
 {
+	Q_UNUSED(event)
 }
@@ -16,17 +16,27 @@
 
 #include <QtCore/QDebug>
 
+#include "src/eventDeviceInterface.h"
+
 using namespace trikControl;
 
-Sensor3dWorker::Sensor3dWorker(int min, int max, QString const &controlFile)
+Sensor3dWorker::Sensor3dWorker(DeviceBackendInterface &backend, int min, int max, QString const &controlFile)
 {
+	Q_UNUSED(backend)
 	Q_UNUSED(min)
 	Q_UNUSED(max)
 	Q_UNUSED(controlFile)
 }
 
-void Sensor3dWorker::readFile()
+Sensor3dWorker::~Sensor3dWorker()
+{
+}
+
+void Sensor3dWorker::onNewEvent(int eventType, int code, int value)
 {
+	Q_UNUSED(eventType)
+	Q_UNUSED(code)
+	Q_UNUSED(value)
 }
 
 QVector<int> Sensor3dWorker::read()
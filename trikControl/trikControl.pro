@@ -38,51 +38,108 @@ HEADERS += \
 	$$PWD/include/trikControl/pwmCapture.h \
 	$$PWD/include/trikControl/motor.h \
 	$$PWD/include/trikControl/lineSensor.h \
+	$$PWD/src/abstractConnector.h \
+	$$PWD/src/abstractDisplayWorker.h \
 	$$PWD/src/abstractVirtualSensorWorker.h \
+	$$PWD/src/animationPlayer.h \
 	$$PWD/src/angularServoMotor.h \
+	$$PWD/src/atomicBitset.h \
+	$$PWD/src/canvas.h \
 	$$PWD/src/colorSensorWorker.h \
+	$$PWD/src/compiledConfig.h \
 	$$PWD/src/configurer.h \
 	$$PWD/src/continiousRotationServoMotor.h \
+	$$PWD/src/deviceBackendInterface.h \
+	$$PWD/src/deviceFileInterface.h \
+	$$PWD/src/drawCommandBuffer.h \
+	$$PWD/src/evdevEventDevice.h \
+	$$PWD/src/eventDeviceInterface.h \
+	$$PWD/src/fifoVirtualSensorDevice.h \
+	$$PWD/src/framebufferInterface.h \
+	$$PWD/src/framebufferWorker.h \
+	$$PWD/src/gamepadState.h \
 	$$PWD/src/graphicsWidget.h \
 	$$PWD/src/guiWorker.h \
+	$$PWD/src/hardwareDeviceBackend.h \
+	$$PWD/src/hardwareFramebuffer.h \
+	$$PWD/src/hardwareI2cBus.h \
+	$$PWD/src/i2cBusInterface.h \
 	$$PWD/src/i2cCommunicator.h \
+	$$PWD/src/imageCache.h \
 	$$PWD/src/keysWorker.h \
+	$$PWD/src/labelLayer.h \
 	$$PWD/src/lineSensorWorker.h \
+	$$PWD/src/memoryFramebuffer.h \
+	$$PWD/src/monotonicClock.h \
 	$$PWD/src/objectSensorWorker.h \
 	$$PWD/src/powerMotor.h \
+	$$PWD/src/primitiveStore.h \
 	$$PWD/src/sensor3dWorker.h \
 	$$PWD/src/servoMotor.h \
+	$$PWD/src/simulatedDeviceBackend.h \
+	$$PWD/src/simulatedDeviceFile.h \
+	$$PWD/src/simulatedEventDevice.h \
+	$$PWD/src/simulatedI2cBus.h \
+	$$PWD/src/simulatedMotorModel.h \
+	$$PWD/src/simulatedVirtualSensorDevice.h \
+	$$PWD/src/sysfsDeviceFile.h \
 	$$PWD/src/tcpConnector.h \
+	$$PWD/src/udpConnector.h \
+	$$PWD/src/virtualSensorDeviceInterface.h \
 
 SOURCES += \
+	$$PWD/src/abstractDisplayWorker.cpp \
+	$$PWD/src/abstractVirtualSensorWorker.cpp \
 	$$PWD/src/analogSensor.cpp \
+	$$PWD/src/animationPlayer.cpp \
 	$$PWD/src/angularServoMotor.cpp \
 	$$PWD/src/battery.cpp \
 	$$PWD/src/brick.cpp \
+	$$PWD/src/canvas.cpp \
 	$$PWD/src/colorSensor.cpp \
 	$$PWD/src/colorSensorWorker.cpp \
+	$$PWD/src/compiledConfig.cpp \
 	$$PWD/src/configurer.cpp \
 	$$PWD/src/continiousRotationServoMotor.cpp \
 	$$PWD/src/digitalSensor.cpp \
 	$$PWD/src/display.cpp \
+	$$PWD/src/drawCommandBuffer.cpp \
 	$$PWD/src/encoder.cpp \
+	$$PWD/src/framebufferWorker.cpp \
 	$$PWD/src/gamepad.cpp \
+	$$PWD/src/gamepadState.cpp \
 	$$PWD/src/graphicsWidget.cpp \
 	$$PWD/src/guiWorker.cpp \
+	$$PWD/src/hardwareDeviceBackend.cpp \
+	$$PWD/src/i2cCommunicator.cpp \
+	$$PWD/src/imageCache.cpp \
 	$$PWD/src/keys.cpp \
+	$$PWD/src/labelLayer.cpp \
 	$$PWD/src/led.cpp \
 	$$PWD/src/lineSensor.cpp \
 	$$PWD/src/lineSensorWorker.cpp \
+	$$PWD/src/memoryFramebuffer.cpp \
 	$$PWD/src/objectSensor.cpp \
 	$$PWD/src/objectSensorWorker.cpp \
 	$$PWD/src/powerMotor.cpp \
 	$$PWD/src/pwmCapture.cpp \
 	$$PWD/src/sensor3d.cpp \
 	$$PWD/src/servoMotor.cpp \
+	$$PWD/src/simulatedDeviceBackend.cpp \
+	$$PWD/src/simulatedDeviceFile.cpp \
+	$$PWD/src/simulatedEventDevice.cpp \
+	$$PWD/src/simulatedI2cBus.cpp \
+	$$PWD/src/simulatedMotorModel.cpp \
+	$$PWD/src/simulatedVirtualSensorDevice.cpp \
+	$$PWD/src/sysfsDeviceFile.cpp \
 	$$PWD/src/tcpConnector.cpp \
-	$$PWD/src/$$PLATFORM/abstractVirtualSensorWorker.cpp \
-	$$PWD/src/$$PLATFORM/i2cCommunicator.cpp \
+	$$PWD/src/udpConnector.cpp \
+	$$PWD/src/$$PLATFORM/evdevEventDevice.cpp \
+	$$PWD/src/$$PLATFORM/fifoVirtualSensorDevice.cpp \
+	$$PWD/src/$$PLATFORM/hardwareFramebuffer.cpp \
+	$$PWD/src/$$PLATFORM/hardwareI2cBus.cpp \
 	$$PWD/src/$$PLATFORM/keysWorker.cpp \
+	$$PWD/src/$$PLATFORM/monotonicClock.cpp \
 	$$PWD/src/$$PLATFORM/sensor3dWorker.cpp \
 
 OTHER_FILES += \
@@ -92,12 +149,14 @@ TEMPLATE = lib
 
 DEFINES += TRIKCONTROL_LIBRARY
 
-QT += xml gui network
+QT += gui network
 
 if (equals(QT_MAJOR_VERSION, 5)) {
 	QT += widgets
 }
 
+uses(trikKernel)
+
 copyToDestdir( \
 	$$PWD/config.xml  \
 	$$PWD/config_capture.xml \
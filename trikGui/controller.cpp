@@ -19,17 +19,21 @@
 #include <QtCore/QDebug>
 
 #include <trikKernel/fileUtils.h>
+#include <trikWiFi/trikWiFi.h>
+#include <trikWiFi/connectionManager.h>
 
 #include "runningWidget.h"
 
 using namespace trikGui;
 
 int const communicatorPort = 8888;
+int const metricsDumpInterval = 10000;
 
 Controller::Controller(QString const &configPath, QString const &startDirPath)
 	: mBrick(*thread(), configPath, startDirPath)
 	, mScriptRunner(mBrick, startDirPath)
-	, mCommunicator(mScriptRunner)
+	, mCommunicator(mScriptRunner, mBrick)
+	, mMetricsDumper(startDirPath + "metrics.txt", metricsDumpInterval)
 	, mRunningWidget(NULL)
 {
 	connect(&mScriptRunner, SIGNAL(completed(QString)), this, SLOT(scriptExecutionCompleted(QString)));
@@ -45,6 +49,30 @@ Controller::~Controller()
 	delete mRunningWidget;
 }
 
+trikWiFi::TrikWiFi &Controller::wiFi()
+{
+	if (!mWiFi) {
+		mWiFi.reset(new trikWiFi::TrikWiFi("/tmp/trikwifi", "/run/wpa_supplicant/wlan0"));
+	}
+
+	return *mWiFi;
+}
+
+trikWiFi::ConnectionManager &Controller::connectionManager()
+{
+	if (!mConnectionManager) {
+		mConnectionManager.reset(new trikWiFi::ConnectionManager(wiFi()));
+	}
+
+	return *mConnectionManager;
+}
+
+void Controller::resetWiFi()
+{
+	mConnectionManager.reset();
+	mWiFi.reset();
+}
+
 void Controller::runFile(QString const &filePath)
 {
 	QFileInfo const fileInfo(filePath);
@@ -14,9 +14,17 @@
 
 #pragma once
 
+#include <QtCore/QScopedPointer>
+
 #include <trikCommunicator/trikCommunicator.h>
 #include <trikScriptRunner/trikScriptRunner.h>
 #include <trikControl/brick.h>
+#include <trikKernel/metricsDumper.h>
+
+namespace trikWiFi {
+class TrikWiFi;
+class ConnectionManager;
+}
 
 namespace trikGui
 {
@@ -45,6 +53,17 @@ public:
 	/// Returns reference to Brick object, which provides access to low-level robot functionality.
 	trikControl::Brick &brick();
 
+	/// Returns WiFi management object, creates it on first call. It is owned by controller, so connection chosen in
+	/// WiFi client widget is watched and kept alive after the widget is closed.
+	trikWiFi::TrikWiFi &wiFi();
+
+	/// Returns object that keeps WiFi connection alive, creates it on first call.
+	trikWiFi::ConnectionManager &connectionManager();
+
+	/// Destroys WiFi management objects. Shall be called before wpa_supplicant is restarted, for example when WiFi
+	/// mode is changed, they will be created again on next request.
+	void resetWiFi();
+
 private slots:
 	void scriptExecutionCompleted(QString const &error);
 
@@ -55,6 +74,9 @@ private:
 	trikControl::Brick mBrick;
 	trikScriptRunner::TrikScriptRunner mScriptRunner;
 	trikCommunicator::TrikCommunicator mCommunicator;
+	trikKernel::MetricsDumper mMetricsDumper;
+	QScopedPointer<trikWiFi::TrikWiFi> mWiFi;
+	QScopedPointer<trikWiFi::ConnectionManager> mConnectionManager;
 
 	RunningWidget *mRunningWidget;  // Has ownership.
 };
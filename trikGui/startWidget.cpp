@@ -89,7 +89,7 @@ void StartWidget::launch()
 			emit newWidget(fileManagerWidget);
 			result = fileManagerWidget.exec();
 		} else if (currentItemText == WiFiModeWidget::menuEntry()) {
-			WiFiModeWidget wiFiModeWidget(mConfigPath);
+			WiFiModeWidget wiFiModeWidget(mController, mConfigPath);
 			emit newWidget(wiFiModeWidget);
 			result = wiFiModeWidget.exec();
 		} else if (currentItemText == MotorsWidget::menuEntry(trikControl::Motor::powerMotor)) {
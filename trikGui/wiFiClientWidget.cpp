@@ -32,29 +32,34 @@
 #include <QtCore/QDebug>
 
 #include <trikWiFi/trikWiFi.h>
+#include <trikWiFi/connectionManager.h>
 #include <trikWiFi/wpaConfigurer.h>
 
+#include "controller.h"
+
 using namespace trikGui;
 
 using namespace trikWiFi;
 
-WiFiClientWidget::WiFiClientWidget(QString const &configPath, QWidget *parent)
+WiFiClientWidget::WiFiClientWidget(Controller &controller, QString const &configPath, QWidget *parent)
 	: TrikGuiDialog(parent)
-	, mWiFi(new TrikWiFi("/tmp/trikwifi", "/run/wpa_supplicant/wlan0", this))
+	, mController(controller)
+	, mWiFi(controller.wiFi())
 	, mConnectionState(notConnected)
 {
-	WpaConfigurer::configureWpaSupplicant(configPath + "wpa-config.xml", *mWiFi);
+	WpaConfigurer::configureWpaSupplicant(configPath + "wpa-config.xml", mWiFi);
 
-	QList<NetworkConfiguration> const networksFromWpaSupplicant = mWiFi->listNetworks();
+	QList<NetworkConfiguration> const networksFromWpaSupplicant = mWiFi.listNetworks();
 	foreach (NetworkConfiguration const &networkConfiguration, networksFromWpaSupplicant) {
 		mNetworksAvailableForConnection.insert(networkConfiguration.ssid, networkConfiguration.id);
 	}
 
-	connect(mWiFi.data(), SIGNAL(scanFinished()), this, SLOT(scanForAvailableNetworksDoneSlot()));
-	connect(mWiFi.data(), SIGNAL(connected()), this, SLOT(connectedSlot()));
-	connect(mWiFi.data(), SIGNAL(disconnected()), this, SLOT(disconnectedSlot()));
+	connect(&mWiFi, SIGNAL(bssAdded(trikWiFi::ScanResult)), this, SLOT(bssAddedSlot(trikWiFi::ScanResult)));
+	connect(&mWiFi, SIGNAL(bssRemoved(trikWiFi::ScanResult)), this, SLOT(bssRemovedSlot(trikWiFi::ScanResult)));
+	connect(&mWiFi, SIGNAL(connected()), this, SLOT(connectedSlot()));
+	connect(&mWiFi, SIGNAL(disconnected()), this, SLOT(disconnectedSlot()));
 
-	mWiFi->scan();
+	mWiFi.scan();
 
 	mConnectionIconLabel.setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
 
@@ -75,7 +80,11 @@ WiFiClientWidget::WiFiClientWidget(QString const &configPath, QWidget *parent)
 	mMainLayout.addWidget(&mAvailableNetworksView);
 	setLayout(&mMainLayout);
 
-	Status const connectionStatus = mWiFi->status();
+	foreach (ScanResult const &result, mWiFi.scanResults()) {
+		bssAddedSlot(result);
+	}
+
+	Status const connectionStatus = mWiFi.status();
 	mConnectionState = connectionStatus.connected ? connected : notConnected;
 	setConnectionStatus(connectionStatus);
 }
@@ -89,20 +98,39 @@ void WiFiClientWidget::renewFocus()
 	mAvailableNetworksView.setFocus();
 }
 
-void WiFiClientWidget::scanForAvailableNetworksDoneSlot()
+void WiFiClientWidget::bssAddedSlot(trikWiFi::ScanResult const &result)
 {
-	mAvailableNetworksModel.clear();
-	foreach (ScanResult const &result, mWiFi->scanResults()) {
-		mAvailableNetworksModel.appendRow(new QStandardItem(result.ssid));
+	QStandardItem *item = findNetworkItem(result.bssid);
+	if (item) {
+		item->setText(result.ssid);
+	} else {
+		item = new QStandardItem(result.ssid);
+		item->setData(result.bssid);
+		mAvailableNetworksModel.appendRow(item);
 	}
 
-	updateConnectionStatusesInNetworkList();
+	updateConnectionStatus(*item);
+
+	if (!mAvailableNetworksView.selectionModel()->hasSelection()) {
+		mAvailableNetworksView.selectionModel()->select(
+				mAvailableNetworksModel.index(0, 0)
+				, QItemSelectionModel::ClearAndSelect
+				);
+	}
+}
+
+void WiFiClientWidget::bssRemovedSlot(trikWiFi::ScanResult const &result)
+{
+	QStandardItem * const item = findNetworkItem(result.bssid);
+	if (item) {
+		mAvailableNetworksModel.removeRow(item->row());
+	}
 }
 
 void WiFiClientWidget::connectedSlot()
 {
 	mConnectionState = connected;
-	setConnectionStatus(mWiFi->status());
+	setConnectionStatus(mWiFi.status());
 }
 
 void WiFiClientWidget::disconnectedSlot()
@@ -111,10 +139,10 @@ void WiFiClientWidget::disconnectedSlot()
 		mConnectionState = notConnected;
 	}
 
-	setConnectionStatus(mWiFi->status());
+	setConnectionStatus(mWiFi.status());
 
 	// Now to determine reason of disconnect --- maybe the network is out of range now.
-	mWiFi->scan();
+	mWiFi.scan();
 }
 
 void WiFiClientWidget::keyPressEvent(QKeyEvent *event)
@@ -159,19 +187,7 @@ void WiFiClientWidget::setConnectionStatus(trikWiFi::Status const &status)
 void WiFiClientWidget::updateConnectionStatusesInNetworkList()
 {
 	for (int i = 0; i < mAvailableNetworksModel.rowCount(); ++i) {
-		QStandardItem * const item = mAvailableNetworksModel.item(i);
-		QFont font = item->font();
-		font.setBold(false);
-		item->setFont(font);
-		if (item->text() == mCurrentSsid) {
-			item->setIcon(QIcon("://resources/connectedToNetwork.png"));
-			font.setBold(true);
-			item->setFont(font);
-		} else if (mNetworksAvailableForConnection.contains(item->text())) {
-			item->setIcon(QIcon("://resources/notConnectedToNetwork.png"));
-		} else {
-			item->setIcon(QIcon("://resources/connectionToNetworkImpossible.png"));
-		}
+		updateConnectionStatus(*mAvailableNetworksModel.item(i));
 	}
 
 	mAvailableNetworksView.setFocus();
@@ -181,6 +197,34 @@ void WiFiClientWidget::updateConnectionStatusesInNetworkList()
 			);
 }
 
+void WiFiClientWidget::updateConnectionStatus(QStandardItem &item)
+{
+	QFont font = item.font();
+	font.setBold(false);
+	item.setFont(font);
+	if (item.text() == mCurrentSsid) {
+		item.setIcon(QIcon("://resources/connectedToNetwork.png"));
+		font.setBold(true);
+		item.setFont(font);
+	} else if (mNetworksAvailableForConnection.contains(item.text())) {
+		item.setIcon(QIcon("://resources/notConnectedToNetwork.png"));
+	} else {
+		item.setIcon(QIcon("://resources/connectionToNetworkImpossible.png"));
+	}
+}
+
+QStandardItem *WiFiClientWidget::findNetworkItem(QString const &bssid)
+{
+	for (int i = 0; i < mAvailableNetworksModel.rowCount(); ++i) {
+		QStandardItem * const item = mAvailableNetworksModel.item(i);
+		if (item->data().toString() == bssid) {
+			return item;
+		}
+	}
+
+	return nullptr;
+}
+
 void WiFiClientWidget::connectToSelectedNetwork()
 {
 	QModelIndexList const selected = mAvailableNetworksView.selectionModel()->selectedIndexes();
@@ -201,5 +245,5 @@ void WiFiClientWidget::connectToSelectedNetwork()
 
 	setConnectionStatus(Status());
 
-	mWiFi->connect(mNetworksAvailableForConnection[ssid]);
+	mController.connectionManager().connectTo(mNetworksAvailableForConnection[ssid]);
 }
@@ -35,26 +35,27 @@
 #include <QtGui/QStandardItem>
 #include <QtGui/QStandardItemModel>
 
-#include "trikGuiDialog.h"
+#include <trikWiFi/trikWiFi.h>
 
-namespace trikWiFi {
-class TrikWiFi;
-struct Status;
-}
+#include "trikGuiDialog.h"
 
 namespace trikGui {
 
+class Controller;
+
 /// Widget that shows current IP address and a list of available WiFi networks.
-/// Network is available only when it is listed in networks.cfg file and is physically available.
+/// Network is available only when it is listed in networks.cfg file and is physically available. Connection to
+/// chosen network is kept alive by controller, so it outlives this widget.
 class WiFiClientWidget : public TrikGuiDialog
 {
 	Q_OBJECT
 
 public:
 	/// Constructor.
-	/// @param parent - parent QObject.
+	/// @param controller - controller that owns WiFi management objects.
 	/// @param configPath - path to wpa-config.xml.
-	explicit WiFiClientWidget(QString const &configPath, QWidget *parent = 0);
+	/// @param parent - parent QObject.
+	WiFiClientWidget(Controller &controller, QString const &configPath, QWidget *parent = 0);
 
 	/// Destructor.
 	~WiFiClientWidget();
@@ -65,7 +66,8 @@ protected:
 	void keyPressEvent(QKeyEvent *event) override;
 
 private slots:
-	void scanForAvailableNetworksDoneSlot();
+	void bssAddedSlot(trikWiFi::ScanResult const &result);
+	void bssRemovedSlot(trikWiFi::ScanResult const &result);
 	void connectedSlot();
 	void disconnectedSlot();
 
@@ -84,13 +86,18 @@ private:
 	QStandardItemModel mAvailableNetworksModel;
 	QVBoxLayout mMainLayout;
 	QHBoxLayout mIpAddressLayout;
-	QScopedPointer<trikWiFi::TrikWiFi> mWiFi;
+	Controller &mController;
+	trikWiFi::TrikWiFi &mWiFi;
 	QString mCurrentSsid;
 	QHash<QString, int> mNetworksAvailableForConnection;
 	ConnectionState mConnectionState;
 
 	void setConnectionStatus(trikWiFi::Status const &status);
 	void updateConnectionStatusesInNetworkList();
+	void updateConnectionStatus(QStandardItem &item);
+
+	/// Returns item of a network with given BSSID in the list of available networks, or nullptr if there is none.
+	QStandardItem *findNetworkItem(QString const &bssid);
 	void connectToSelectedNetwork();
 };
 
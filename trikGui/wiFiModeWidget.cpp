@@ -17,15 +17,17 @@
 #include <QtGui/QKeyEvent>
 #include <QtCore/QDebug>
 
+#include "controller.h"
 #include "wiFiClientWidget.h"
 #include "wiFiAPWidget.h"
 #include "wiFiInitWidget.h"
 
 using namespace trikGui;
 
-WiFiModeWidget::WiFiModeWidget(QString const &configPath
+WiFiModeWidget::WiFiModeWidget(Controller &controller, QString const &configPath
 		, QWidget *parent)
 	: TrikGuiDialog(parent)
+	, mController(controller)
 	, mConfigPath(configPath)
 	, mRcReader("/etc/trik/trikrc")
 	, mTitle(tr("Choose mode:"))
@@ -85,6 +87,9 @@ void WiFiModeWidget::setMode(Mode mode)
 	}
 
 	if (currentMode != mode) {
+		// Mode switch restarts wpa_supplicant, so connections to it shall be closed.
+		mController.resetWiFi();
+
 		WiFiInitWidget wiFiInitWidget;
 		emit newWidget(wiFiInitWidget);
 		if (wiFiInitWidget.init(mode) == WiFiInitWidget::fail) {
@@ -96,7 +101,7 @@ void WiFiModeWidget::setMode(Mode mode)
 
 	switch (mode) {
 		case client: {
-			WiFiClientWidget wiFiClientWidget(mConfigPath);
+			WiFiClientWidget wiFiClientWidget(mController, mConfigPath);
 			emit newWidget(wiFiClientWidget);
 			returnValue = wiFiClientWidget.exec();
 			break;
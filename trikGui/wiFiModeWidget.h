@@ -35,6 +35,8 @@
 
 namespace trikGui {
 
+class Controller;
+
 /// Widget which allows to set wi-fi mode (client or access point) and then opens corresponding configuration widget.
 class WiFiModeWidget : public TrikGuiDialog
 {
@@ -48,9 +50,10 @@ public:
 	};
 
 	/// Constructor
+	/// @param controller - controller that owns WiFi management objects.
 	/// @param configPath - full path to configuration files.
 	/// @param parent - parent of this widget in Qt object hierarchy.
-	WiFiModeWidget(QString const &configPath, QWidget *parent = 0);
+	WiFiModeWidget(Controller &controller, QString const &configPath, QWidget *parent = 0);
 
 	/// Returns menu entry for this widget.
 	static QString menuEntry();
@@ -63,6 +66,7 @@ protected:
 private:
 	void setMode(Mode mode);
 
+	Controller &mController;
 	QString const &mConfigPath;
 	RcReader mRcReader;
 	QEventLoop mEventLoop;
@@ -0,0 +1,50 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+#include <atomic>
+
+namespace trikKernel {
+
+/// Monotonically increasing metric, for example a number of processed requests. Lock-free, can be incremented
+/// from any thread.
+class Counter
+{
+public:
+	/// Adds given value to a counter.
+	void increment(qint64 delta = 1)
+	{
+		mValue.fetch_add(delta, std::memory_order_relaxed);
+	}
+
+	/// Returns current value of a counter.
+	qint64 value() const
+	{
+		return mValue.load(std::memory_order_relaxed);
+	}
+
+	/// Sets counter to zero.
+	void reset()
+	{
+		mValue.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<qint64> mValue {0};
+};
+
+}
@@ -0,0 +1,72 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+#include <atomic>
+
+namespace trikKernel {
+
+/// Distribution of non-negative values (typically latencies in microseconds) with fixed log-linear buckets:
+/// every power of two is split into 8 equal sub-buckets, so a relative error of a percentile is at most 12.5%
+/// and no memory is allocated when a value is recorded. Lock-free, values can be recorded from any thread.
+class Histogram
+{
+public:
+	Histogram();
+
+	/// Adds a value to a distribution. Negative values are treated as zero, too big values fall into the last bucket.
+	void record(qint64 value);
+
+	/// Returns a number of recorded values.
+	qint64 count() const;
+
+	/// Returns a sum of recorded values.
+	qint64 sum() const;
+
+	/// Returns minimal recorded value or 0 if nothing was recorded.
+	qint64 min() const;
+
+	/// Returns maximal recorded value or 0 if nothing was recorded.
+	qint64 max() const;
+
+	/// Returns an estimate of a given percentile (0 - 100), that is, an upper bound of a bucket where it falls.
+	qint64 percentile(double percent) const;
+
+	/// Forgets all recorded values.
+	void reset();
+
+private:
+	/// Number of sub-buckets in each power of two is 2 ^ subBucketBits.
+	static int const subBucketBits = 3;
+	static int const subBucketCount = 1 << subBucketBits;
+
+	/// Values up to 2 ^ maxValueBits - 1 (about 9.5 hours in microseconds) are distinguished.
+	static int const maxValueBits = 35;
+
+	static int const bucketCount = (maxValueBits - subBucketBits + 1) * subBucketCount;
+
+	static int bucketIndex(qint64 value);
+	static qint64 bucketUpperBound(int index);
+
+	std::atomic<qint64> mBuckets[bucketCount];
+	std::atomic<qint64> mCount;
+	std::atomic<qint64> mSum;
+	std::atomic<qint64> mMin;
+	std::atomic<qint64> mMax;
+};
+
+}
@@ -0,0 +1,45 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+
+namespace trikKernel {
+
+/// Periodically writes contents of MetricsRegistry to a file, so metrics can be inspected on a running robot
+/// without connecting to it.
+class MetricsDumper : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param fileName - file that will be overwritten with current metrics values on each dump.
+	/// @param interval - time between dumps in milliseconds.
+	/// @param parent - parent of this object in terms of Qt parent-child relations.
+	MetricsDumper(QString const &fileName, int interval, QObject *parent = 0);
+
+public slots:
+	/// Writes metrics to a file immediately.
+	void dump();
+
+private:
+	QString const mFileName;
+	QTimer mTimer;
+};
+
+}
@@ -0,0 +1,58 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QString>
+
+#include "counter.h"
+#include "gauge.h"
+#include "histogram.h"
+
+namespace trikKernel {
+
+/// Process-wide registry of named runtime metrics. Metrics are created on first request and live until the end
+/// of a process, so returned references can be safely cached, for example in function-local static variables:
+/// @code
+/// static trikKernel::Counter &reads = trikKernel::MetricsRegistry::counter("i2c.reads");
+/// reads.increment();
+/// @endcode
+/// Lookup takes a lock, but updating a metric does not.
+class MetricsRegistry
+{
+public:
+	/// Returns counter with given name, creating it if needed.
+	static Counter &counter(QString const &name);
+
+	/// Returns gauge with given name, creating it if needed.
+	static Gauge &gauge(QString const &name);
+
+	/// Returns histogram with given name, creating it if needed.
+	static Histogram &histogram(QString const &name);
+
+	/// Returns current values of all metrics as human- and machine-readable text, one metric per line, grouped by kind
+	/// and sorted by name:
+	/// "counter <name> <value>", "gauge <name> <value>" or
+	/// "histogram <name> count=<n> sum=<s> min=<v> p50=<v> p90=<v> p99=<v> max=<v>".
+	static QString toText();
+
+	/// Returns monotonic time in microseconds since an unspecified moment. Can be compared between threads, so it is
+	/// suitable for measuring latencies of cross-thread calls.
+	static qint64 now();
+
+	/// Resets all counters and histograms. Gauges are left untouched since they reflect current state.
+	static void reset();
+};
+
+}
@@ -0,0 +1,45 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+
+#include "histogram.h"
+
+namespace trikKernel {
+
+/// Measures time between its construction and destruction and records it in microseconds into given histogram.
+class ScopedTimer
+{
+public:
+	/// Constructor.
+	/// @param histogram - histogram that will receive measured time.
+	explicit ScopedTimer(Histogram &histogram)
+		: mHistogram(histogram)
+	{
+		mTimer.start();
+	}
+
+	~ScopedTimer()
+	{
+		mHistogram.record(mTimer.nsecsElapsed() / 1000);
+	}
+
+private:
+	Histogram &mHistogram;
+	QElapsedTimer mTimer;
+};
+
+}
@@ -0,0 +1,126 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "histogram.h"
+
+#include <limits>
+
+using namespace trikKernel;
+
+Histogram::Histogram()
+{
+	reset();
+}
+
+void Histogram::record(qint64 value)
+{
+	if (value < 0) {
+		value = 0;
+	}
+
+	mBuckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	mCount.fetch_add(1, std::memory_order_relaxed);
+	mSum.fetch_add(value, std::memory_order_relaxed);
+
+	qint64 currentMin = mMin.load(std::memory_order_relaxed);
+	while (value < currentMin && !mMin.compare_exchange_weak(currentMin, value, std::memory_order_relaxed)) {
+	}
+
+	qint64 currentMax = mMax.load(std::memory_order_relaxed);
+	while (value > currentMax && !mMax.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+	}
+}
+
+qint64 Histogram::count() const
+{
+	return mCount.load(std::memory_order_relaxed);
+}
+
+qint64 Histogram::sum() const
+{
+	return mSum.load(std::memory_order_relaxed);
+}
+
+qint64 Histogram::min() const
+{
+	return count() == 0 ? 0 : mMin.load(std::memory_order_relaxed);
+}
+
+qint64 Histogram::max() const
+{
+	return mMax.load(std::memory_order_relaxed);
+}
+
+qint64 Histogram::percentile(double percent) const
+{
+	qint64 const total = count();
+	if (total == 0) {
+		return 0;
+	}
+
+	qint64 const rank = qMax(static_cast<qint64>(1), static_cast<qint64>(percent / 100.0 * total + 0.5));
+	qint64 seen = 0;
+	for (int i = 0; i < bucketCount; ++i) {
+		seen += mBuckets[i].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			return i == bucketCount - 1 ? max() : qMin(bucketUpperBound(i), max());
+		}
+	}
+
+	return max();
+}
+
+void Histogram::reset()
+{
+	for (int i = 0; i < bucketCount; ++i) {
+		mBuckets[i].store(0, std::memory_order_relaxed);
+	}
+
+	mCount.store(0, std::memory_order_relaxed);
+	mSum.store(0, std::memory_order_relaxed);
+	mMin.store(std::numeric_limits<qint64>::max(), std::memory_order_relaxed);
+	mMax.store(0, std::memory_order_relaxed);
+}
+
+int Histogram::bucketIndex(qint64 value)
+{
+	if (value < subBucketCount) {
+		return static_cast<int>(value);
+	}
+
+	if (value >= (static_cast<qint64>(1) << maxValueBits)) {
+		return bucketCount - 1;
+	}
+
+	int highestBit = subBucketBits;
+	while ((value >> (highestBit + 1)) != 0) {
+		++highestBit;
+	}
+
+	// Position of a value inside its power of two is taken from subBucketBits bits right after the highest one.
+	int const shift = highestBit - subBucketBits;
+	int const subBucket = static_cast<int>(value >> shift) - subBucketCount;
+	return (shift + 1) * subBucketCount + subBucket;
+}
+
+qint64 Histogram::bucketUpperBound(int index)
+{
+	if (index < subBucketCount) {
+		return index;
+	}
+
+	int const shift = index / subBucketCount - 1;
+	qint64 const lowerBound = static_cast<qint64>(subBucketCount + index % subBucketCount) << shift;
+	return lowerBound + (static_cast<qint64>(1) << shift) - 1;
+}
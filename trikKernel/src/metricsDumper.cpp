@@ -0,0 +1,39 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "metricsDumper.h"
+
+#include <QtCore/QDebug>
+
+#include "fileUtils.h"
+#include "metricsRegistry.h"
+
+using namespace trikKernel;
+
+MetricsDumper::MetricsDumper(QString const &fileName, int interval, QObject *parent)
+	: QObject(parent)
+	, mFileName(fileName)
+{
+	connect(&mTimer, SIGNAL(timeout()), this, SLOT(dump()));
+	mTimer.start(interval);
+}
+
+void MetricsDumper::dump()
+{
+	try {
+		FileUtils::writeToFile(mFileName, MetricsRegistry::toText());
+	} catch (char const *) {
+		qDebug() << "Failed to dump metrics to" << mFileName;
+	}
+}
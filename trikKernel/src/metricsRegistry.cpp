@@ -0,0 +1,122 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "metricsRegistry.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QStringList>
+
+using namespace trikKernel;
+
+namespace {
+
+/// Storage for all metrics. Metrics are never deleted, so references to them stay valid during program lifetime.
+struct Storage
+{
+	Storage()
+	{
+		clock.start();
+	}
+
+	QMutex lock;
+	QMap<QString, Counter *> counters;
+	QMap<QString, Gauge *> gauges;
+	QMap<QString, Histogram *> histograms;
+	QElapsedTimer clock;
+};
+
+Storage &storage()
+{
+	static Storage instance;
+	return instance;
+}
+
+template<typename T>
+T &findOrCreate(QMap<QString, T *> &metrics, QString const &name)
+{
+	QMutexLocker locker(&storage().lock);
+	T *&metric = metrics[name];
+	if (!metric) {
+		metric = new T();
+	}
+
+	return *metric;
+}
+
+}
+
+Counter &MetricsRegistry::counter(QString const &name)
+{
+	return findOrCreate(storage().counters, name);
+}
+
+Gauge &MetricsRegistry::gauge(QString const &name)
+{
+	return findOrCreate(storage().gauges, name);
+}
+
+Histogram &MetricsRegistry::histogram(QString const &name)
+{
+	return findOrCreate(storage().histograms, name);
+}
+
+QString MetricsRegistry::toText()
+{
+	QMutexLocker locker(&storage().lock);
+
+	QStringList lines;
+
+	for (auto it = storage().counters.constBegin(); it != storage().counters.constEnd(); ++it) {
+		lines << QString("counter %1 %2").arg(it.key()).arg(it.value()->value());
+	}
+
+	for (auto it = storage().gauges.constBegin(); it != storage().gauges.constEnd(); ++it) {
+		lines << QString("gauge %1 %2").arg(it.key()).arg(it.value()->value());
+	}
+
+	for (auto it = storage().histograms.constBegin(); it != storage().histograms.constEnd(); ++it) {
+		Histogram const &histogram = *it.value();
+		lines << QString("histogram %1 count=%2 sum=%3 min=%4 p50=%5 p90=%6 p99=%7 max=%8")
+				.arg(it.key())
+				.arg(histogram.count())
+				.arg(histogram.sum())
+				.arg(histogram.min())
+				.arg(histogram.percentile(50))
+				.arg(histogram.percentile(90))
+				.arg(histogram.percentile(99))
+				.arg(histogram.max());
+	}
+
+	return lines.join("\n") + "\n";
+}
+
+qint64 MetricsRegistry::now()
+{
+	return storage().clock.nsecsElapsed() / 1000;
+}
+
+void MetricsRegistry::reset()
+{
+	QMutexLocker locker(&storage().lock);
+
+	for (Counter * const counter : storage().counters) {
+		counter->reset();
+	}
+
+	for (Histogram * const histogram : storage().histograms) {
+		histogram->reset();
+	}
+}
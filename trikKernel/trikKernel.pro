@@ -17,10 +17,19 @@ include(../global.pri)
 HEADERS += \
 	$$PWD/include/trikKernel/fileUtils.h \
 	$$PWD/include/trikKernel/debug.h \
+	$$PWD/include/trikKernel/counter.h \
+	$$PWD/include/trikKernel/gauge.h \
+	$$PWD/include/trikKernel/histogram.h \
+	$$PWD/include/trikKernel/metricsDumper.h \
+	$$PWD/include/trikKernel/metricsRegistry.h \
+	$$PWD/include/trikKernel/scopedTimer.h \
 
 SOURCES += \
 	$$PWD/src/fileUtils.cpp \
 	$$PWD/src/debug.cpp \
+	$$PWD/src/histogram.cpp \
+	$$PWD/src/metricsDumper.cpp \
+	$$PWD/src/metricsRegistry.cpp \
 
 TEMPLATE = lib
 
@@ -24,8 +24,22 @@ SUBDIRS = \
 	trikGui \
 	trikWiFi \
 
+# Benchmarks need QtTest and use internals of libraries, so they are built only on request: qmake CONFIG+=benchmarks
+CONFIG(benchmarks) {
+	SUBDIRS += benchmarks
+	benchmarks.depends = trikCommunicator trikScriptRunner trikControl trikKernel trikWiFi
+}
+
+# Tests need QtTest too and are built only on request: qmake CONFIG+=tests
+CONFIG(tests) {
+	SUBDIRS += tests
+	tests.depends = trikKernel trikWiFi
+}
+
+trikControl.depends = trikKernel
 trikScriptRunner.depends = trikControl trikKernel
 trikCommunicator.depends = trikScriptRunner
 trikRun.depends = trikScriptRunner trikKernel
 trikServer.depends = trikCommunicator
 trikGui.depends = trikCommunicator trikScriptRunner trikWiFi trikKernel
+trikWiFi.depends = trikKernel
@@ -20,6 +20,7 @@
 
 #include <trikKernel/fileUtils.h>
 #include <trikKernel/debug.h>
+#include <trikKernel/metricsRegistry.h>
 
 #include <trikControl/battery.h>
 #include <trikControl/display.h>
@@ -88,6 +89,11 @@ ScriptEngineWorker &ScriptEngineWorker::clone()
 	return *result;
 }
 
+void ScriptEngineWorker::markRunRequested()
+{
+	mRunRequestTime = trikKernel::MetricsRegistry::now();
+}
+
 void ScriptEngineWorker::init()
 {
 	resetScriptEngine();
@@ -95,8 +101,17 @@ void ScriptEngineWorker::init()
 
 void ScriptEngineWorker::run(QString const &script, bool inEventDrivenMode, QString const &function)
 {
+	static trikKernel::Counter &runs = trikKernel::MetricsRegistry::counter("scriptRunner.runs");
+	static trikKernel::Histogram &startLatency = trikKernel::MetricsRegistry::histogram("scriptRunner.startLatencyUs");
+
 	Q_ASSERT(mEngine);
 
+	runs.increment();
+	qint64 const requestTime = mRunRequestTime.exchange(-1);
+	if (requestTime >= 0) {
+		startLatency.record(trikKernel::MetricsRegistry::now() - requestTime);
+	}
+
 	if (inEventDrivenMode) {
 		mBrick.run();
 	}
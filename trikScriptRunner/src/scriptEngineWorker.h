@@ -18,6 +18,8 @@
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
 
+#include <atomic>
+
 #include <trikControl/brick.h>
 
 #include "threading.h"
@@ -47,6 +49,10 @@ public:
 	/// Takes ownership via Qt parent-child system.
 	ScriptEngineWorker &clone();
 
+	/// Remembers the moment when script execution was requested from another thread, so the next run() call can
+	/// measure script start latency. Thread-safe.
+	void markRunRequested();
+
 signals:
 	/// Emitted when current script execution is completed or is aborted by reset() call.
 	/// @param error - localized error message or empty string.
@@ -80,6 +86,10 @@ private:
 	trikControl::Brick &mBrick;
 	Threading mThreadingVariable;
 	QString const mStartDirPath;
+
+	/// Time of the last markRunRequested() call in microseconds (see trikKernel::MetricsRegistry::now()),
+	/// or -1 if run() was not requested from another thread.
+	std::atomic<qint64> mRunRequestTime {-1};
 };
 
 }
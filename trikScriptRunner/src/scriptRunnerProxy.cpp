@@ -47,6 +47,7 @@ ScriptRunnerProxy::~ScriptRunnerProxy()
 
 void ScriptRunnerProxy::run(QString const &script, bool inEventDrivenMode, QString const &function)
 {
+	mEngineWorker->markRunRequested();
 	QMetaObject::invokeMethod(mEngineWorker, "run"
 			, Q_ARG(QString const &, script)
 			, Q_ARG(bool, inEventDrivenMode)
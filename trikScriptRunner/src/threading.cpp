@@ -14,6 +14,8 @@
 
 #include "threading.h"
 
+#include <trikKernel/metricsRegistry.h>
+
 #include "scriptEngineWorker.h"
 
 using namespace trikScriptRunner;
@@ -59,7 +61,8 @@ void Threading::waitForAll()
 }
 
 Threading::ScriptThread::ScriptThread(QString const &mainScript, QString const &function, ScriptEngineWorker &runner)
-	: mScript(mainScript)
+	: mStartRequestTime(trikKernel::MetricsRegistry::now())
+	, mScript(mainScript)
 	, mFunction(function)
 	, mRunner(runner.clone())
 {
@@ -67,5 +70,8 @@ Threading::ScriptThread::ScriptThread(QString const &mainScript, QString const &
 
 void Threading::ScriptThread::run()
 {
+	static trikKernel::Histogram &spawnLatency = trikKernel::MetricsRegistry::histogram("threading.spawnLatencyUs");
+	spawnLatency.record(trikKernel::MetricsRegistry::now() - mStartRequestTime);
+
 	mRunner.run(mScript, false, mFunction);
 }
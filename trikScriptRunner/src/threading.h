@@ -66,6 +66,10 @@ private:
 	private:
 		void run() override;
 
+		/// Time when thread was requested, in microseconds (see trikKernel::MetricsRegistry::now()). Declared first
+		/// to be initialized before cloning of a script engine, so spawn latency includes it.
+		qint64 const mStartRequestTime;
+
 		QString const mScript;
 		QString const mFunction;
 		ScriptEngineWorker &mRunner;
@@ -27,15 +27,18 @@
 
 #include <trikCommunicator/trikCommunicator.h>
 #include <trikControl/brick.h>
+#include <trikKernel/metricsDumper.h>
 
 void printUsage()
 {
-	qDebug() << "Usage: trikServer [-c <config file name] [-d <working directory name>]";
+	qDebug() << "Usage: trikServer [-c <config file name] [-d <working directory name>] [-s]";
+	qDebug() << "    -s --- serve all clients from one thread instead of a thread per client";
 }
 
 int main(int argc, char *argv[])
 {
 	int const port = 8888;
+	int const metricsDumpInterval = 10000;
 
 	QApplication app(argc, argv);
 
@@ -80,7 +83,10 @@ int main(int argc, char *argv[])
 	trikControl::Brick brick(*app.thread(), configPath, startDirPath);
 
 	trikCommunicator::TrikCommunicator communicator(brick, startDirPath);
+	communicator.setSingleThreaded(app.arguments().contains("-s"));
 	communicator.startServer(port);
 
+	trikKernel::MetricsDumper metricsDumper(startDirPath + "metrics.txt", metricsDumpInterval);
+
 	return app.exec();
 }
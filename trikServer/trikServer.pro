@@ -17,9 +17,10 @@ include(../global.pri)
 SOURCES += \
 	$$PWD/main.cpp \
 
-uses(trikControl trikCommunicator)
+uses(trikKernel trikControl trikCommunicator)
 
 INCLUDEPATH += \
+	../trikKernel/include/ \
 	../trikControl/include/ \
 	../trikCommunicator/include/ \
 
@@ -0,0 +1,91 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QList>
+#include <QtCore/QTimer>
+
+#include "declSpec.h"
+#include "trikWiFi.h"
+
+namespace trikWiFi {
+
+/// Keeps connection to a chosen network alive. Watches signal level of current access point using wpa_supplicant
+/// signal monitor, scans for other access points of the same network in background when signal becomes weak
+/// and roams to a stronger one, and asks wpa_supplicant to reassociate immediately when link is lost. Networks are
+/// switched and restored without explicit disconnect, so an existing link stays up as long as possible.
+///
+/// Reconnect latencies (from link loss, roaming or connection request to restored connection) are recorded in
+/// "wifi.reconnectLatencyUs" histogram, link losses and roams are counted in "wifi.linkLosses" and "wifi.roams"
+/// counters, current signal level is kept in "wifi.signal" gauge.
+class TRIKWIFI_EXPORT ConnectionManager : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param wiFi - WiFi management object used to communicate with wpa_supplicant.
+	/// @param parent - parent QObject.
+	explicit ConnectionManager(TrikWiFi &wiFi, QObject *parent = 0);
+
+	~ConnectionManager() override;
+
+	/// Connects to a network with given id and keeps connection to it.
+	void connectTo(int id);
+
+	/// Stops keeping connection, current connection stays as it is.
+	void release();
+
+	/// Returns time in milliseconds it took to restore connection last time, or -1 if connection was never restored.
+	int lastReconnectLatency() const;
+
+signals:
+	/// Emitted when connection is established or restored after link loss or roaming.
+	/// @param latency - time in milliseconds since link loss, roaming or connection request.
+	void reconnected(int latency);
+
+private slots:
+	void onConnected();
+	void onDisconnected();
+	void onSignalChanged(int level);
+	void onScanResults(QList<trikWiFi::ScanResult> const &results);
+	void onReconnectTimeout();
+
+private:
+	/// Starts measuring reconnect latency, if it is not measured already.
+	void startReconnect();
+
+	void roam(QList<ScanResult> const &results);
+
+	TrikWiFi &mWiFi;
+
+	/// Id of a network to keep connection to, or -1 if connection is not kept.
+	int mNetworkId;
+
+	QString mSsid;
+	QString mBssid;
+	int mLevel;
+	bool mWeakLink;
+
+	/// Time when link was lost, roaming or connection was requested, in microseconds, or -1 if connection is up.
+	qint64 mReconnectStart;
+
+	int mLastReconnectLatency;
+	QTimer mReconnectTimer;
+};
+
+}
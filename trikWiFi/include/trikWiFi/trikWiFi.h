@@ -14,17 +14,22 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QSocketNotifier>
 #include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QThread>
 
 #include "declSpec.h"
 
 namespace trikWiFi {
 
 class WpaSupplicantCommunicator;
+class WpaRequestWorker;
 
 /// Contains info about current connection.
 struct Status
@@ -42,11 +47,17 @@ struct Status
 /// Contains description of a network obtained by scanning.
 struct ScanResult
 {
+	/// BSSID (MAC address of an access point) of a network.
+	QString bssid;
+
 	/// SSID of a network.
 	QString ssid;
 
 	/// Channel of a network.
 	int frequency;
+
+	/// Signal level of a network in dBm.
+	int level;
 };
 
 /// Contains configuration entry from wpa-supplicant config.
@@ -77,21 +88,34 @@ public:
 	/// Destructor.
 	~TrikWiFi();
 
-	/// Connect to a network with given id. Available ids can be obtained by listNetworks method.
+	/// Connect to a network with given id. Available ids can be obtained by listNetworks method. Current connection,
+	/// if any, is replaced by wpa_supplicant itself, without explicit disconnect.
 	int connect(int id);
 
 	/// Disconnect from network if we are currently connected to one.
 	int disconnect();
 
-	/// Asynchronously scans for available WiFi networks. When done, sends scanFinished signal, then scan results
-	/// can be obtained via scanResults method.
+	/// Asynchronously scans for available WiFi networks. When done, sends scanFinished signal, changes in a list
+	/// of available networks are reported by bssAdded and bssRemoved signals.
 	int scan();
 
 	/// Returns current connection status.
 	Status status() const;
 
-	/// Returns results of the last scan.
-	QList<ScanResult> scanResults();
+	/// Returns currently known networks. They are kept in a table that is updated by wpa_supplicant events, so this
+	/// method does not communicate with wpa_supplicant.
+	QList<ScanResult> scanResults() const;
+
+	/// Asynchronously reads all scan results from wpa_supplicant on a worker thread and synchronizes the table of known
+	/// networks with them. When done, sends scanResultsReady signal.
+	void requestScanResults();
+
+	/// Asynchronously sends a command to wpa_supplicant. Requests are processed on a worker thread one by one in order
+	/// of submission.
+	/// @param command - command to wpa_supplicant.
+	/// @param callback - called in the thread of this object when the request is done, with 0 and a reply from
+	///        wpa_supplicant if request succeeded, or with -1 otherwise. May be empty.
+	void requestAsync(QString const &command, std::function<void(int, QString const &)> const &callback);
 
 	/// Adds new network into wpa_supplicant configuration.
 	/// @returns id of a newly added network.
@@ -115,28 +139,65 @@ public:
 	/// Returns a list of networks from wpa_supplicant config.
 	QList<NetworkConfiguration> listNetworks();
 
+	/// Sets shell command that obtains IP address when wpa_supplicant connects to a network, "udhcpc -i wlan0" by
+	/// default. Empty command means that address is obtained by someone else, connected() is emitted right away.
+	void setDhcpCommand(QString const &command);
+
 signals:
-	/// Emitted when scanning for available networks initiated by scan() is finished and results are available
-	/// and ready to be obtained by scanResults method.
+	/// Emitted when scanning for available networks initiated by scan() is finished.
 	void scanFinished();
 
+	/// Emitted when results of the last scan requested by requestScanResults() are read.
+	void scanResultsReady(QList<trikWiFi::ScanResult> const &results);
+
+	/// Emitted when a network appears in the table of known networks or its SSID or frequency changes. Signal levels
+	/// are updated silently.
+	void bssAdded(trikWiFi::ScanResult const &result);
+
+	/// Emitted when a network disappears from the table of known networks.
+	void bssRemoved(trikWiFi::ScanResult const &result);
+
 	/// Emitted when wpa_supplicant connects to WiFi network. SSID of this network can be retrieved by status() method.
 	void connected();
 
 	/// Emitted when wpa_supplicant disconnects from current network.
 	void disconnected();
 
+	/// Emitted when signal level of current connection crosses a threshold set by "SIGNAL_MONITOR" command.
+	/// @param level - signal level in dBm.
+	void signalChanged(int level);
+
 private slots:
 	void receiveMessages();
+	void onReplied(int id, int result, QString const &reply);
+	void onScanResults(QList<trikWiFi::ScanResult> const &results);
 
 private:
 	QScopedPointer<WpaSupplicantCommunicator> mControlInterface;
 	QScopedPointer<WpaSupplicantCommunicator> mMonitorInterface;
 	QScopedPointer<QSocketNotifier> mMonitorFileSocketNotifier;
 
-	static QHash<QString, QString> parseReply(QString const &reply);
+	/// Processes asynchronous requests with its own control socket, lives in mWorkerThread.
+	QScopedPointer<WpaRequestWorker> mRequestWorker;
+	QThread mWorkerThread;
+
+	/// Callbacks of asynchronous requests that are not replied yet, by request id.
+	QHash<int, std::function<void(int, QString const &)>> mCallbacks;
+	int mNextRequestId;
+
+	/// Known networks by BSSID.
+	QHash<QString, ScanResult> mBssTable;
+
+	/// BSSIDs of networks that are reported as added by wpa_supplicant, but whose descriptions are not received yet.
+	QSet<QString> mPendingBss;
+
+	/// Shell command that obtains IP address after connection.
+	QString mDhcpCommand;
 
 	void processMessage(QString const &message);
+	void addBss(QString const &id, QString const &bssid);
+	void removeBss(QString const &bssid);
+	void updateBss(ScanResult const &result);
 };
 
 }
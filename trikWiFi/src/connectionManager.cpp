@@ -0,0 +1,187 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "connectionManager.h"
+
+#include <trikKernel/metricsRegistry.h>
+
+#include "wpaRequestWorker.h"
+
+using namespace trikWiFi;
+
+/// Signal level in dBm below which link is considered weak and other access points are looked for.
+static int const weakLinkLevel = -70;
+
+/// Hysteresis of signal monitor in dB, so small fluctuations around threshold do not produce events.
+static int const weakLinkHysteresis = 4;
+
+/// How much stronger in dB another access point shall be to roam to it.
+static int const roamMargin = 8;
+
+/// Interval in milliseconds between reassociation attempts while link is down.
+static int const reconnectInterval = 3000;
+
+ConnectionManager::ConnectionManager(TrikWiFi &wiFi, QObject *parent)
+	: QObject(parent)
+	, mWiFi(wiFi)
+	, mNetworkId(-1)
+	, mLevel(0)
+	, mWeakLink(false)
+	, mReconnectStart(-1)
+	, mLastReconnectLatency(-1)
+{
+	connect(&mWiFi, SIGNAL(connected()), this, SLOT(onConnected()));
+	connect(&mWiFi, SIGNAL(disconnected()), this, SLOT(onDisconnected()));
+	connect(&mWiFi, SIGNAL(signalChanged(int)), this, SLOT(onSignalChanged(int)));
+	connect(&mWiFi, SIGNAL(scanResultsReady(QList<trikWiFi::ScanResult>))
+			, this, SLOT(onScanResults(QList<trikWiFi::ScanResult>)));
+
+	mReconnectTimer.setInterval(reconnectInterval);
+	connect(&mReconnectTimer, SIGNAL(timeout()), this, SLOT(onReconnectTimeout()));
+}
+
+ConnectionManager::~ConnectionManager()
+{
+}
+
+void ConnectionManager::connectTo(int id)
+{
+	mNetworkId = id;
+	mReconnectStart = -1;
+	startReconnect();
+	mWiFi.requestAsync("SELECT_NETWORK " + QString::number(id), nullptr);
+}
+
+void ConnectionManager::release()
+{
+	mNetworkId = -1;
+	mReconnectStart = -1;
+	mReconnectTimer.stop();
+}
+
+int ConnectionManager::lastReconnectLatency() const
+{
+	return mLastReconnectLatency;
+}
+
+void ConnectionManager::onConnected()
+{
+	static trikKernel::Histogram &latency = trikKernel::MetricsRegistry::histogram("wifi.reconnectLatencyUs");
+
+	if (mNetworkId < 0) {
+		return;
+	}
+
+	mReconnectTimer.stop();
+	mWeakLink = false;
+
+	if (mReconnectStart >= 0) {
+		qint64 const elapsed = trikKernel::MetricsRegistry::now() - mReconnectStart;
+		mReconnectStart = -1;
+		latency.record(elapsed);
+		mLastReconnectLatency = elapsed / 1000;
+		emit reconnected(mLastReconnectLatency);
+	}
+
+	mWiFi.requestAsync(QString("SIGNAL_MONITOR THRESHOLD=%1 HYSTERESIS=%2")
+			.arg(weakLinkLevel).arg(weakLinkHysteresis), nullptr);
+
+	mWiFi.requestAsync("STATUS", [this](int result, QString const &reply) {
+		if (result < 0) {
+			return;
+		}
+
+		QHash<QString, QString> const status = WpaRequestWorker::parseReply(reply);
+		mSsid = status["ssid"];
+		mBssid = status["bssid"];
+	});
+}
+
+void ConnectionManager::onDisconnected()
+{
+	static trikKernel::Counter &linkLosses = trikKernel::MetricsRegistry::counter("wifi.linkLosses");
+
+	if (mNetworkId < 0) {
+		return;
+	}
+
+	linkLosses.increment();
+	startReconnect();
+
+	// wpa_supplicant retries by itself, but with growing delays, so reassociation is requested right away.
+	mWiFi.requestAsync("REASSOCIATE", nullptr);
+	mReconnectTimer.start();
+}
+
+void ConnectionManager::onSignalChanged(int level)
+{
+	static trikKernel::Gauge &signalLevel = trikKernel::MetricsRegistry::gauge("wifi.signal");
+
+	signalLevel.set(level);
+	mLevel = level;
+
+	bool const weakLink = level < weakLinkLevel;
+	if (mNetworkId >= 0 && weakLink && !mWeakLink) {
+		// Results come with scanResultsReady signal when the scan is done.
+		mWiFi.requestAsync("SCAN", nullptr);
+	}
+
+	mWeakLink = weakLink;
+}
+
+void ConnectionManager::onScanResults(QList<ScanResult> const &results)
+{
+	if (mNetworkId >= 0 && mWeakLink && mReconnectStart < 0) {
+		roam(results);
+	}
+}
+
+void ConnectionManager::onReconnectTimeout()
+{
+	mWiFi.requestAsync("REASSOCIATE", nullptr);
+}
+
+void ConnectionManager::startReconnect()
+{
+	if (mReconnectStart < 0) {
+		mReconnectStart = trikKernel::MetricsRegistry::now();
+	}
+}
+
+void ConnectionManager::roam(QList<ScanResult> const &results)
+{
+	static trikKernel::Counter &roams = trikKernel::MetricsRegistry::counter("wifi.roams");
+
+	QString bestBssid;
+	int bestLevel = mLevel + roamMargin - 1;
+	foreach (ScanResult const &result, results) {
+		if (result.ssid == mSsid && result.bssid != mBssid && result.level > bestLevel) {
+			bestBssid = result.bssid;
+			bestLevel = result.level;
+		}
+	}
+
+	if (bestBssid.isEmpty()) {
+		return;
+	}
+
+	roams.increment();
+	startReconnect();
+	mWiFi.requestAsync("ROAM " + bestBssid, [this](int result, QString const &reply) {
+		// Connection to current access point is still up if roaming failed.
+		if (result < 0 || reply != "OK\n") {
+			mReconnectStart = -1;
+		}
+	});
+}
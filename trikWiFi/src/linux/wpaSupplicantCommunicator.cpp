@@ -15,6 +15,7 @@
 #include "src/wpaSupplicantCommunicator.h"
 
 #include <iostream>
+#include <string>
 #include <cstdio>
 #include <cstring>
 #include <cerrno>
@@ -133,8 +134,8 @@ int WpaSupplicantCommunicator::request(QString const &command, QString &reply)
 		return -1;
 	}
 
-	char const *commandAscii = command.toStdString().c_str();
-	if (send(mSocket, commandAscii, strlen(commandAscii) + 1, 0) < 0) {
+	std::string const commandAscii = command.toStdString();
+	if (send(mSocket, commandAscii.c_str(), commandAscii.size() + 1, 0) < 0) {
 		std::cerr << "Cannot send a message to the daemon:" << std::endl;
 		std::cerr << strerror(errno) << std::endl;
 		return -1;
@@ -151,14 +152,15 @@ int WpaSupplicantCommunicator::request(QString const &command, QString &reply)
 		tv.tv_usec = 0;
 		select(mSocket + 1, &rfds, NULL, NULL, &tv);
 		if (FD_ISSET(mSocket, &rfds)) {
-			int const bufferSize = 2048;
-			char buffer[bufferSize];
+			// wpa_supplicant replies are at most 4096 bytes long, range requests for scan results fill it entirely.
+			int const bufferSize = 4096;
+			char buffer[bufferSize + 1];
 			int const replyLen = recv(mSocket, buffer, bufferSize, 0);
 			if (replyLen < 0) {
 				std::cerr << "Cannot receive a reply from the daemon:" << std::endl;
 				std::cerr << strerror(errno) << std::endl;
 				return -1;
-			} else if (buffer[0] == '<') { //unsolicited message
+			} else if (replyLen > 0 && buffer[0] == '<') { //unsolicited message
 				continue;
 			} else {
 				buffer[replyLen] = '\0';
@@ -188,7 +190,7 @@ bool WpaSupplicantCommunicator::isPending()
 int WpaSupplicantCommunicator::receive(QString &message)
 {
 	int const bufferSize = 256;
-	char buffer[bufferSize];
+	char buffer[bufferSize + 1];
 	int const messageLen = recv(mSocket, buffer, bufferSize, 0);
 	if (messageLen < 0) {
 		std::cerr << "Cannot receive a message from the daemon:" << std::endl;
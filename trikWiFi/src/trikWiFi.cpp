@@ -19,6 +19,9 @@
 #include <QtCore/QDebug>
 
 #include "wpaSupplicantCommunicator.h"
+#include "wpaRequestWorker.h"
+
+Q_DECLARE_METATYPE(QList<trikWiFi::ScanResult>)
 
 using namespace trikWiFi;
 
@@ -28,7 +31,21 @@ TrikWiFi::TrikWiFi(QString const &interfaceFilePrefix
 	: QObject(parent)
 	, mControlInterface(new WpaSupplicantCommunicator(interfaceFilePrefix + "ctrl", daemonFile))
 	, mMonitorInterface(new WpaSupplicantCommunicator(interfaceFilePrefix + "mon", daemonFile))
+	, mRequestWorker(new WpaRequestWorker(interfaceFilePrefix + "req", daemonFile))
+	, mNextRequestId(0)
+	, mDhcpCommand("udhcpc -i wlan0")
 {
+	qRegisterMetaType<QList<trikWiFi::ScanResult>>("QList<trikWiFi::ScanResult>");
+
+	QObject::connect(mRequestWorker.data(), SIGNAL(replied(int,int,QString)), this, SLOT(onReplied(int,int,QString)));
+	QObject::connect(mRequestWorker.data(), SIGNAL(scanResultsReady(QList<trikWiFi::ScanResult>))
+			, this, SLOT(onScanResults(QList<trikWiFi::ScanResult>)));
+
+	mRequestWorker->moveToThread(&mWorkerThread);
+	mWorkerThread.start();
+
+	requestScanResults();
+
 	mMonitorInterface->attach();
 	int const monitorFileDesc = mMonitorInterface->fileDescriptor();
 	if (monitorFileDesc >= 0) {
@@ -41,18 +58,16 @@ TrikWiFi::TrikWiFi(QString const &interfaceFilePrefix
 
 TrikWiFi::~TrikWiFi()
 {
+	mWorkerThread.quit();
+	mWorkerThread.wait();
+
 	mMonitorInterface->detach();
 }
 
 int TrikWiFi::connect(int id)
 {
 	QString reply;
-	int result = mControlInterface->request("DISCONNECT", reply);
-	if (result < 0 || reply != "OK\n") {
-		return -1;
-	}
-
-	result = mControlInterface->request("SELECT_NETWORK " + QString::number(id), reply);
+	int const result = mControlInterface->request("SELECT_NETWORK " + QString::number(id), reply);
 	if (result < 0 || reply != "OK\n") {
 		return -1;
 	}
@@ -94,7 +109,7 @@ Status TrikWiFi::status() const
 		return result;
 	}
 
-	QHash<QString, QString> parsedReply = parseReply(reply);
+	QHash<QString, QString> parsedReply = WpaRequestWorker::parseReply(reply);
 
 	result.connected = parsedReply.contains("ssid") && !parsedReply["ssid"].isEmpty();
 	if (result.connected) {
@@ -105,35 +120,25 @@ Status TrikWiFi::status() const
 	return result;
 }
 
-QList<ScanResult> TrikWiFi::scanResults()
+QList<ScanResult> TrikWiFi::scanResults() const
 {
-	int index = 0;
-	QList<ScanResult> results;
-
-	forever {
-		QString const command = "BSS " + QString::number(index++);
-		QString reply;
-
-		if (mControlInterface->request(command, reply) < 0) {
-			break;
-		}
-
-		QHash<QString, QString> parsedReply = parseReply(reply);
-
-		if (parsedReply.isEmpty()) {
-			break;
-		}
-
-		ScanResult currentResult;
+	return mBssTable.values();
+}
 
-		// TODO: Add error processing.
-		currentResult.frequency = parsedReply["freq"].toInt();
-		currentResult.ssid = parsedReply["ssid"];
+void TrikWiFi::requestScanResults()
+{
+	QMetaObject::invokeMethod(mRequestWorker.data(), "fetchScanResults", Qt::QueuedConnection);
+}
 
-		results.append(currentResult);
+void TrikWiFi::requestAsync(QString const &command, std::function<void(int, QString const &)> const &callback)
+{
+	int const id = mNextRequestId++;
+	if (callback) {
+		mCallbacks.insert(id, callback);
 	}
 
-	return results;
+	QMetaObject::invokeMethod(mRequestWorker.data(), "request", Qt::QueuedConnection
+			, Q_ARG(int, id), Q_ARG(QString, command));
 }
 
 int TrikWiFi::addNetwork()
@@ -241,50 +246,111 @@ QList<NetworkConfiguration> TrikWiFi::listNetworks()
 	return list;
 }
 
+void TrikWiFi::setDhcpCommand(QString const &command)
+{
+	mDhcpCommand = command;
+}
+
 void TrikWiFi::processMessage(QString const &message)
 {
-	if (message.contains("CTRL-EVENT-SCAN-RESULTS")) {
+	if (message.contains("CTRL-EVENT-BSS-ADDED") || message.contains("CTRL-EVENT-BSS-REMOVED")) {
+		// Event looks like "<3>CTRL-EVENT-BSS-ADDED 5 01:23:45:67:89:ab".
+		QStringList const parts = message.simplified().split(' ');
+		if (parts.size() < 3) {
+			return;
+		}
+
+		if (parts[0].endsWith("CTRL-EVENT-BSS-ADDED")) {
+			addBss(parts[1], parts[2]);
+		} else {
+			removeBss(parts[2]);
+		}
+	} else if (message.contains("CTRL-EVENT-SCAN-RESULTS")) {
+		// BSS events may be lost if monitor socket overflows, so the table is synchronized after each scan.
+		requestScanResults();
 		emit scanFinished();
 	} else if (message.contains("CTRL-EVENT-CONNECTED")) {
-		int result = system("udhcpc -i wlan0");
+		int const result = mDhcpCommand.isEmpty() ? 0 : system(mDhcpCommand.toLocal8Bit().constData());
 		if (result == 0) {
 			emit connected();
 		}
 	} else if (message.contains("CTRL-EVENT-DISCONNECTED")) {
 		emit disconnected();
+	} else if (message.contains("CTRL-EVENT-SIGNAL-CHANGE")) {
+		// Event looks like "<3>CTRL-EVENT-SIGNAL-CHANGE above=0 signal=-75 noise=-95 txrate=65000".
+		foreach (QString const &field, message.simplified().split(' ')) {
+			if (field.startsWith("signal=")) {
+				emit signalChanged(field.mid(QString("signal=").length()).toInt());
+			}
+		}
 	}
 }
 
-void TrikWiFi::receiveMessages()
+void TrikWiFi::onReplied(int id, int result, QString const &reply)
 {
-	while (mMonitorInterface->isPending()) {
-		QString message;
-		mMonitorInterface->receive(message);
-		processMessage(message);
+	std::function<void(int, QString const &)> const callback = mCallbacks.take(id);
+	if (callback) {
+		callback(result, reply);
 	}
 }
 
-QHash<QString, QString> TrikWiFi::parseReply(QString const &reply)
+void TrikWiFi::onScanResults(QList<ScanResult> const &results)
 {
-	QHash<QString, QString> result;
+	QSet<QString> obsolete = QSet<QString>::fromList(mBssTable.keys());
+	foreach (ScanResult const &result, results) {
+		obsolete.remove(result.bssid);
+		mPendingBss.remove(result.bssid);
+		updateBss(result);
+	}
 
-	if (reply.isEmpty() || reply.startsWith("FAIL")) {
-		return result;
+	foreach (QString const &bssid, obsolete) {
+		removeBss(bssid);
 	}
 
-	QStringList const lines = reply.split('\n');
+	emit scanResultsReady(results);
+}
 
-	foreach (QString const &line, lines) {
-		int const valuePos = line.indexOf('=') + 1;
-		if (valuePos < 1) {
-			continue;
+void TrikWiFi::addBss(QString const &id, QString const &bssid)
+{
+	mPendingBss.insert(bssid);
+	requestAsync(WpaRequestWorker::bssCommand("ID-" + id), [this, bssid](int result, QString const &reply) {
+		// Network may have been removed while its description was requested.
+		if (!mPendingBss.remove(bssid) || result < 0) {
+			return;
 		}
 
-		QString const key = line.left(valuePos - 1);
-		QString const value = line.mid(valuePos);
+		QHash<QString, QString> const parsedReply = WpaRequestWorker::parseReply(reply);
+		if (!parsedReply.isEmpty()) {
+			updateBss(WpaRequestWorker::toScanResult(parsedReply));
+		}
+	});
+}
+
+void TrikWiFi::removeBss(QString const &bssid)
+{
+	mPendingBss.remove(bssid);
+	if (mBssTable.contains(bssid)) {
+		emit bssRemoved(mBssTable.take(bssid));
+	}
+}
 
-		result.insert(key, value);
+void TrikWiFi::updateBss(ScanResult const &result)
+{
+	auto const known = mBssTable.constFind(result.bssid);
+	bool const changed = known == mBssTable.constEnd() || known->ssid != result.ssid
+			|| known->frequency != result.frequency;
+
+	mBssTable.insert(result.bssid, result);
+	if (changed) {
+		emit bssAdded(result);
 	}
+}
 
-	return result;
+void TrikWiFi::receiveMessages()
+{
+	while (mMonitorInterface->isPending()) {
+		QString message;
+		mMonitorInterface->receive(message);
+		processMessage(message);
+	}
 }
@@ -0,0 +1,146 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "wpaRequestWorker.h"
+
+#include <QtCore/QStringList>
+
+#include "wpaSupplicantCommunicator.h"
+
+using namespace trikWiFi;
+
+/// Fields of BSS entries requested from wpa_supplicant: id (0x1), BSSID (0x2), frequency (0x4), level (0x80),
+/// SSID (0x1000) and delimiter between entries (0x20000).
+static QString const bssMask = "MASK=0x21087";
+
+/// Delimiter that wpa_supplicant puts after each BSS entry except the last one in its table.
+static QString const bssDelimiter = "====\n";
+
+WpaRequestWorker::WpaRequestWorker(QString const &interfaceFile, QString const &daemonFile)
+	: mCommunicator(new WpaSupplicantCommunicator(interfaceFile, daemonFile))
+{
+	mCommunicator->setParent(this);
+}
+
+WpaRequestWorker::~WpaRequestWorker()
+{
+}
+
+void WpaRequestWorker::request(int id, QString const &command)
+{
+	QString reply;
+	int const result = mCommunicator->request(command, reply);
+	emit replied(id, result, reply);
+}
+
+void WpaRequestWorker::fetchScanResults()
+{
+	emit scanResultsReady(scanResults(*mCommunicator));
+}
+
+QList<ScanResult> WpaRequestWorker::scanResults(WpaSupplicantCommunicator &communicator)
+{
+	QList<ScanResult> results;
+	QString range = "ALL";
+
+	forever {
+		QString reply;
+		if (communicator.request(bssCommand("RANGE=" + range), reply) < 0) {
+			return results;
+		}
+
+		if (reply.startsWith("FAIL") || reply.startsWith("UNKNOWN COMMAND")) {
+			// Old wpa_supplicant without range requests, reading entries one by one.
+			break;
+		}
+
+		int lastId = -1;
+		foreach (QString const &entry, reply.split(bssDelimiter, QString::SkipEmptyParts)) {
+			QHash<QString, QString> const parsedEntry = parseReply(entry);
+			if (parsedEntry.isEmpty()) {
+				continue;
+			}
+
+			lastId = parsedEntry.value("id", "-1").toInt();
+			results.append(toScanResult(parsedEntry));
+		}
+
+		// Trailing delimiter means that the reply did not fit into wpa_supplicant buffer and there are more entries
+		// after the last one we got.
+		if (lastId < 0 || !reply.endsWith(bssDelimiter)) {
+			return results;
+		}
+
+		range = QString::number(lastId + 1) + "-";
+	}
+
+	for (int index = results.size(); ; ++index) {
+		QString reply;
+		if (communicator.request("BSS " + QString::number(index), reply) < 0) {
+			break;
+		}
+
+		QHash<QString, QString> const parsedReply = parseReply(reply);
+		if (parsedReply.isEmpty()) {
+			break;
+		}
+
+		results.append(toScanResult(parsedReply));
+	}
+
+	return results;
+}
+
+QString WpaRequestWorker::bssCommand(QString const &selector)
+{
+	return "BSS " + selector + " " + bssMask;
+}
+
+QHash<QString, QString> WpaRequestWorker::parseReply(QString const &reply)
+{
+	QHash<QString, QString> result;
+
+	if (reply.isEmpty() || reply.startsWith("FAIL")) {
+		return result;
+	}
+
+	QStringList const lines = reply.split('\n');
+
+	foreach (QString const &line, lines) {
+		int const valuePos = line.indexOf('=') + 1;
+		if (valuePos < 1) {
+			continue;
+		}
+
+		QString const key = line.left(valuePos - 1);
+		QString const value = line.mid(valuePos);
+
+		result.insert(key, value);
+	}
+
+	return result;
+}
+
+ScanResult WpaRequestWorker::toScanResult(QHash<QString, QString> const &parsedReply)
+{
+	ScanResult result;
+
+	// TODO: Add error processing.
+	result.bssid = parsedReply["bssid"];
+	result.frequency = parsedReply["freq"].toInt();
+	result.level = parsedReply["level"].toInt();
+	result.ssid = parsedReply["ssid"];
+
+	return result;
+}
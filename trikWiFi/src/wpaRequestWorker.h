@@ -0,0 +1,79 @@
+/* Copyright 2014 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QList>
+#include <QtCore/QHash>
+#include <QtCore/QScopedPointer>
+
+#include "trikWiFi.h"
+
+namespace trikWiFi {
+
+class WpaSupplicantCommunicator;
+
+/// Sends requests to wpa_supplicant through its own control socket, intended to work in separate thread. Requests are
+/// queued as slot invocations and are processed one by one in order of submission, so a long series of requests
+/// (like fetching scan results) does not block a thread that issued them.
+class WpaRequestWorker : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// Constructor.
+	/// @param interfaceFile - file that is used by this worker to communicate with wpa_supplicant.
+	/// @param daemonFile - file that wpa_supplicant uses to communicate with clients.
+	WpaRequestWorker(QString const &interfaceFile, QString const &daemonFile);
+
+	~WpaRequestWorker() override;
+
+	/// Reads whole BSS table of wpa_supplicant using given communicator. Entries are requested in batches with
+	/// "BSS RANGE=" command, falling back to one "BSS <n>" request per entry if wpa_supplicant does not support it.
+	static QList<ScanResult> scanResults(WpaSupplicantCommunicator &communicator);
+
+	/// Parses key=value reply of wpa_supplicant into a hash.
+	static QHash<QString, QString> parseReply(QString const &reply);
+
+	/// Returns "BSS" command that requests fields of BSS entries needed for ScanResult.
+	/// @param selector - entry or range of entries, like "ID-5" or "RANGE=ALL".
+	static QString bssCommand(QString const &selector);
+
+	/// Converts parsed reply to "BSS" command into a scan result.
+	static ScanResult toScanResult(QHash<QString, QString> const &parsedReply);
+
+public slots:
+	/// Sends given command to wpa_supplicant and emits replied() with given request id when reply is received.
+	void request(int id, QString const &command);
+
+	/// Reads scan results from wpa_supplicant and emits scanResultsReady() with all of them.
+	void fetchScanResults();
+
+signals:
+	/// Emitted when reply for a request with given id is received or request failed.
+	/// @param id - id of a request passed to request() slot.
+	/// @param result - 0 if request succeeded, -1 otherwise.
+	/// @param reply - reply from wpa_supplicant.
+	void replied(int id, int result, QString const &reply);
+
+	/// Emitted when all scan results are read from wpa_supplicant.
+	void scanResultsReady(QList<trikWiFi::ScanResult> const &results);
+
+private:
+	QScopedPointer<WpaSupplicantCommunicator> mCommunicator;
+};
+
+}
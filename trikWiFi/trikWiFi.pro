@@ -20,6 +20,8 @@ QT += xml
 
 DEFINES += TRIKWIFI_LIBRARY
 
+uses(trikKernel)
+
 win32 {
 	PLATFORM = windows
 } else {
@@ -29,10 +31,14 @@ win32 {
 HEADERS += \
 	$$PWD/include/trikWiFi/trikWiFi.h \
 	$$PWD/include/trikWiFi/wpaConfigurer.h \
+	$$PWD/include/trikWiFi/connectionManager.h \
 	$$PWD/include/trikWiFi/declSpec.h \
 	$$PWD/src/wpaSupplicantCommunicator.h \
+	$$PWD/src/wpaRequestWorker.h \
 
 SOURCES += \
 	$$PWD/src/trikWiFi.cpp \
 	$$PWD/src/wpaConfigurer.cpp \
+	$$PWD/src/connectionManager.cpp \
+	$$PWD/src/wpaRequestWorker.cpp \
 	$$PWD/src/$$PLATFORM/wpaSupplicantCommunicator.cpp \